@@ -23,6 +23,7 @@
 #include <learnopengl/shader.h>
 #include <learnopengl/filesystem.h>
 #include <learnopengl/Camera.h>
+#include <learnopengl/animation.h>
 
 // 函数原型
 // 7.1
@@ -177,6 +178,14 @@ int main() {
 	glEnableVertexAttribArray(0);
 	glBindVertexArray(0);
 
+	// 灯光颜色随时间变化：三个分量各由一个正弦通道驱动
+	glm::vec3 lightColor;
+	Animator animator;
+	GLuint lightColorProperty = animator.AddProperty(lightColor);
+	animator.AddProcedural(lightColorProperty, 0, WAVE_SINE, 1.0f, 2.0f);
+	animator.AddProcedural(lightColorProperty, 1, WAVE_SINE, 1.0f, 0.7f);
+	animator.AddProcedural(lightColorProperty, 2, WAVE_SINE, 1.0f, 1.3f);
+
 	// 7.0主循环
 	while (!glfwWindowShouldClose(window))
 	{
@@ -184,6 +193,8 @@ int main() {
 		GLfloat currentFrame = glfwGetTime();
 		deltaTime = currentFrame - lastFrame;
 		lastFrame = currentFrame;
+		// 计算本帧的动画值
+		animator.Update(currentFrame);
 
 		// 7.1检测事件
 		glfwPollEvents();
@@ -205,16 +216,15 @@ int main() {
 		glUniform3f(lightPosLoc,    lightPos.x, lightPos.y, lightPos.z);
         glUniform3f(viewPosLoc,     camera.Position.x, camera.Position.y, camera.Position.z);
 
-		// 设置灯光属性
-		glm::vec3 lightColor;
-        lightColor.x = sin(glfwGetTime() * 2.0f);
-        lightColor.y = sin(glfwGetTime() * 0.7f);
-        lightColor.z = sin(glfwGetTime() * 1.3f);
-        glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // Decrease the influence
-        glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // Low influence
-		// 读取并直接赋值
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "light.ambient"),  ambientColor.x, ambientColor.y, ambientColor.z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "light.diffuse"),  diffuseColor.x, diffuseColor.y, diffuseColor.z);
+		// 设置灯光属性（uniform 保存在着色器程序中，颜色改变了才重新上传）
+		if (animator.Dirty(lightColorProperty))
+		{
+			glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // Decrease the influence
+			glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // Low influence
+			// 读取并直接赋值
+			glUniform3f(glGetUniformLocation(lightingShader.Program, "light.ambient"),  ambientColor.x, ambientColor.y, ambientColor.z);
+			glUniform3f(glGetUniformLocation(lightingShader.Program, "light.diffuse"),  diffuseColor.x, diffuseColor.y, diffuseColor.z);
+		}
         glUniform3f(glGetUniformLocation(lightingShader.Program, "light.specular"), 1.0f, 1.0f, 1.0f);
 		// 设置材质属性
         glUniform3f(glGetUniformLocation(lightingShader.Program, "material.ambient"),   1.0f, 0.5f, 0.31f);
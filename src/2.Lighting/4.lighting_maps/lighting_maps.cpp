@@ -21,6 +21,7 @@
 
 // Other includes
 #include <learnopengl/shader.h>
+#include <learnopengl/shader_permutation.h>
 #include <learnopengl/filesystem.h>
 #include <learnopengl/Camera.h>
 
@@ -90,7 +91,10 @@ int main() {
 	// 5.0构建和编译着色器（外部文件链接）
 	// 参数为文件路径: vertexPath, fragmentPath, geometryPath
 	// shader.h的Shader类的构造函数
-	Shader lightingShader("lighting_maps.vs", "lighting_maps.frag"); 
+	// 光照着色器使用多光源案例的变体源码，只打开1个点光源和镜面贴图
+	ShaderPermutation lightingShaders("../6.Multiple_lights/multiple_lights.vs", "../6.Multiple_lights/multiple_lights.frag");
+	const GLuint lightingKey = PermutationKey(PERM_SPECULAR_MAP, 1);
+	GLuint lightingProgram = lightingShaders.Get(lightingKey);
 	Shader lampShader("lamp.vs", "lamp.frag");
 
 	// *本例没有使用color顶点属性及EBO
@@ -230,9 +234,9 @@ int main() {
     
 	// ~获取Uniform对象，向着色器传递贴图~
 	// 激活对象照明着色器，灯光为lampShader
-	lightingShader.Use();
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.diffuse"),  0);
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.specular"), 1);
+	lightingShaders.Use(lightingKey);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.diffuse"),  0);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.specular"), 1);
 
 
 	// 7.0主循环
@@ -254,21 +258,25 @@ int main() {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // 清除深度缓冲区
 
 		// 激活对象照明着色器，灯光为lampShader
-		lightingShader.Use();
+		lightingShaders.Use(lightingKey);
 
 		// 获取灯光、视角位置地址
-		GLint lightPosLoc    = glGetUniformLocation(lightingShader.Program, "light.position");
-        	GLint viewPosLoc     = glGetUniformLocation(lightingShader.Program, "viewPos");
+		GLint lightPosLoc    = glGetUniformLocation(lightingProgram, "pointLights[0].position");
+        	GLint viewPosLoc     = glGetUniformLocation(lightingProgram, "viewPos");
 		// 设置获取灯光、视角位置
 		glUniform3f(lightPosLoc,    lightPos.x, lightPos.y, lightPos.z);
         	glUniform3f(viewPosLoc,     camera.Position.x, camera.Position.y, camera.Position.z);
         
 		// 设置光照属性
-		glUniform3f(glGetUniformLocation(lightingShader.Program, "light.ambient"),  0.2f, 0.2f, 0.2f);
-        	glUniform3f(glGetUniformLocation(lightingShader.Program, "light.diffuse"),  0.5f, 0.5f, 0.5f);
-        	glUniform3f(glGetUniformLocation(lightingShader.Program, "light.specular"), 1.0f, 1.0f, 1.0f);
+		glUniform3f(glGetUniformLocation(lightingProgram, "pointLights[0].ambient"),  0.2f, 0.2f, 0.2f);
+        	glUniform3f(glGetUniformLocation(lightingProgram, "pointLights[0].diffuse"),  0.5f, 0.5f, 0.5f);
+        	glUniform3f(glGetUniformLocation(lightingProgram, "pointLights[0].specular"), 1.0f, 1.0f, 1.0f);
+		// 本例的灯光不衰减（常数为1，其余为0）
+		glUniform1f(glGetUniformLocation(lightingProgram, "pointLights[0].constant"),  1.0f);
+		glUniform1f(glGetUniformLocation(lightingProgram, "pointLights[0].linear"),    0.0f);
+		glUniform1f(glGetUniformLocation(lightingProgram, "pointLights[0].quadratic"), 0.0f);
         	// 设置材质属性
-        	glUniform1f(glGetUniformLocation(lightingShader.Program, "material.shininess"), 32.0f);
+        	glUniform1f(glGetUniformLocation(lightingProgram, "material.shininess"), 32.0f);
 
 
 		// 7.5创建摄影机/视角变换
@@ -281,9 +289,9 @@ int main() {
 		projection = glm::perspective(45.0f, (GLfloat)WIDTH / (GLfloat)HEIGHT, 0.1f, 100.0f);
 
 		// 获取各个矩阵在着色器的uniform的地址
-		GLint modelLoc = glGetUniformLocation(lightingShader.Program, "model");
-		GLint viewLoc  = glGetUniformLocation(lightingShader.Program, "view");
-		GLint projLoc  = glGetUniformLocation(lightingShader.Program, "projection");
+		GLint modelLoc = glGetUniformLocation(lightingProgram, "model");
+		GLint viewLoc  = glGetUniformLocation(lightingProgram, "view");
+		GLint projLoc  = glGetUniformLocation(lightingProgram, "projection");
 
 		// 把矩阵传递给着色器 
 		// 参数1：uniform的地址(Location)
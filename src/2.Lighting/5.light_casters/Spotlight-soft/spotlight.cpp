@@ -1,6 +1,7 @@
 // 流处理
 #include <iostream> 
 #include <cmath>
+#include <vector>
 
 // GLEW
 // GLEW 能自动识别你的平台所支持的全部OpenGL高级扩展涵数
@@ -21,8 +22,10 @@
 
 // Other includes
 #include <learnopengl/shader.h>
+#include <learnopengl/shader_permutation.h>
 #include <learnopengl/filesystem.h>
 #include <learnopengl/Camera.h>
+#include <learnopengl/animation.h>
 
 // 函数原型
 // 7.1
@@ -90,7 +93,10 @@ int main() {
 	// 5.0构建和编译着色器（外部文件链接）
 	// 参数为文件路径: vertexPath, fragmentPath, geometryPath
 	// shader.h的Shader类的构造函数
-	Shader lightingShader("light_casters.vs", "light_casters.frag"); 
+	// 光照着色器使用多光源案例的变体源码，只打开聚光灯和镜面贴图
+	ShaderPermutation lightingShaders("../../6.Multiple_lights/multiple_lights.vs", "../../6.Multiple_lights/multiple_lights.frag");
+	const GLuint lightingKey = PermutationKey(PERM_SPOT_LIGHT | PERM_SPECULAR_MAP, 0);
+	GLuint lightingProgram = lightingShaders.Get(lightingKey);
 	Shader lampShader("lamp.vs", "lamp.frag");
 
 	// *本例没有使用color顶点属性及EBO
@@ -154,6 +160,20 @@ int main() {
         glm::vec3(-1.3f,  1.0f, -1.5f)
     };
 
+	// 箱子的旋转角由动画驱动：
+	// 每个箱子一条只有一帧的关键帧通道，角度固定为 20*i 度（与原来的静止摆放一致），
+	// 只有角度改变了的箱子才重新计算模型矩阵（即只在第一帧计算）
+	GLfloat cubeAngles[10];
+	glm::mat4 cubeModels[10];
+	GLuint angleProperties[10];
+	Animator animator;
+	for (GLuint i = 0; i < 10; i++)
+	{
+		std::vector<Keyframe> keys = { { 0.0f, 20.0f * i } };
+		angleProperties[i] = animator.AddProperty(cubeAngles[i]);
+		animator.AddKeyframes(angleProperties[i], 0, keys);
+	}
+
 	// #1
 	// 顶点缓存对象，顶点数组对象
 	GLuint VBO, containerVAO;   
@@ -244,9 +264,9 @@ int main() {
     
 	// ~获取Uniform对象，向着色器传递贴图~
 	// 激活对象照明着色器，灯光为lampShader
-	lightingShader.Use();
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.diffuse"),  0);
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.specular"), 1);
+	lightingShaders.Use(lightingKey);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.diffuse"),  0);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.specular"), 1);
 
 
 	// 7.0主循环
@@ -256,6 +276,8 @@ int main() {
 		GLfloat currentFrame = glfwGetTime();
 		deltaTime = currentFrame - lastFrame;
 		lastFrame = currentFrame;
+		// 计算本帧的动画值
+		animator.Update(currentFrame);
 
 		// 7.1检测事件
 		glfwPollEvents();
@@ -268,17 +290,17 @@ int main() {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // 清除深度缓冲区
 
 		// 激活对象照明着色器，灯光为lampShader
-		lightingShader.Use();
+		lightingShaders.Use(lightingKey);
 
 		// 设置视角位置地址
-        GLint viewPosLoc = glGetUniformLocation(lightingShader.Program, "viewPos");
+        GLint viewPosLoc = glGetUniformLocation(lightingProgram, "viewPos");
 		glUniform3f(viewPosLoc,     camera.Position.x, camera.Position.y, camera.Position.z);
 
 		// 设置聚光灯属性（聚光灯朝向使用摄影机镜头朝向）
-		GLint lightPosLoc             = glGetUniformLocation(lightingShader.Program, "light.position");
-		GLint lightSpotDirPos         = glGetUniformLocation(lightingShader.Program, "light.direction");
-		GLint lightSpotCutOffLoc      = glGetUniformLocation(lightingShader.Program, "light.cutOff");
-		GLint lightSpotOuterCutOffLoc = glGetUniformLocation(lightingShader.Program, "light.outerCutOff");
+		GLint lightPosLoc             = glGetUniformLocation(lightingProgram, "spotLight.position");
+		GLint lightSpotDirPos         = glGetUniformLocation(lightingProgram, "spotLight.direction");
+		GLint lightSpotCutOffLoc      = glGetUniformLocation(lightingProgram, "spotLight.cutOff");
+		GLint lightSpotOuterCutOffLoc = glGetUniformLocation(lightingProgram, "spotLight.outerCutOff");
 		glUniform3f(lightPosLoc,             camera.Position.x, camera.Position.y, camera.Position.z);
 		glUniform3f(lightSpotDirPos,         camera.Front.x, camera.Front.y, camera.Front.z);
 		// 提前计算余弦值，是为了节约开销。
@@ -289,16 +311,16 @@ int main() {
 
         
 		// 设置光照属性
-		glUniform3f(glGetUniformLocation(lightingShader.Program, "light.ambient"),  0.1f, 0.1f, 0.1f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "light.diffuse"),  0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "light.specular"), 1.0f, 1.0f, 1.0f);
+		glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.ambient"),  0.1f, 0.1f, 0.1f);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.diffuse"),  0.8f, 0.8f, 0.8f);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.specular"), 1.0f, 1.0f, 1.0f);
 		// 灯光衰减属性
-		glUniform1f(glGetUniformLocation(lightingShader.Program, "light.constant"),  1.0f);
-		glUniform1f(glGetUniformLocation(lightingShader.Program, "light.linear"),    0.09f);
-		glUniform1f(glGetUniformLocation(lightingShader.Program, "light.quadratic"), 0.032f);
+		glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.constant"),  1.0f);
+		glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.linear"),    0.09f);
+		glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.quadratic"), 0.032f);
 
         // 设置材质属性
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "material.shininess"), 32.0f);
+        glUniform1f(glGetUniformLocation(lightingProgram, "material.shininess"), 32.0f);
 
 		// 7.5创建摄影机/视角变换
 		// 定义视角（观察者）矩阵
@@ -310,9 +332,9 @@ int main() {
 		projection = glm::perspective(45.0f, (GLfloat)WIDTH / (GLfloat)HEIGHT, 0.1f, 100.0f);
 
 		// 获取各个矩阵在着色器的uniform的地址
-		GLint modelLoc = glGetUniformLocation(lightingShader.Program, "model");
-		GLint viewLoc  = glGetUniformLocation(lightingShader.Program, "view");
-		GLint projLoc  = glGetUniformLocation(lightingShader.Program, "projection");
+		GLint modelLoc = glGetUniformLocation(lightingProgram, "model");
+		GLint viewLoc  = glGetUniformLocation(lightingProgram, "view");
+		GLint projLoc  = glGetUniformLocation(lightingProgram, "projection");
 
 		// 把矩阵传递给着色器 
 		// 参数1：uniform的地址(Location)
@@ -337,19 +359,23 @@ int main() {
 		glBindVertexArray(containerVAO); // 绑VAO
 		for (GLuint i = 0; i < 10; i++)
         {
-			model = glm::mat4(); // 清空模型矩阵
-			
-			// 平移
-			model = glm::translate(model, cubePositions[i]); // 引入早已定义好的空间位置
-			
-			// 旋转（欧拉角）
-			// 在3D空间中旋转需要一个角(angle)和一个旋转轴(Rotation Axis)。
-			GLfloat angle = 20.0f * i;                    // 角位移
-			glm::vec3 axis = glm::vec3(1.0f, 0.3f, 0.5f); // 旋转轴
-			model = glm::rotate(model, angle, axis);      // 将模型矩阵绕axis轴旋转angle度
-			
+			// 角度没变时沿用上一帧的矩阵
+			if (animator.Dirty(angleProperties[i]))
+			{
+				model = glm::mat4(); // 清空模型矩阵
+
+				// 平移
+				model = glm::translate(model, cubePositions[i]); // 引入早已定义好的空间位置
+
+				// 旋转（欧拉角）
+				// 在3D空间中旋转需要一个角(angle)和一个旋转轴(Rotation Axis)。
+				GLfloat angle = cubeAngles[i];                // 角位移，由动画驱动
+				glm::vec3 axis = glm::vec3(1.0f, 0.3f, 0.5f); // 旋转轴
+				cubeModels[i] = glm::rotate(model, angle, axis); // 将模型矩阵绕axis轴旋转angle度
+			}
+
 			// 将矩阵传入着色器
-			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(cubeModels[i]));
 			// ~绘制箱子~
 			glDrawArrays(GL_TRIANGLES, 0, 36); // 共36个顶点
 		}
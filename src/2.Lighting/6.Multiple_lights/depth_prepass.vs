@@ -0,0 +1,27 @@
+#version 330 core
+// 深度预渲染：只有位置（格式见 vertex_packing.h），gl_Position 的计算必须与照明着色器完全相同
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 0
+#endif
+
+layout (location = 0) in vec3 position;
+
+invariant gl_Position; // 两趟的深度逐位相同，第二趟才能用 GL_EQUAL
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+#if PACKED_VERTICES
+uniform vec3 positionMin;
+uniform vec3 positionScale;
+#endif
+
+void main()
+{
+#if PACKED_VERTICES
+	vec3 localPos = positionMin + position * positionScale;
+#else
+	vec3 localPos = position;
+#endif
+	gl_Position = projection * view * model * vec4(localPos, 1.0f);
+}
@@ -1,11 +1,14 @@
 // 流处理
 #include <iostream> 
 #include <cmath>
+#include <vector>
 
 // GLEW
 // GLEW 能自动识别你的平台所支持的全部OpenGL高级扩展涵数
 #define GLEW_STATIC 
 #include <GL/glew.h>
+// GL 命令录制（定义 GL_CAPTURE 时生效），必须紧接在 glew 之后
+#include <learnopengl/gl_capture.h>
 
 // GLFW
 // OpenGL 窗口管理、分辨率切换、键盘、鼠标以及游戏手柄、定时器输入、线程创建等等。
@@ -23,6 +26,13 @@
 #include <learnopengl/shader.h>
 #include <learnopengl/filesystem.h>
 #include <learnopengl/Camera.h>
+#include <learnopengl/shader_permutation.h>
+#include <learnopengl/light_assignment.h>
+#include <learnopengl/cascaded_shadow_map.h>
+#include <learnopengl/vertex_packing.h>
+#include <learnopengl/depth_prepass.h>
+#include <learnopengl/frame_invalidation.h>
+#include <learnopengl/scene_file.h>
 
 // 函数原型
 // 7.1
@@ -34,6 +44,8 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 // 输入处理函数
 void do_movement();
+// 窗口需要重绘时的回调函数
+void refresh_callback(GLFWwindow* window);
 
 // 窗口尺寸
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -43,6 +55,10 @@ Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
 GLfloat lastX = WIDTH  / 2.0;
 GLfloat lastY = HEIGHT / 2.0;
 bool keys[1024];
+// 深度预渲染开关（P键切换）
+bool depthPrepassEnabled = false;
+// 按需渲染：画面不变时不重画（O键切换为连续渲染）
+FrameInvalidator invalidator;
 
 // 灯光属性
 glm::vec3 lightPos(1.2f, 0.5f, 2.0f);
@@ -70,6 +86,7 @@ int main() {
 	glfwSetKeyCallback(window, key_callback);
 	glfwSetCursorPosCallback(window, mouse_callback);
 	glfwSetScrollCallback(window, scroll_callback);
+	glfwSetWindowRefreshCallback(window, refresh_callback);
 
 	// GLFW Options
 	// 不显示光标
@@ -90,8 +107,14 @@ int main() {
 	// 5.0构建和编译着色器（外部文件链接）
 	// 参数为文件路径: vertexPath, fragmentPath, geometryPath
 	// shader.h的Shader类的构造函数
-	Shader lightingShader("multiple_lights.vs", "multiple_lights.frag"); 
+	// 照明着色器使用变体系统：平行光(带阴影) + 按物体分配的点光源(最多4个) + 聚光灯 + 镜面贴图
+	const GLuint MAX_OBJECT_LIGHTS = 4;
+	ShaderPermutation lightingShaders("multiple_lights.vs", "multiple_lights.frag");
+	const GLuint lightingKey = PermutationKey(PERM_DIR_LIGHT | PERM_SPOT_LIGHT | PERM_SPECULAR_MAP | PERM_LIGHT_LIST | PERM_SHADOWS | PERM_PACKED_VERTICES, MAX_OBJECT_LIGHTS);
+	GLuint lightingProgram = lightingShaders.Get(lightingKey);
 	Shader lampShader("lamp.vs", "lamp.frag");
+	Shader shadowShader("shadow_depth.vs", "shadow_depth.frag"); // 阴影贴图只写深度
+	DepthPrepass depthPrepass("depth_prepass.vs", "depth_prepass.frag"); // 照明前先只写深度
 
 	// *本例没有使用color顶点属性及EBO
 	// 6.0设置顶点数据
@@ -140,26 +163,45 @@ int main() {
         -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
     };
 
-	// Positions all containers
-    glm::vec3 cubePositions[] = {
-        glm::vec3( 0.0f,  0.0f,  0.0f),
-        glm::vec3( 2.0f,  5.0f, -15.0f),
-        glm::vec3(-1.5f, -2.2f, -2.5f),
-        glm::vec3(-3.8f, -2.0f, -12.3f),
-        glm::vec3( 2.4f, -0.4f, -3.5f),
-        glm::vec3(-1.7f,  3.0f, -7.5f),
-        glm::vec3( 1.3f, -2.0f, -2.5f),
-        glm::vec3( 1.5f,  2.0f, -2.5f),
-        glm::vec3( 1.5f,  0.2f, -1.5f),
-        glm::vec3(-1.3f,  1.0f, -1.5f)
-    };
-	// Positions of the point lights
-    glm::vec3 pointLightPositions[] = {
-        glm::vec3( 0.7f,  0.2f,  2.0f),
-        glm::vec3( 2.3f, -3.3f, -4.0f),
-        glm::vec3(-4.0f,  2.0f, -12.0f),
-        glm::vec3( 0.0f,  0.0f, -3.0f)
-    };
+	// 箱子、材质和灯光在场景文件中（multiple_lights.scene.json，第一次运行时烘焙成 .scn）
+	// 模型矩阵、包围球和点光源范围都已在烘焙时算好
+	SceneFile scene;
+	if (!OpenScene("multiple_lights.scene.json", scene))
+		return -1;
+	const SceneObject* sceneObjects = scene.Objects();
+	// 本案例只会画内置的立方体：每个物体必须引用 cube 模型和一个材质，并且要有平行光
+	GLuint cubeModel = scene.FindModel("cube");
+	for (GLuint i = 0; i < scene.ObjectCount(); i++)
+	{
+		if (sceneObjects[i].model != cubeModel || scene.Models()[cubeModel].path != SCENE_NO_INDEX ||
+		    sceneObjects[i].material >= scene.MaterialCount())
+		{
+			std::cout << "ERROR::SCENE_FILE:: object " << i << " must use the built-in cube model and a material" << std::endl;
+			return -1;
+		}
+	}
+	if (!scene.HasDirLight())
+	{
+		std::cout << "ERROR::SCENE_FILE:: multiple_lights.scene.json has no dirLight" << std::endl;
+		return -1;
+	}
+	const SceneDirLight& dirLight = scene.DirLight();
+
+	// 每个物体只上传范围内贡献最大的 MAX_OBJECT_LIGHTS 个点光源
+	std::vector<PointLight> pointLights(scene.PointLights(), scene.PointLights() + scene.PointLightCount());
+	LightAssigner lightAssigner(MAX_OBJECT_LIGHTS);
+	lightAssigner.SetLights(pointLights);
+
+	// 箱子不会移动，模型矩阵直接来自场景文件（光照和阴影共用）
+	std::vector<glm::mat4> cubeModels;
+	for (GLuint i = 0; i < scene.ObjectCount(); i++)
+		cubeModels.push_back(sceneObjects[i].transform);
+
+	// 平行光的级联阴影：箱子都是静态投射物，
+	// 只有灯光方向变化或级联随摄像机移动出吸附网格时才重新渲染
+	glm::vec3 dirLightDirection = dirLight.direction;
+	CascadedShadowMap shadowMap(2048, 3);
+	shadowMap.SetLightDirection(dirLightDirection);
 
 	// #1
 	// 顶点缓存对象，顶点数组对象
@@ -173,23 +215,31 @@ int main() {
 	// #3 将顶点数据复制到缓冲的内存中
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
+	// 箱子使用压缩顶点（16字节/顶点，原格式为32字节），单独放在一个VBO中
+	std::vector<PackedVertex> packedVertices;
+	std::vector<Vertex> cubeVertices = VerticesFromInterleaved(vertices, 36);
+	PackedBounds cubeBounds = PackVertices(&cubeVertices[0], cubeVertices.size(), packedVertices);
+	GLuint packedVBO;
+	glGenBuffers(1, &packedVBO);
+
 	// 使用VAO要做的全部就是绑定VAO
 	glBindVertexArray(containerVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, packedVBO);
+	glBufferData(GL_ARRAY_BUFFER, packedVertices.size() * sizeof(PackedVertex), &packedVertices[0], GL_STATIC_DRAW);
 
-	// #4 解释顶点数据 （数据位置，数据位数，数据格式，？，步长，偏移量）
-	// 位置属性
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-	// 法线属性
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)
-		(3 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(1);
-	// 纹理坐标属性
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(6 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
+	// #4 解释顶点数据：位置、法线、纹理坐标（解码见 multiple_lights.vs）
+	SetupPackedAttributes();
 	// #5 解绑
 	glBindVertexArray(0);
 
+	// **深度预渲染用的VAO：同一个VBO，只需要位置属性
+	GLuint containerDepthVAO;
+	glGenVertexArrays(1, &containerDepthVAO);
+	glBindVertexArray(containerDepthVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, packedVBO);
+	SetupPackedPositionAttribute();
+	glBindVertexArray(0);
+
 
 	// **为灯创建一个VAO
 	GLuint lightVAO;
@@ -204,149 +254,140 @@ int main() {
 
 
 	// ~新建纹理单元~
-	// 新建纹理
-	GLuint diffuseMap, specularMap;  
-	glGenTextures(1, &diffuseMap); // 生成纹理的数量，然后将数据存储在GLuint数组中
-	glGenTextures(1, &specularMap);
+	// 每个材质一张漫射贴图、一张镜面贴图，绘制时按物体的材质绑定
+	GLuint materialCount = scene.MaterialCount();
+	std::vector<GLuint> diffuseMaps(materialCount), specularMaps(materialCount);
+	glGenTextures(materialCount, diffuseMaps.data()); // 生成纹理的数量，然后将数据存储在GLuint数组中
+	glGenTextures(materialCount, specularMaps.data());
 
 	// 纹理共用变量
 	int width, height;    // 图片宽，高
 	unsigned char* image; // 装载纹理变量
 
-	// ~漫射贴图~
-	// 读取纹理
-	image = SOIL_load_image(FileSystem::getPath(
-		"resources/textures/container2.png").c_str(), &width, &height, 0,
-		SOIL_LOAD_RGB);
-	
-	// 绑定
-	glBindTexture(GL_TEXTURE_2D, diffuseMap); 
-	// 生成纹理
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-	// 生成多级渐远纹理
-	glGenerateMipmap(GL_TEXTURE_2D); 
-
-	// 生成了纹理和相应的多级渐远纹理后，解绑纹理对象、释放图像的内存很重要。
-	SOIL_free_image_data(image);
-	glBindTexture(GL_TEXTURE_2D, 0); 
-	 
-	// 设置贴图环绕方式
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT); 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// 设置纹理过滤
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR); 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-
-	// ~镜面贴图~
-    image = SOIL_load_image(FileSystem::getPath("resources/textures/container2_specular.png").c_str(), &width, &height, 0, SOIL_LOAD_RGB);
-    glBindTexture(GL_TEXTURE_2D, specularMap);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    SOIL_free_image_data(image);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-    glBindTexture(GL_TEXTURE_2D, 0);
+	for (GLuint m = 0; m < materialCount; m++)
+	{
+		const SceneMaterial& material = scene.Materials()[m];
+
+		// ~漫射贴图~
+		// 读取纹理
+		image = SOIL_load_image(FileSystem::getPath(scene.String(material.diffuse)).c_str(), &width, &height, 0, SOIL_LOAD_RGB);
+		// 绑定
+		glBindTexture(GL_TEXTURE_2D, diffuseMaps[m]);
+		// 生成纹理
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		// 生成多级渐远纹理
+		glGenerateMipmap(GL_TEXTURE_2D);
+		// 生成了纹理和相应的多级渐远纹理后，释放图像的内存很重要。
+		SOIL_free_image_data(image);
+		// 设置贴图环绕方式
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// 设置纹理过滤
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// ~镜面贴图~
+		image = SOIL_load_image(FileSystem::getPath(scene.String(material.specular)).c_str(), &width, &height, 0, SOIL_LOAD_RGB);
+		glBindTexture(GL_TEXTURE_2D, specularMaps[m]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		SOIL_free_image_data(image);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
     
 	// ~获取Uniform对象，向着色器传递贴图~
 	// 激活对象照明着色器，灯光为lampShader
-	lightingShader.Use();
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.diffuse"),  0);
-	glUniform1i(glGetUniformLocation(lightingShader.Program, "material.specular"), 1);
+	glUseProgram(lightingProgram);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.diffuse"),  0);
+	glUniform1i(glGetUniformLocation(lightingProgram, "material.specular"), 1);
+	SetPackedBounds(lightingProgram, cubeBounds);
 
 
 	// 7.0主循环
 	while (!glfwWindowShouldClose(window))
 	{
-		// 就算当前帧的deltaTime
+		// 7.1检测事件（没有脏标记时阻塞等待事件）
+		invalidator.WaitEvents();
+
+		// 就算当前帧的deltaTime（阻塞等待的时间不计入）
 		GLfloat currentFrame = glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
+		deltaTime = invalidator.Waited() ? 0.0f : currentFrame - lastFrame;
 		lastFrame = currentFrame;
 
-		// 7.1检测事件
-		glfwPollEvents();
 		// 按键处理
 		do_movement();
 
+		// 画面没有变化时不绘制（录制期间每帧都绘制）
+		if (CaptureInProgress())
+			invalidator.Invalidate(DIRTY_ANIMATION);
+		if (!invalidator.ConsumeDirty())
+			continue;
+
 		// 渲染
-		// 7.2清空颜色缓冲
+		// 观察矩阵与投影参数，阴影级联按同一个视锥分割
+		glm::mat4 view = camera.GetViewMatrix();
+		const GLfloat fov = 45.0f, aspect = (GLfloat)WIDTH / (GLfloat)HEIGHT, nearPlane = 0.1f, farPlane = 100.0f;
+
+		// 7.2阴影贴图（缓存有效时不会绘制任何东西）
+		shadowMap.Update(view, fov, aspect, nearPlane, farPlane);
+		shadowMap.Render(shadowShader.Program, [&](GLuint program)
+		{
+			GLint shadowModelLoc = glGetUniformLocation(program, "model");
+			glBindVertexArray(lightVAO); // 只需要位置属性
+			for (GLuint i = 0; i < cubeModels.size(); i++)
+			{
+				glUniformMatrix4fv(shadowModelLoc, 1, GL_FALSE, glm::value_ptr(cubeModels[i]));
+				glDrawArrays(GL_TRIANGLES, 0, 36);
+			}
+			glBindVertexArray(0);
+		});
+
+		// 清空颜色缓冲
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // 清除深度缓冲区
 
 		// 激活对象照明着色器，灯光为lampShader
-		lightingShader.Use();
+		lightingShaders.Use(lightingKey);
 		// 设置视角位置地址
-        GLint viewPosLoc = glGetUniformLocation(lightingShader.Program, "viewPos");
+        GLint viewPosLoc = glGetUniformLocation(lightingProgram, "viewPos");
 		glUniform3f(viewPosLoc,     camera.Position.x, camera.Position.y, camera.Position.z);
-		// Set material properties
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "material.shininess"), 32.0f);
+		// 材质（贴图和反光度）在绘制每个箱子时按物体的材质设置
         // == ==========================
         // 灯光属性链接、赋值
         // == ==========================
         // Directional light
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "dirLight.direction"), -0.2f, -1.0f, -0.3f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "dirLight.ambient"), 0.05f, 0.05f, 0.05f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "dirLight.diffuse"), 0.4f, 0.4f, 0.4f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "dirLight.specular"), 0.5f, 0.5f, 0.5f);
-        // Point light 1
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[0].position"), pointLightPositions[0].x, pointLightPositions[0].y, pointLightPositions[0].z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[0].ambient"), 0.05f, 0.05f, 0.05f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[0].diffuse"), 0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[0].specular"), 1.0f, 1.0f, 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[0].constant"), 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[0].linear"), 0.09);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[0].quadratic"), 0.032);
-        // Point light 2
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[1].position"), pointLightPositions[1].x, pointLightPositions[1].y, pointLightPositions[1].z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[1].ambient"), 0.05f, 0.05f, 0.05f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[1].diffuse"), 0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[1].specular"), 1.0f, 1.0f, 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[1].constant"), 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[1].linear"), 0.09);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[1].quadratic"), 0.032);
-        // Point light 3
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[2].position"), pointLightPositions[2].x, pointLightPositions[2].y, pointLightPositions[2].z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[2].ambient"), 0.05f, 0.05f, 0.05f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[2].diffuse"), 0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[2].specular"), 1.0f, 1.0f, 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[2].constant"), 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[2].linear"), 0.09);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[2].quadratic"), 0.032);
-        // Point light 4
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[3].position"), pointLightPositions[3].x, pointLightPositions[3].y, pointLightPositions[3].z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[3].ambient"), 0.05f, 0.05f, 0.05f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[3].diffuse"), 0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "pointLights[3].specular"), 1.0f, 1.0f, 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[3].constant"), 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[3].linear"), 0.09);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "pointLights[3].quadratic"), 0.032);
+        glUniform3f(glGetUniformLocation(lightingProgram, "dirLight.direction"), dirLightDirection.x, dirLightDirection.y, dirLightDirection.z);
+        glUniform3f(glGetUniformLocation(lightingProgram, "dirLight.ambient"), dirLight.ambient.x, dirLight.ambient.y, dirLight.ambient.z);
+        glUniform3f(glGetUniformLocation(lightingProgram, "dirLight.diffuse"), dirLight.diffuse.x, dirLight.diffuse.y, dirLight.diffuse.z);
+        glUniform3f(glGetUniformLocation(lightingProgram, "dirLight.specular"), dirLight.specular.x, dirLight.specular.y, dirLight.specular.z);
+        // 点光源在绘制每个箱子时按物体上传
         // SpotLight
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "spotLight.position"), camera.Position.x, camera.Position.y, camera.Position.z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "spotLight.direction"), camera.Front.x, camera.Front.y, camera.Front.z);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "spotLight.ambient"), 0.0f, 0.0f, 0.0f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "spotLight.diffuse"), 1.0f, 1.0f, 1.0f);
-        glUniform3f(glGetUniformLocation(lightingShader.Program, "spotLight.specular"), 1.0f, 1.0f, 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "spotLight.constant"), 1.0f);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "spotLight.linear"), 0.09);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "spotLight.quadratic"), 0.032);
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "spotLight.cutOff"), glm::cos(glm::radians(12.5f)));
-        glUniform1f(glGetUniformLocation(lightingShader.Program, "spotLight.outerCutOff"), glm::cos(glm::radians(15.0f)));
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.position"), camera.Position.x, camera.Position.y, camera.Position.z);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.direction"), camera.Front.x, camera.Front.y, camera.Front.z);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.ambient"), 0.0f, 0.0f, 0.0f);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.diffuse"), 1.0f, 1.0f, 1.0f);
+        glUniform3f(glGetUniformLocation(lightingProgram, "spotLight.specular"), 1.0f, 1.0f, 1.0f);
+        glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.constant"), 1.0f);
+        glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.linear"), 0.09);
+        glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.quadratic"), 0.032);
+        glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.cutOff"), glm::cos(glm::radians(12.5f)));
+        glUniform1f(glGetUniformLocation(lightingProgram, "spotLight.outerCutOff"), glm::cos(glm::radians(15.0f)));
 
 
 		// 7.5创建摄影机/视角变换
-		// 定义视角（观察者）矩阵
-		glm::mat4 view; 
-		// 使用摄像机类创建观察矩阵,并将其传递给视图矩阵
-		view = camera.GetViewMatrix();
+		// 观察矩阵已在 7.2 之前由摄像机类创建
 		// 创建投影矩阵
 		glm::mat4 projection;
-		projection = glm::perspective(45.0f, (GLfloat)WIDTH / (GLfloat)HEIGHT, 0.1f, 100.0f);
+		projection = glm::perspective(fov, aspect, nearPlane, farPlane);
 
 		// 获取各个矩阵在着色器的uniform的地址
-		GLint modelLoc = glGetUniformLocation(lightingShader.Program, "model");
-		GLint viewLoc  = glGetUniformLocation(lightingShader.Program, "view");
-		GLint projLoc  = glGetUniformLocation(lightingShader.Program, "projection");
+		GLint modelLoc = glGetUniformLocation(lightingProgram, "model");
+		GLint viewLoc  = glGetUniformLocation(lightingProgram, "view");
+		GLint projLoc  = glGetUniformLocation(lightingProgram, "projection");
 
 		// 把矩阵传递给着色器 
 		// 参数1：uniform的地址(Location)
@@ -359,35 +400,54 @@ int main() {
 		glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
 		glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
-		// 激活漫反射贴图
-		glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, diffuseMap);
-		// 激活镜面贴图
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, specularMap);
+		// 漫反射贴图、镜面贴图使用第1、2个纹理单元，阴影贴图使用第3个纹理单元
+		shadowMap.Bind(lightingProgram, 2);
 
 		// 7.6绘制图形
+		// 打开深度预渲染时，先只写箱子的深度，照明时只着色最前面的片段
+		if (depthPrepassEnabled)
+		{
+			GLuint depthProgram = depthPrepass.Begin(PERM_PACKED_VERTICES);
+			GLint depthModelLoc = glGetUniformLocation(depthProgram, "model");
+			glUniformMatrix4fv(glGetUniformLocation(depthProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
+			glUniformMatrix4fv(glGetUniformLocation(depthProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+			SetPackedBounds(depthProgram, cubeBounds);
+			glBindVertexArray(containerDepthVAO);
+			for (GLuint i = 0; i < cubeModels.size(); i++)
+			{
+				glUniformMatrix4fv(depthModelLoc, 1, GL_FALSE, glm::value_ptr(cubeModels[i]));
+				glDrawArrays(GL_TRIANGLES, 0, 36);
+			}
+			depthPrepass.BeginShading();
+			lightingShaders.Use(lightingKey);
+		}
 		glm::mat4 model; 
 		glBindVertexArray(containerVAO); // 绑VAO
-		for (GLuint i = 0; i < 10; i++)
+		GLuint boundMaterial = SCENE_NO_INDEX;
+		for (GLuint i = 0; i < cubeModels.size(); i++)
         {
-			model = glm::mat4(); // 清空模型矩阵
-			
-			// 平移
-			model = glm::translate(model, cubePositions[i]); // 引入早已定义好的空间位置
-			
-			// 旋转（欧拉角）
-			// 在3D空间中旋转需要一个角(angle)和一个旋转轴(Rotation Axis)。
-			GLfloat angle = 20.0f * i;                    // 角位移
-			glm::vec3 axis = glm::vec3(1.0f, 0.3f, 0.5f); // 旋转轴
-			model = glm::rotate(model, angle, axis);      // 将模型矩阵绕axis轴旋转angle度
-			
+			// 材质与上一个箱子不同时才重新绑定
+			GLuint material = sceneObjects[i].material;
+			if (material != boundMaterial)
+			{
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D, diffuseMaps[material]);
+				glActiveTexture(GL_TEXTURE1);
+				glBindTexture(GL_TEXTURE_2D, specularMaps[material]);
+				glUniform1f(glGetUniformLocation(lightingProgram, "material.shininess"), scene.Materials()[material].shininess);
+				boundMaterial = material;
+			}
 			// 将矩阵传入着色器
-			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(cubeModels[i]));
+			// 为箱子挑选灯光（包围球来自场景文件）
+			lightAssigner.Assign(sceneObjects[i].center, sceneObjects[i].radius);
+			lightAssigner.Upload(lightingProgram);
 			// ~绘制箱子~
 			glDrawArrays(GL_TRIANGLES, 0, 36); // 共36个顶点
 		}
 		glBindVertexArray(0); // 解绑
+		if (depthPrepassEnabled)
+			depthPrepass.End();
 
 		// 激活灯光着色器
 		lampShader.Use();
@@ -400,12 +460,12 @@ int main() {
 		glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
 		glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
-		// 绘制光源，目前有4个点光源
+		// 在每个点光源的位置绘制一个小方块
         glBindVertexArray(lightVAO);
-        for (GLuint i = 0; i < 4; i++)
+        for (GLuint i = 0; i < pointLights.size(); i++)
         {
             model = glm::mat4();
-            model = glm::translate(model, pointLightPositions[i]); // 平移到预先指定的位置
+            model = glm::translate(model, pointLights[i].position); // 平移到点光源的位置
             model = glm::scale(model, glm::vec3(0.2f)); // Make it a smaller cube
             glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
             glDrawArrays(GL_TRIANGLES, 0, 36);
@@ -413,13 +473,18 @@ int main() {
         glBindVertexArray(0);
 
 		// 7.7交换缓冲区
+		CaptureEndFrame();
 		glfwSwapBuffers(window);
 	}
 	// 8.0释放资源
 	glDeleteVertexArrays(1, &containerVAO);
+	glDeleteVertexArrays(1, &containerDepthVAO);
 	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &packedVBO);
 
 	glDeleteVertexArrays(1, &lightVAO);
+	glDeleteTextures(materialCount, diffuseMaps.data());
+	glDeleteTextures(materialCount, specularMaps.data());
 
 	glfwTerminate();
 	return 0;
@@ -429,6 +494,13 @@ int main() {
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode) {
 	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
 		glfwSetWindowShouldClose(window, GL_TRUE);
+	if (key == GLFW_KEY_P && action == GLFW_PRESS)
+		depthPrepassEnabled = !depthPrepassEnabled;
+	if (key == GLFW_KEY_O && action == GLFW_PRESS)
+		invalidator.OnDemand = !invalidator.OnDemand;
+	if (key == GLFW_KEY_C && action == GLFW_PRESS)
+		CaptureFrames("multiple_lights.glcap", 3); // 用 tools/gl_replay 回放
+	invalidator.Invalidate(DIRTY_INPUT);
 
 	// 键位状态记录(待住函数中一并处理，则可支持多键位同事处理）
 	if (key >= 0 && key < 1024)
@@ -453,6 +525,9 @@ void do_movement()
 		camera.ProcessKeyboard(LEFT, deltaTime);
 	if (keys[GLFW_KEY_D])
 		camera.ProcessKeyboard(RIGHT, deltaTime);
+	// 按住移动键时摄像机每帧都在动
+	if (keys[GLFW_KEY_W] || keys[GLFW_KEY_S] || keys[GLFW_KEY_A] || keys[GLFW_KEY_D])
+		invalidator.Invalidate(DIRTY_CAMERA);
 }
 
 bool firstMouse = true;
@@ -475,9 +550,16 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 	yoffset *= sensitivity;
 
 	camera.ProcessMouseMovement(xoffset, yoffset);
+	invalidator.Invalidate(DIRTY_CAMERA);
 }
 
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
 	camera.ProcessMouseScroll(yoffset);
+	invalidator.Invalidate(DIRTY_CAMERA);
+}
+
+void refresh_callback(GLFWwindow* window)
+{
+	invalidator.Invalidate(DIRTY_WINDOW);
 }
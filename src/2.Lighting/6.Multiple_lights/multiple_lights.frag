@@ -1,9 +1,38 @@
 #version 330 core
 
+// == ======================================
+// 变体开关，由 ShaderPermutation 在 #version 后注入。
+// 单独载入本文件时使用下面的默认值（与原来的效果一致）。
+// == ======================================
+#ifndef NR_POINT_LIGHTS
+#define NR_POINT_LIGHTS 4   // 点光源的数量
+#endif
+#ifndef USE_DIR_LIGHT
+#define USE_DIR_LIGHT 1     // 平行光
+#endif
+#ifndef USE_SPOT_LIGHT
+#define USE_SPOT_LIGHT 1    // 聚光灯
+#endif
+#ifndef USE_SPECULAR_MAP
+#define USE_SPECULAR_MAP 1  // 镜面贴图
+#endif
+#ifndef USE_LIGHT_LIST
+#define USE_LIGHT_LIST 0    // 点光源按物体分配，NR_POINT_LIGHTS 为上限
+#endif
+#ifndef USE_SHADOWS
+#define USE_SHADOWS 0       // 平行光级联阴影
+#endif
+
+#define MAX_CASCADES 4      // 与 CascadedShadowMap::MAX_CASCADES 一致
+
 // 结构体定义
 struct Material {       // 材质属性
     sampler2D diffuse;  // 漫反射贴图（通常就是物体本来的贴图）
+#if USE_SPECULAR_MAP
     sampler2D specular; // 高光（镜面）贴图
+#else
+    vec3 specularColor; // 没有镜面贴图时的高光颜色
+#endif
     float shininess;    // 高光的范围（幂）
 }; 
 
@@ -43,9 +72,6 @@ struct SpotLight {      // 聚光灯属性
     vec3 specular;       
 };
 
-// 定义点光源的数量
-#define NR_POINT_LIGHTS 4
-
 in vec3 FragPos;      // 本片段的位置
 in vec3 Normal;       // 法向量
 in vec2 TexCoords;    // 贴图坐标
@@ -53,32 +79,75 @@ in vec2 TexCoords;    // 贴图坐标
 out vec4 color;       // 最终输出颜色
 
 uniform vec3 viewPos; // 视角（观察者）位置
+#if USE_DIR_LIGHT
 uniform DirLight dirLight;
+#endif
+#if NR_POINT_LIGHTS > 0
 uniform PointLight pointLights[NR_POINT_LIGHTS];
+#endif
+#if USE_LIGHT_LIST
+uniform int nrPointLights; // 本次绘制实际分配到的点光源数量
+#endif
+#if USE_SPOT_LIGHT
 uniform SpotLight spotLight;
+#endif
 uniform Material material;
+#if USE_SHADOWS
+uniform mat4 view;                             // 与顶点着色器共用，用于选择级联
+uniform sampler2DArray shadowMap;              // 每层一个级联
+uniform mat4 lightSpaceMatrices[MAX_CASCADES];
+uniform float cascadeSplits[MAX_CASCADES];     // 各级联的远端距离（观察空间）
+uniform int cascadeCount;
+#endif
+
+// 本片段的贴图采样只做一次，各光源共用
+vec3 diffTex;
+vec3 specTex;
 
 // 函数原型-灯光照射彩度计算
 vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+float CalcShadow(vec3 normal, vec3 lightDir);
 
 void main()
 {    
     // 属性计算
     vec3 norm = normalize(Normal); // 因为顶点数据间的片段会进行插值，所以需要标准化法向量
     vec3 viewDir = normalize(viewPos - FragPos); // 计算视角指向
+
+    // 纹理采样
+    diffTex = vec3(texture(material.diffuse, TexCoords));
+#if USE_SPECULAR_MAP
+    specTex = vec3(texture(material.specular, TexCoords));
+#else
+    specTex = material.specularColor;
+#endif
     
     // == ======================================
     // 分三阶段计算光照，最后将结果合并。
+    // 未启用的阶段在预处理时就被去掉了。
     // == ======================================
+    vec3 result = vec3(0.0);
     // 阶段 1: 平行光
-    vec3 result = CalcDirLight(dirLight, norm, viewDir);
+#if USE_DIR_LIGHT
+    result += CalcDirLight(dirLight, norm, viewDir);
+#endif
     // 阶段 2: 点光
+#if NR_POINT_LIGHTS > 0
     for(int i = 0; i < NR_POINT_LIGHTS; i++)
+    {
+#if USE_LIGHT_LIST
+        if(i >= nrPointLights)
+            break;
+#endif
         result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);    
+    }
+#endif
     // 阶段 3: 聚光灯
+#if USE_SPOT_LIGHT
     result += CalcSpotLight(spotLight, norm, FragPos, viewDir);    
+#endif
     
     color = vec4(result, 1.0);
 }
@@ -93,10 +162,16 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
     // 合并结果
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+    vec3 ambient = light.ambient * diffTex;
+    vec3 diffuse = light.diffuse * diff * diffTex;
+    vec3 specular = light.specular * spec * specTex;
+#if USE_SHADOWS
+    // 阴影只遮挡漫反射和高光
+    float shadow = CalcShadow(normal, lightDir);
+    return (ambient + (1.0 - shadow) * (diffuse + specular));
+#else
     return (ambient + diffuse + specular);
+#endif
 }
 
 // 计算点光的光照彩度
@@ -112,9 +187,9 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
     float distance = length(light.position - fragPos);
     float attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
     // 合并结果
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+    vec3 ambient = light.ambient * diffTex;
+    vec3 diffuse = light.diffuse * diff * diffTex;
+    vec3 specular = light.specular * spec * specTex;
     ambient *= attenuation;
     diffuse *= attenuation;
     specular *= attenuation;
@@ -133,16 +208,55 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
     // 计算灯光衰减系数
     float distance = length(light.position - fragPos);
     float attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
-    // 聚光灯强度(边缘模糊)
+    // 聚光灯强度(边缘模糊)，只作用于漫反射和高光，环境光不受光切角限制
     float theta = dot(lightDir, normalize(-light.direction)); 
     float epsilon = light.cutOff - light.outerCutOff;
     float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
     // 合并结果
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    ambient *= attenuation * intensity;
+    vec3 ambient = light.ambient * diffTex;
+    vec3 diffuse = light.diffuse * diff * diffTex;
+    vec3 specular = light.specular * spec * specTex;
+    ambient *= attenuation;
     diffuse *= attenuation * intensity;
     specular *= attenuation * intensity;
     return (ambient + diffuse + specular);
 }
+
+#if USE_SHADOWS
+// 计算平行光的阴影系数（0 为完全照亮，1 为完全在阴影中）
+float CalcShadow(vec3 normal, vec3 lightDir)
+{
+    // 按观察空间深度选择级联
+    float depth = abs((view * vec4(FragPos, 1.0)).z);
+    int layer = cascadeCount - 1;
+    for(int i = 0; i < cascadeCount; i++)
+    {
+        if(depth < cascadeSplits[i])
+        {
+            layer = i;
+            break;
+        }
+    }
+
+    vec4 lightSpacePos = lightSpaceMatrices[layer] * vec4(FragPos, 1.0);
+    vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w * 0.5 + 0.5;
+    if(projCoords.z > 1.0)
+        return 0.0;
+
+    // 斜面上需要更大的偏移（深度贴图渲染时另有 glPolygonOffset）
+    float bias = max(0.005 * (1.0 - dot(normal, lightDir)), 0.0005);
+
+    // 3x3 PCF 软化边缘
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    for(int x = -1; x <= 1; x++)
+    {
+        for(int y = -1; y <= 1; y++)
+        {
+            float closest = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, layer)).r;
+            shadow += (projCoords.z - bias > closest) ? 1.0 : 0.0;
+        }
+    }
+    return shadow / 9.0;
+}
+#endif
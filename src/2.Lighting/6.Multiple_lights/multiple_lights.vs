@@ -0,0 +1,59 @@
+#version 330 core
+// 压缩顶点（由 ShaderPermutation 的 PERM_PACKED_VERTICES 打开，格式见 vertex_packing.h）
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 0
+#endif
+
+#if PACKED_VERTICES
+layout (location = 0) in vec3 position;  // 数据位0 相对包围盒的位置 [0,1]
+layout (location = 1) in vec2 normal;    // 数据位1 八面体编码的法线
+layout (location = 2) in vec2 texCoords; // 数据位2 纹理坐标（半精度）
+
+uniform vec3 positionMin;   // 包围盒最小点
+uniform vec3 positionScale; // 包围盒尺寸
+#else
+layout (location = 0) in vec3 position;  // 数据位0 顶点位置
+layout (location = 1) in vec3 normal;    // 数据位1 法线向量
+layout (location = 2) in vec2 texCoords; // 数据位2 纹理坐标
+#endif
+
+invariant gl_Position;   // 与 depth_prepass.vs 的深度逐位相同（深度预渲染后用 GL_EQUAL）
+
+out vec3 Normal;         // 法向量
+out vec3 FragPos;        // 片段位置
+out vec2 TexCoords;      // 纹理坐标
+
+uniform mat4 model;      // 模型矩阵
+uniform mat4 view;       // 视图矩阵
+uniform mat4 projection; // 投影矩阵
+
+#if PACKED_VERTICES
+// 八面体解码
+vec3 OctDecode(vec2 e)
+{
+	vec3 n = vec3(e.xy, 1.0f - abs(e.x) - abs(e.y));
+	if(n.z < 0.0f)
+		n.xy = (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+	return normalize(n);
+}
+#endif
+
+void main()
+{
+#if PACKED_VERTICES
+	vec3 localPos = positionMin + position * positionScale;
+	vec3 localNormal = OctDecode(normal);
+#else
+	vec3 localPos = position;
+	vec3 localNormal = normal;
+#endif
+	// 顶点矩阵计算
+	gl_Position = projection * view * model * vec4(localPos, 1.0f);
+	// 片段位置计算
+	FragPos = vec3(model * vec4(localPos, 1.0f));
+	// 法线向量随模型矩阵的正规矩阵变换
+	Normal = mat3(transpose(inverse(model))) * localNormal;
+	
+	// 传递纹理坐标
+	TexCoords = texCoords;
+}
@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 position; // 只需要顶点位置
+
+uniform mat4 lightSpaceMatrix;          // 当前级联的灯光空间矩阵
+uniform mat4 model;                     // 模型矩阵
+
+void main()
+{
+    gl_Position = lightSpaceMatrix * model * vec4(position, 1.0f);
+}
@@ -4,6 +4,8 @@
 // GLEW - 能自动识别你的平台所支持的全部OpenGL高级扩展涵数
 #define GLEW_STATIC
 #include <GL/glew.h>
+// GL 命令录制（定义 GL_CAPTURE 时生效），必须紧接在 glew 之后
+#include <learnopengl/gl_capture.h>
 
 // GLFW - OpenGL 窗口管理、分辨率切换、键盘、鼠标以及游戏手柄、定时器输入、线程创建等等。
 #include <GLFW/glfw3.h>
@@ -13,6 +15,11 @@
 #include <learnopengl/camera.h>     // 摄影机类
 #include <learnopengl/model.h>      // 载入模型类
 #include <learnopengl/filesystem.h> // 文件路径类
+#include <learnopengl/model_lod.h>  // 模型LOD
+#include <learnopengl/obj_asset_loader.h> // 多线程OBJ载入（支持资源包）
+#include <learnopengl/assimp_loader.h> // 多线程Assimp载入
+#include <learnopengl/frame_invalidation.h> // 按需渲染
+#include <learnopengl/scene_file.h> // 场景文件
 
 // GLM Mathemtics
 #include <glm/glm.hpp>
@@ -29,6 +36,7 @@ GLuint screenWidth = 800, screenHeight = 600;
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+void refresh_callback(GLFWwindow* window);
 void Do_Movement();
 
 // Camera
@@ -40,9 +48,15 @@ bool firstMouse = true;
 GLfloat deltaTime = 0.0f;
 GLfloat lastFrame = 0.0f;
 
+// 按需渲染：画面不变时不重画（O键切换为连续渲染）
+FrameInvalidator invalidator;
+
 // 主函数,从这里开始我们的应用程序并运行我们的游戏循环
-int main()
+// 参数：model_rendered [assimp]，指定 assimp 时跳过OBJ解析器，直接用Assimp载入
+int main(int argc, char** argv)
 {
+    bool forceAssimp = argc > 1 && std::string(argv[1]) == "assimp";
+
     // Init GLFW
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -57,6 +71,7 @@ int main()
     glfwSetKeyCallback(window, key_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetWindowRefreshCallback(window, refresh_callback);
 
     // Options
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); // 不显示鼠标
@@ -75,7 +90,30 @@ int main()
     Shader shader("shader.vs", "shader.frag");
 
     // 载入模型
-    Model ourModel(FileSystem::getPath("resources/objects/nanosuit/nanosuit.obj").c_str());
+    // 先用多线程OBJ解析器生成CPU数据（失败或指定 assimp 时用Assimp，同样按网格并行转换），
+    // 贴图并行解码，最后在主线程统一上传
+    // 运行目录下有 resources.pak 时先挂载，之后的读取优先从资源包中取
+    MountAssetPack("resources.pak", FileSystem::getPath(""));
+    // 模型路径和变换来自场景文件（model_loading.scene.json，第一次运行时烘焙成 .scn）
+    SceneFile scene;
+    if(!OpenScene("model_loading.scene.json", scene) || scene.ObjectCount() == 0)
+        return -1;
+    const SceneObject& sceneObject = scene.Objects()[0];
+    if(sceneObject.model >= scene.ModelCount() || scene.Models()[sceneObject.model].path == SCENE_NO_INDEX)
+    {
+        std::cout << "ERROR::SCENE_FILE:: first object of model_loading.scene.json must reference a model with a path" << std::endl;
+        return -1;
+    }
+    std::string modelPath = FileSystem::getPath(scene.String(scene.Models()[sceneObject.model].path));
+    ModelData modelData;
+    if(forceAssimp || !LoadPackedObj(modelPath, modelData))
+    {
+        modelData = ModelData();
+        if(!LoadAssimp(modelPath, modelData))
+            return -1;
+    }
+    // 为每个网格生成LOD链（顶点只上传一份，各级共用），绘制时按屏幕空间误差选择级别
+    LodModel ourLods(modelData);
 
     // 线框模式
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -83,15 +121,22 @@ int main()
     // Game loop
     while(!glfwWindowShouldClose(window))
     {
-        // Set frame time
+        // 检测并调用事件（没有脏标记时阻塞等待事件）
+        invalidator.WaitEvents();
+
+        // Set frame time（阻塞等待的时间不计入）
         GLfloat currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
+        deltaTime = invalidator.Waited() ? 0.0f : currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // 检测并调用事件
-        glfwPollEvents();
         Do_Movement();
 
+        // 画面没有变化时不绘制（录制期间每帧都绘制）
+        if(CaptureInProgress())
+            invalidator.Invalidate(DIRTY_ANIMATION);
+        if(!invalidator.ConsumeDirty())
+            continue;
+
         // 清除颜色缓冲区
         glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -106,13 +151,12 @@ int main()
         glUniformMatrix4fv(glGetUniformLocation(shader.Program, "view"), 1, GL_FALSE, glm::value_ptr(view));
 
         // 绘制载入的模型
-        glm::mat4 model;
-        model = glm::translate(model, glm::vec3(0.0f, -1.75f, 0.0f)); // Translate it down a bit so it's at the center of the scene
-        model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));	// It's a bit too big for our scene, so scale it down
+        glm::mat4 model = sceneObject.transform; // 下移到场景中心并缩小，烘焙时已算好
         glUniformMatrix4fv(glGetUniformLocation(shader.Program, "model"), 1, GL_FALSE, glm::value_ptr(model));
-        ourModel.Draw(shader);       
+        ourLods.Draw(shader, camera, model, (GLfloat)screenHeight);
 
         // 释放缓冲
+        CaptureEndFrame();
         glfwSwapBuffers(window);
     }
 
@@ -135,12 +179,20 @@ void Do_Movement()
         camera.ProcessKeyboard(LEFT, deltaTime);
     if(keys[GLFW_KEY_D])
         camera.ProcessKeyboard(RIGHT, deltaTime);
+    // 按住移动键时摄像机每帧都在动
+    if(keys[GLFW_KEY_W] || keys[GLFW_KEY_S] || keys[GLFW_KEY_A] || keys[GLFW_KEY_D])
+        invalidator.Invalidate(DIRTY_CAMERA);
 }
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode)
 {
     if(key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(window, GL_TRUE);
+    if(key == GLFW_KEY_O && action == GLFW_PRESS)
+        invalidator.OnDemand = !invalidator.OnDemand;
+    if(key == GLFW_KEY_C && action == GLFW_PRESS)
+        CaptureFrames("model_loading.glcap", 3); // 用 tools/gl_replay 回放
+    invalidator.Invalidate(DIRTY_INPUT);
 
     if(action == GLFW_PRESS)
         keys[key] = true;
@@ -164,11 +216,18 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos)
     lastY = ypos;
 
     camera.ProcessMouseMovement(xoffset, yoffset);
+    invalidator.Invalidate(DIRTY_CAMERA);
 }	
 
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
+    invalidator.Invalidate(DIRTY_CAMERA);
+}
+
+void refresh_callback(GLFWwindow* window)
+{
+    invalidator.Invalidate(DIRTY_WINDOW);
 }
 
 #pragma endregion
@@ -1,10 +1,33 @@
 #version 330 core
+// 贴图数组（格式见 texture_array.h）
+#ifndef TEXTURE_ARRAY
+#define TEXTURE_ARRAY 0
+#endif
+
 in vec2 TexCoords;
 out vec4 color;
 
+#if TEXTURE_ARRAY
+uniform sampler2DArray materialTextures;
+uniform float diffuseLayer; // 层，-1 表示没有漫反射贴图
+uniform vec4 diffuseRect;   // 层内的 UV 矩形
+#else
 uniform sampler2D texture_diffuse1;
+#endif
 
 void main()
 {    
+#if TEXTURE_ARRAY
+    if(diffuseLayer < 0.0f)
+    {
+        color = vec4(1.0f);
+        return;
+    }
+    // 图集中的贴图用 fract 保留重复寻址；显式求导避免 fract 跳变处选错 mip
+    vec2 uv = diffuseRect.xy + fract(TexCoords) * diffuseRect.zw;
+    vec2 dx = dFdx(TexCoords) * diffuseRect.zw, dy = dFdy(TexCoords) * diffuseRect.zw;
+    color = textureGrad(materialTextures, vec3(uv, diffuseLayer), dx, dy);
+#else
     color = texture(texture_diffuse1, TexCoords);
+#endif
 }
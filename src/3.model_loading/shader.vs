@@ -1,8 +1,21 @@
 #version 330 core
+// 压缩顶点（格式见 vertex_packing.h）
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 0
+#endif
+
+#if PACKED_VERTICES
+layout (location = 0) in vec3 position; // 相对包围盒的位置 [0,1]
+uniform vec3 positionMin;
+uniform vec3 positionScale;
+#else
 layout (location = 0) in vec3 position;
+#endif
 // layout (location = 1) in vec3 normal;
 layout (location = 2) in vec2 texCoords;
 
+invariant gl_Position; // 与深度预渲染的深度逐位相同（depth_prepass.vs）
+
 out vec2 TexCoords;
 
 uniform mat4 model;
@@ -11,6 +24,11 @@ uniform mat4 projection;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(position, 1.0f);
+#if PACKED_VERTICES
+    vec3 localPos = positionMin + position * positionScale;
+#else
+    vec3 localPos = position;
+#endif
+    gl_Position = projection * view * model * vec4(localPos, 1.0f);
     TexCoords = texCoords;
 }
@@ -0,0 +1,627 @@
+// 流处理
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+// GLEW
+// GLEW 能自动识别你的平台所支持的全部OpenGL高级扩展涵数
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// GLFW
+// OpenGL 窗口管理、分辨率切换、键盘、鼠标以及游戏手柄、定时器输入、线程创建等等。
+#include <GLFW/glfw3.h>
+
+// Other Libs
+// 图像读取库
+#include <SOIL.h>
+// GLM 数学库
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Other includes
+#include <learnopengl/shader.h>
+#include <learnopengl/model.h>
+#include <learnopengl/filesystem.h>
+#include <learnopengl/shader_permutation.h>
+#include <learnopengl/light_assignment.h>
+#include <learnopengl/scene_generator.h>
+#include <learnopengl/obj_asset_loader.h>
+#include <learnopengl/assimp_loader.h>
+#include <learnopengl/model_arena.h>
+#include <learnopengl/vertex_packing.h>
+#include <learnopengl/trace.h>
+#include <learnopengl/occlusion_culler.h>
+#include <learnopengl/depth_prepass.h>
+#include <learnopengl/dynamic_resolution.h>
+#include <learnopengl/entity_world.h>
+
+// == ======================================
+// 压力测试：用随机生成的场景跑现有的光照流程，
+// 输出帧率和每秒绘制调用数随物体数 N、灯光数 M 的变化曲线。
+// 用法：stress_scene [种子] [分布: uniform|clustered|grid|shell] [目标帧时间(毫秒)，打开动态分辨率]
+// == ======================================
+
+// 窗口尺寸
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+// 每个配置的预热帧数和计时帧数
+const GLuint WARMUP_FRAMES = 10;
+const GLuint TIMED_FRAMES  = 120;
+
+// 每个物体最多分配的点光源数
+const GLuint MAX_OBJECT_LIGHTS = 4;
+
+// 实体的网格编号（MeshRef::mesh）
+enum StressMesh
+{
+	MESH_CUBE,
+	MESH_MODEL
+};
+
+// 一次测试的结果
+struct StressResult
+{
+	SceneConfig config;
+	bool depthPrepass;
+	bool occlusionCulling;
+	GLdouble framesPerSecond;
+	GLdouble drawsPerSecond;
+	GLdouble occludedFraction; // 计时帧中被遮挡剔除的物体比例
+	DynamicResolutionStats resolution; // 计时帧中动态分辨率的比例（没有打开时为 1）
+};
+
+// 渲染所需的GL资源
+struct StressRenderer
+{
+	GLuint lightingProgram;
+	GLuint cubeVAO;
+	GLuint cubeDepthVAO;      // 只有位置属性（深度预渲染用）
+	PackedBounds cubeBounds;
+	GLuint diffuseMap, specularMap;
+	GLuint modelProgram;
+	ArenaModel* model;
+	DepthPrepass* depthPrepass;
+	DynamicResolution* dynamicResolution; // 没有指定目标帧时间时为空
+	glm::vec3 modelMin, modelMax; // 模型的包围盒（遮挡剔除用）
+};
+
+GLuint LoadTexture(const char* path);
+StressResult RunScene(GLFWwindow* window, StressRenderer& renderer, const SceneConfig& config, bool depthPrepass, bool occlusionCulling);
+
+// 主程序
+int main(int argc, char** argv) {
+	// 命令行参数
+	SceneConfig base;
+	base.seed = (argc > 1) ? GLuint(std::atoi(argv[1])) : 1u;
+	if (argc > 2)
+	{
+		std::string name = argv[2];
+		if (name == "clustered")  base.distribution = DIST_CLUSTERED;
+		else if (name == "grid")  base.distribution = DIST_GRID;
+		else if (name == "shell") base.distribution = DIST_SHELL;
+	}
+	GLfloat targetFrameMs = (argc > 3) ? GLfloat(std::atof(argv[3])) : 0.0f;
+
+	// 启动阶段和每帧的各段都记录到 stress_trace.json（Chrome trace_event 格式）
+	StartTracing();
+	TraceThreadName("main");
+	TraceBegin("Startup");
+
+	// 1.0初始化GLFW
+	TraceBegin("CreateWindow");
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+
+	// 2.0创建窗口对象
+	GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "LearnOpenGL - stress", nullptr, nullptr);
+	glfwMakeContextCurrent(window);
+	// 关闭垂直同步，否则帧率被显示器刷新率限制
+	glfwSwapInterval(0);
+	TraceEnd("CreateWindow");
+
+	// 3.0初始化GLEW
+	TraceBegin("glewInit");
+	glewExperimental = GL_TRUE;
+	glewInit();
+	TraceEnd("glewInit");
+
+	// 4.0视口配置
+	glViewport(0, 0, WIDTH, HEIGHT);
+	glEnable(GL_DEPTH_TEST);
+
+	// 5.0着色器：箱子使用多光源的变体（平行光 + 按物体分配的点光源 + 聚光灯 + 镜面贴图），
+	// 箱子和模型都使用压缩顶点，模型的贴图放在一个贴图数组中
+	TraceBegin("CompileShaders");
+	ShaderPermutation lightingShaders("../2.Lighting/6.Multiple_lights/multiple_lights.vs",
+	                                  "../2.Lighting/6.Multiple_lights/multiple_lights.frag");
+	StressRenderer renderer;
+	renderer.lightingProgram = lightingShaders.Get(PermutationKey(
+		PERM_DIR_LIGHT | PERM_SPOT_LIGHT | PERM_SPECULAR_MAP | PERM_LIGHT_LIST | PERM_PACKED_VERTICES, MAX_OBJECT_LIGHTS));
+	ShaderPermutation modelShaders("../3.model_loading/shader.vs", "../3.model_loading/shader.frag");
+	renderer.modelProgram = modelShaders.Get(PERM_PACKED_VERTICES | PERM_TEXTURE_ARRAY);
+	DepthPrepass depthPrepass("../2.Lighting/6.Multiple_lights/depth_prepass.vs", "../2.Lighting/6.Multiple_lights/depth_prepass.frag");
+	renderer.depthPrepass = &depthPrepass;
+	TraceEnd("CompileShaders");
+
+	// 动态分辨率：先画到离屏目标，按 GPU 耗时调整比例后放大到窗口
+	DynamicResolution dynamicResolution(WIDTH, HEIGHT, targetFrameMs * 0.001f);
+	renderer.dynamicResolution = (targetFrameMs > 0.0f) ? &dynamicResolution : nullptr;
+
+	// 6.0顶点数据
+	GLfloat vertices[] = {
+        // Positions          // Normals           // Texture Coords
+        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
+         0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f,
+         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
+         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  1.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
+
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  1.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
+
+        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
+        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
+        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
+        -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
+        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
+
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
+         0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
+         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
+         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
+         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
+
+        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
+         0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  1.0f,
+         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
+
+        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,
+         0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
+    };
+
+	// 压缩成16字节/顶点
+	std::vector<PackedVertex> packedVertices;
+	std::vector<Vertex> cubeVertices = VerticesFromInterleaved(vertices, 36);
+	PackedBounds cubeBounds = PackVertices(&cubeVertices[0], cubeVertices.size(), packedVertices);
+
+	GLuint VBO;
+	glGenVertexArrays(1, &renderer.cubeVAO);
+	glGenBuffers(1, &VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, packedVertices.size() * sizeof(PackedVertex), &packedVertices[0], GL_STATIC_DRAW);
+	glBindVertexArray(renderer.cubeVAO);
+	// 位置、法线、纹理坐标属性
+	SetupPackedAttributes();
+	// 深度预渲染只取位置
+	glGenVertexArrays(1, &renderer.cubeDepthVAO);
+	glBindVertexArray(renderer.cubeDepthVAO);
+	SetupPackedPositionAttribute();
+	glBindVertexArray(0);
+	renderer.cubeBounds = cubeBounds;
+
+	// 贴图（运行目录下有 resources.pak 时先挂载，模型和贴图优先从资源包中读取）
+	TraceBegin("LoadTextures");
+	MountAssetPack("resources.pak", FileSystem::getPath(""));
+	renderer.diffuseMap  = LoadTexture(FileSystem::getPath("resources/textures/container2.png").c_str());
+	renderer.specularMap = LoadTexture(FileSystem::getPath("resources/textures/container2_specular.png").c_str());
+	glUseProgram(renderer.lightingProgram);
+	glUniform1i(glGetUniformLocation(renderer.lightingProgram, "material.diffuse"),  0);
+	glUniform1i(glGetUniformLocation(renderer.lightingProgram, "material.specular"), 1);
+	SetPackedBounds(renderer.lightingProgram, cubeBounds);
+	TraceEnd("LoadTextures");
+
+	// 模型（所有网格放在一个VBO/EBO中，按材质合批）
+	TraceBegin("LoadModel");
+	std::string modelPath = FileSystem::getPath("resources/objects/nanosuit/nanosuit.obj");
+	ModelData modelData;
+	if (!LoadPackedObj(modelPath, modelData))
+		LoadAssimp(modelPath, modelData);
+	ModelArena modelArena;
+	BuildArena(modelData, modelArena);
+	MergeRangesByMaterial(modelArena); // 静态合批：每个材质一次绘制
+	ArenaModel ourModel(modelArena, 0, true, true); // 压缩顶点 + 贴图数组
+	renderer.model = &ourModel;
+	renderer.modelMin = renderer.modelMax = modelArena.vertices.empty() ? glm::vec3(0.0f) : modelArena.vertices[0].Position;
+	for (const Vertex& vertex : modelArena.vertices)
+	{
+		renderer.modelMin = glm::min(renderer.modelMin, vertex.Position);
+		renderer.modelMax = glm::max(renderer.modelMax, vertex.Position);
+	}
+	TraceEnd("LoadModel");
+	TraceEnd("Startup");
+
+	// 7.0测试配置：先固定灯光数改变物体数，再固定物体数改变灯光数
+	std::vector<SceneConfig> configs;
+	GLuint objectCounts[] = { 100, 1000, 5000, 20000 };
+	GLuint lightCounts[]  = { 4, 16, 64, 256, 1024 };
+	for (GLuint n : objectCounts)
+	{
+		SceneConfig config = base;
+		config.objectCount = n;
+		config.pointLightCount = 16;
+		config.spotLightCount = 4;
+		config.modelCount = 4;
+		configs.push_back(config);
+	}
+	for (GLuint m : lightCounts)
+	{
+		SceneConfig config = base;
+		config.objectCount = 1000;
+		config.pointLightCount = m;
+		config.spotLightCount = 4;
+		config.modelCount = 4;
+		configs.push_back(config);
+	}
+
+	// 8.0逐个运行（每个配置分别关闭、打开深度预渲染和遮挡剔除），结果输出到控制台和 stress_results.csv
+	std::ofstream csv("stress_results.csv");
+	csv << "seed,distribution,objects,point_lights,spot_lights,models,depth_prepass,occlusion_culling,fps,draws_per_second,occluded,"
+		<< "scale,scale_stddev,scale_min,scale_max,scale_changes" << std::endl;
+	std::cout << "objects\tlights\tprepass\tculling\tfps\tdraws/s\toccluded\tscale\tstddev" << std::endl;
+	for (const SceneConfig& config : configs)
+	{
+		for (GLuint variant = 0; variant < 4; variant++)
+		{
+			if (glfwWindowShouldClose(window))
+				break;
+			GLuint prepass = variant & 1, culling = variant >> 1;
+			StressResult result = RunScene(window, renderer, config, prepass != 0, culling != 0);
+			csv << config.seed << ',' << config.distribution << ',' << config.objectCount << ','
+				<< config.pointLightCount << ',' << config.spotLightCount << ',' << config.modelCount << ',' << prepass << ','
+				<< culling << ',' << result.framesPerSecond << ',' << result.drawsPerSecond << ',' << result.occludedFraction << ','
+				<< result.resolution.meanScale << ',' << result.resolution.stddevScale << ',' << result.resolution.minScale << ','
+				<< result.resolution.maxScale << ',' << result.resolution.changes << std::endl;
+			std::cout << config.objectCount << '\t' << config.pointLightCount << '\t' << prepass << '\t' << culling << '\t'
+				<< result.framesPerSecond << '\t' << result.drawsPerSecond << '\t' << result.occludedFraction << '\t'
+				<< result.resolution.meanScale << '\t' << result.resolution.stddevScale << std::endl;
+		}
+	}
+
+	// 9.0释放资源
+	glDeleteVertexArrays(1, &renderer.cubeVAO);
+	glDeleteVertexArrays(1, &renderer.cubeDepthVAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteTextures(1, &renderer.diffuseMap);
+	glDeleteTextures(1, &renderer.specularMap);
+
+	StopTracing();
+	WriteChromeTrace("stress_trace.json");
+	glfwTerminate();
+	return 0;
+}
+
+// 载入贴图并生成多级渐远纹理
+GLuint LoadTexture(const char* path)
+{
+	// 通过 AssetFile 读取（资源包优先），mip 链由 glGenerateMipmap 生成
+	DecodedImage image;
+	DecodeImage(path, image);
+	GLuint texture = UploadTexture(image);
+	ReleaseImage(image);
+	return texture;
+}
+
+// 为物体挑选影响最大的聚光灯（范围内且在外切角以内），没有则返回 -1
+GLint AssignSpotLight(const std::vector<SpotLight>& spots, const std::vector<GLfloat>& ranges, const glm::vec3& center)
+{
+	GLint best = -1;
+	GLfloat bestScore = 0.0f;
+	for (GLuint i = 0; i < spots.size(); i++)
+	{
+		glm::vec3 toObject = center - spots[i].position;
+		GLfloat distance = glm::length(toObject);
+		if (distance > ranges[i])
+			continue;
+		// 物体中心正好在灯的位置时没有方向，视为在锥内
+		if (distance > 0.0f && glm::dot(toObject / distance, spots[i].direction) < spots[i].outerCutOff)
+			continue;
+		// 与 LightRange 使用同样的强度
+		GLfloat intensity = LightIntensity(spots[i].ambient, spots[i].diffuse, spots[i].specular);
+		GLfloat score = intensity / (spots[i].constant + spots[i].linear * distance + spots[i].quadratic * distance * distance);
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = GLint(i);
+		}
+	}
+	return best;
+}
+
+// 第 frame 帧的摄像机位置：绕场景匀速旋转（按帧数而不是时间，保证每次运行画面一致）
+glm::vec3 CameraEye(const SceneConfig& config, GLuint frame)
+{
+	GLfloat angle = frame * 0.01f;
+	return glm::vec3(std::sin(angle) * config.extent * 1.5f, config.extent * 0.3f, std::cos(angle) * config.extent * 1.5f);
+}
+
+// 运行一个场景配置，返回帧率和每秒绘制调用数
+StressResult RunScene(GLFWwindow* window, StressRenderer& renderer, const SceneConfig& config, bool depthPrepass, bool occlusionCulling)
+{
+	TraceBegin("GenerateScene");
+	GeneratedScene scene = GenerateScene(config);
+
+	// 场景放进实体世界：箱子（有 Transform，矩阵和包围球由 TransformSystems 并行算出）、
+	// 模型实例（只有矩阵）、点光源和聚光灯各是一个原型
+	EntityWorld world;
+	for (GLuint i = 0; i < scene.objectPositions.size(); i++)
+	{
+		const glm::vec4& rotation = scene.objectRotations[i];
+		Transform transform = { scene.objectPositions[i], 1.0f, glm::vec3(rotation), rotation.w };
+		MeshRef mesh = { MESH_CUBE, 0.87f }; // 单位立方体的包围球半径约0.87
+		MaterialRef material = { 0, 32.0f };
+		world.Create(transform, WorldMatrix(), Bounds(), mesh, material);
+	}
+	glm::vec3 modelCenter = (renderer.modelMin + renderer.modelMax) * 0.5f;
+	GLfloat modelRadius = glm::length(renderer.modelMax - renderer.modelMin) * 0.5f;
+	for (const glm::mat4& instance : scene.modelInstances)
+	{
+		WorldMatrix matrix = { instance };
+		// 包围球半径按实例矩阵的最大轴向缩放放大，实例缩放改变时剔除仍然正确
+		GLfloat scale = std::max(glm::length(glm::vec3(instance[0])), std::max(glm::length(glm::vec3(instance[1])), glm::length(glm::vec3(instance[2]))));
+		Bounds bounds = { glm::vec3(instance * glm::vec4(modelCenter, 1.0f)), modelRadius * scale };
+		MeshRef mesh = { MESH_MODEL, modelRadius };
+		world.Create(matrix, bounds, mesh);
+	}
+	for (const PointLight& light : scene.pointLights)
+		world.Create(light);
+	for (const SpotLight& light : scene.spotLights)
+		world.Create(light);
+	// 矩阵和包围球两个系统读写不冲突，由 RunSystems 放在同一阶段并行
+	RunSystems(world, TransformSystems(), 0);
+
+	// 箱子带材质，模型实例使用模型自带的材质（不带 MaterialRef）
+	const ComponentMask modelExclude = ComponentBit<MaterialRef>();
+
+	std::vector<PointLight> pointLights = CollectPointLights(world);
+	std::vector<SpotLight> spotLights = CollectSpotLights(world);
+	LightAssigner lightAssigner(MAX_OBJECT_LIGHTS);
+	lightAssigner.SetLights(pointLights);
+	std::vector<GLfloat> spotRanges;
+	for (const SpotLight& spot : spotLights)
+		spotRanges.push_back(LightRange(spot));
+
+	// 遮挡剔除：箱子既是遮挡体也是被测物体，模型实例只作为被测物体（排在箱子之后）
+	// 可见性按遍历顺序编号，绘制时用同样的遍历顺序取用；关闭遮挡剔除时全部可见
+	OcclusionCuller culler;
+	std::vector<OcclusionBox> cubeBoxes, testBoxes;
+	world.ForEachChunk<WorldMatrix, MaterialRef>([&](GLuint count, WorldMatrix* matrices, MaterialRef*)
+	{
+		for (GLuint i = 0; i < count; i++)
+		{
+			OcclusionBox box = { matrices[i].model, glm::vec3(-0.5f), glm::vec3(0.5f) };
+			cubeBoxes.push_back(box);
+		}
+	});
+	testBoxes = cubeBoxes;
+	world.ForEachChunk<WorldMatrix, MeshRef>([&](GLuint count, WorldMatrix* matrices, MeshRef*)
+	{
+		for (GLuint i = 0; i < count; i++)
+		{
+			OcclusionBox box = { matrices[i].model, renderer.modelMin, renderer.modelMax };
+			testBoxes.push_back(box);
+		}
+	}, modelExclude);
+	if (occlusionCulling)
+		culler.SetScene(cubeBoxes, testBoxes);
+	TraceEnd("GenerateScene");
+
+	GLuint program = renderer.lightingProgram;
+	GLint modelLoc  = glGetUniformLocation(program, "model");
+	GLint viewLoc   = glGetUniformLocation(program, "view");
+	GLint projLoc   = glGetUniformLocation(program, "projection");
+	GLint viewPosLoc = glGetUniformLocation(program, "viewPos");
+
+	glm::mat4 projection = glm::perspective(45.0f, (GLfloat)WIDTH / (GLfloat)HEIGHT, 0.1f, config.extent * 4.0f);
+
+	StressResult result;
+	result.config = config;
+	result.depthPrepass = depthPrepass;
+	result.occlusionCulling = occlusionCulling;
+	GLdouble draws = 0.0;
+	GLdouble occluded = 0.0;
+	GLdouble startTime = 0.0;
+	std::vector<unsigned char> visible(testBoxes.size(), 1);
+	if (occlusionCulling)
+		culler.Submit(projection * glm::lookAt(CameraEye(config, 0), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)), CameraEye(config, 0));
+	for (GLuint frame = 0; frame < WARMUP_FRAMES + TIMED_FRAMES; frame++)
+	{
+		if (frame == WARMUP_FRAMES)
+		{
+			glFinish();
+			startTime = glfwGetTime();
+			draws = 0.0;
+			occluded = 0.0;
+			if (renderer.dynamicResolution)
+				renderer.dynamicResolution->ResetStats();
+		}
+		TRACE_SCOPE("Frame");
+		glfwPollEvents();
+
+		glm::vec3 eye = CameraEye(config, frame);
+		glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		// 取本帧的可见性（上一帧提交），随即提交下一帧，后台线程在本帧渲染时计算
+		if (occlusionCulling)
+		{
+			visible = culler.Wait();
+			glm::vec3 nextEye = CameraEye(config, frame + 1);
+			culler.Submit(projection * glm::lookAt(nextEye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)), nextEye);
+		}
+
+		if (renderer.dynamicResolution)
+			renderer.dynamicResolution->Begin();
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// 深度预渲染：只画深度，之后的照明只着色最前面的片段
+		if (depthPrepass)
+		{
+			TraceBegin("DepthPrepass");
+			GLuint depthProgram = renderer.depthPrepass->Begin(PERM_PACKED_VERTICES);
+			GLint depthModelLoc = glGetUniformLocation(depthProgram, "model");
+			glUniformMatrix4fv(glGetUniformLocation(depthProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
+			glUniformMatrix4fv(glGetUniformLocation(depthProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+			SetPackedBounds(depthProgram, renderer.cubeBounds);
+			glBindVertexArray(renderer.cubeDepthVAO);
+			GLuint index = 0;
+			world.ForEachChunk<WorldMatrix, MaterialRef>([&](GLuint count, WorldMatrix* matrices, MaterialRef*)
+			{
+				for (GLuint i = 0; i < count; i++)
+				{
+					if (!visible[index++])
+						continue;
+					glUniformMatrix4fv(depthModelLoc, 1, GL_FALSE, glm::value_ptr(matrices[i].model));
+					glDrawArrays(GL_TRIANGLES, 0, 36);
+					draws += 1.0;
+				}
+			});
+			world.ForEachChunk<WorldMatrix, MeshRef>([&](GLuint count, WorldMatrix* matrices, MeshRef*)
+			{
+				for (GLuint i = 0; i < count; i++)
+				{
+					if (!visible[index++])
+						continue;
+					glUniformMatrix4fv(depthModelLoc, 1, GL_FALSE, glm::value_ptr(matrices[i].model));
+					renderer.model->DrawDepth(depthProgram);
+					draws += renderer.model->DrawCount();
+				}
+			}, modelExclude);
+			renderer.depthPrepass->BeginShading();
+			TraceEnd("DepthPrepass");
+		}
+
+		// 箱子
+		TraceBegin("Cubes");
+		glUseProgram(program);
+		glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+		glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+		glUniform3f(viewPosLoc, eye.x, eye.y, eye.z);
+		glUniform3f(glGetUniformLocation(program, "dirLight.direction"), -0.2f, -1.0f, -0.3f);
+		glUniform3f(glGetUniformLocation(program, "dirLight.ambient"), 0.05f, 0.05f, 0.05f);
+		glUniform3f(glGetUniformLocation(program, "dirLight.diffuse"), 0.4f, 0.4f, 0.4f);
+		glUniform3f(glGetUniformLocation(program, "dirLight.specular"), 0.5f, 0.5f, 0.5f);
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, renderer.diffuseMap);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, renderer.specularMap);
+
+		glBindVertexArray(renderer.cubeVAO);
+		GLint uploadedSpot = -2;
+		GLfloat uploadedShininess = -1.0f;
+		GLuint index = 0;
+		world.ForEachChunk<WorldMatrix, Bounds, MaterialRef>([&](GLuint count, WorldMatrix* matrices, Bounds* bounds, MaterialRef* materials)
+		{
+			for (GLuint i = 0; i < count; i++)
+			{
+				if (!visible[index++])
+				{
+					occluded += 1.0;
+					continue;
+				}
+				glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(matrices[i].model));
+				lightAssigner.Assign(bounds[i].center, bounds[i].radius);
+				lightAssigner.Upload(program);
+				if (materials[i].shininess != uploadedShininess)
+				{
+					glUniform1f(glGetUniformLocation(program, "material.shininess"), materials[i].shininess);
+					uploadedShininess = materials[i].shininess;
+				}
+
+				// 聚光灯只有一个槽位，只在变化时上传；没有聚光灯照到时上传关闭的聚光灯（全黑，参数有效）
+				GLint spot = AssignSpotLight(spotLights, spotRanges, bounds[i].center);
+				if (spot != uploadedSpot)
+				{
+					SpotLight light = (spot >= 0) ? spotLights[spot] : OffSpotLight();
+					glUniform3f(glGetUniformLocation(program, "spotLight.position"), light.position.x, light.position.y, light.position.z);
+					glUniform3f(glGetUniformLocation(program, "spotLight.direction"), light.direction.x, light.direction.y, light.direction.z);
+					glUniform3f(glGetUniformLocation(program, "spotLight.ambient"), light.ambient.x, light.ambient.y, light.ambient.z);
+					glUniform3f(glGetUniformLocation(program, "spotLight.diffuse"), light.diffuse.x, light.diffuse.y, light.diffuse.z);
+					glUniform3f(glGetUniformLocation(program, "spotLight.specular"), light.specular.x, light.specular.y, light.specular.z);
+					glUniform1f(glGetUniformLocation(program, "spotLight.constant"), light.constant);
+					glUniform1f(glGetUniformLocation(program, "spotLight.linear"), light.linear);
+					glUniform1f(glGetUniformLocation(program, "spotLight.quadratic"), light.quadratic);
+					glUniform1f(glGetUniformLocation(program, "spotLight.cutOff"), light.cutOff);
+					glUniform1f(glGetUniformLocation(program, "spotLight.outerCutOff"), light.outerCutOff);
+					uploadedSpot = spot;
+				}
+
+				glDrawArrays(GL_TRIANGLES, 0, 36);
+				draws += 1.0;
+			}
+		});
+		glBindVertexArray(0);
+		TraceEnd("Cubes");
+
+		// 模型实例
+		TraceBegin("Models");
+		GLuint modelProgram = renderer.modelProgram;
+		glUseProgram(modelProgram);
+		glUniformMatrix4fv(glGetUniformLocation(modelProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
+		glUniformMatrix4fv(glGetUniformLocation(modelProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+		GLint instanceModelLoc = glGetUniformLocation(modelProgram, "model");
+		world.ForEachChunk<WorldMatrix, MeshRef>([&](GLuint count, WorldMatrix* matrices, MeshRef*)
+		{
+			for (GLuint i = 0; i < count; i++)
+			{
+				if (!visible[index++])
+				{
+					occluded += 1.0;
+					continue;
+				}
+				glUniformMatrix4fv(instanceModelLoc, 1, GL_FALSE, glm::value_ptr(matrices[i].model));
+				renderer.model->Draw(modelProgram);
+				draws += renderer.model->DrawCount();
+			}
+		}, modelExclude);
+		if (depthPrepass)
+			renderer.depthPrepass->End();
+		TraceEnd("Models");
+
+		if (renderer.dynamicResolution)
+		{
+			TraceBegin("Upscale");
+			renderer.dynamicResolution->End();
+			TraceEnd("Upscale");
+		}
+
+		TraceBegin("SwapBuffers");
+		glfwSwapBuffers(window);
+		TraceEnd("SwapBuffers");
+	}
+	glFinish();
+
+	GLdouble seconds = glfwGetTime() - startTime;
+	result.framesPerSecond = TIMED_FRAMES / seconds;
+	result.drawsPerSecond = draws / seconds;
+	result.occludedFraction = occluded / (GLdouble(TIMED_FRAMES) * std::max<size_t>(testBoxes.size(), 1));
+	if (renderer.dynamicResolution)
+		result.resolution = renderer.dynamicResolution->Stats();
+	else
+	{
+		DynamicResolutionStats fixed = { TIMED_FRAMES, 0, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f };
+		result.resolution = fixed;
+	}
+	return result;
+}
@@ -0,0 +1,20 @@
+#version 330 core
+in vec2 TexCoords;
+
+out vec4 color;
+
+// 反馈：写出本像素需要的瓦片（x, y, 级别），alpha 为 1 表示有请求
+uniform vec2 virtualSize;
+uniform float tileSize;
+uniform float maxLevel;
+uniform float feedbackBias; // 反馈目标比输出小，导数大 FeedbackDivisor 倍
+
+void main()
+{
+	vec2 px = clamp(TexCoords, 0.0, 0.99999) * virtualSize;
+	vec2 dx = dFdx(px), dy = dFdy(px);
+	float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8)) + feedbackBias;
+	int level = int(clamp(floor(lod), 0.0, maxLevel));
+	vec2 tile = floor(px / (tileSize * exp2(float(level))));
+	color = vec4(tile, float(level), 255.0) / 255.0;
+}
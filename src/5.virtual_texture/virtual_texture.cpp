@@ -0,0 +1,232 @@
+// 流处理
+#include <iostream>
+#include <string>
+
+// GLEW
+// GLEW 能自动识别你的平台所支持的全部OpenGL高级扩展涵数
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// GLFW
+// OpenGL 窗口管理、分辨率切换、键盘、鼠标以及游戏手柄、定时器输入、线程创建等等。
+#include <GLFW/glfw3.h>
+
+// GLM 数学库
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Other includes
+#include <learnopengl/shader.h>
+#include <learnopengl/filesystem.h>
+#include <learnopengl/Camera.h>
+#include <learnopengl/virtual_texture.h>
+
+// 函数原型
+// 键盘输入回调函数
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
+// 鼠标输入回调函数
+void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+// 鼠标滚动回调函数
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+// 输入处理函数
+void do_movement();
+// 设置矩阵 uniform
+void set_matrices(const Shader& shader, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection);
+
+// 窗口尺寸
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+// 摄影机：从地面上方斜看，远处只需要粗的级别
+Camera camera(glm::vec3(0.0f, 2.0f, 0.0f));
+GLfloat lastX = WIDTH  / 2.0;
+GLfloat lastY = HEIGHT / 2.0;
+bool keys[1024];
+
+// 帧耗时
+GLfloat deltaTime = 0.0f; // 当前帧到上一帧所耗时间
+GLfloat lastFrame = 0.0f; // 上一帧
+
+// 参数：virtual_texture [图片路径]，不指定时使用 container2.png
+int main(int argc, char** argv) {
+	std::string imagePath = (argc > 1) ? std::string(argv[1]) : FileSystem::getPath("resources/textures/container2.png");
+
+	// 1.0初始化GLFW
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+
+	// 2.0创建窗口对象
+	GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "LearnOpenGL", nullptr, nullptr);
+	glfwMakeContextCurrent(window);
+
+	// 注册回调函数
+	glfwSetKeyCallback(window, key_callback);
+	glfwSetCursorPosCallback(window, mouse_callback);
+	glfwSetScrollCallback(window, scroll_callback);
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// 3.0初始化GLEW
+	glewExperimental = GL_TRUE;
+	glewInit();
+
+	// 4.0视口配置
+	glViewport(0, 0, WIDTH, HEIGHT);
+	glEnable(GL_DEPTH_TEST);
+
+	// 5.0着色器：反馈与采样共用顶点着色器
+	Shader textureShader("virtual_texture.vs", "virtual_texture.frag");
+	Shader feedbackShader("virtual_texture.vs", "virtual_feedback.frag");
+
+	// 6.0虚拟纹理：第一次运行（或图片改变后）烘焙成运行目录下的 virtual_texture.vtex
+	VirtualTextureFile textureFile;
+	if(!OpenVirtualTexture(imagePath, "virtual_texture.vtex", textureFile))
+	{
+		glfwTerminate();
+		return -1;
+	}
+	// 8x8 个槽位的物理缓存、32MB 的 CPU 瓦片缓存，与图片的尺寸无关
+	VirtualTexture virtualTexture(textureFile, WIDTH, HEIGHT, 8, 32u << 20);
+
+	// 7.0地面：一个很大的四边形，纹理坐标 0~1 覆盖整张虚拟纹理
+	GLfloat vertices[] = {
+		// Positions            // Normals          // Texture Coords
+		-50.0f, 0.0f, -50.0f,  0.0f, 1.0f, 0.0f,  0.0f, 0.0f,
+		 50.0f, 0.0f, -50.0f,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f,
+		 50.0f, 0.0f,  50.0f,  0.0f, 1.0f, 0.0f,  1.0f, 1.0f,
+		 50.0f, 0.0f,  50.0f,  0.0f, 1.0f, 0.0f,  1.0f, 1.0f,
+		-50.0f, 0.0f,  50.0f,  0.0f, 1.0f, 0.0f,  0.0f, 1.0f,
+		-50.0f, 0.0f, -50.0f,  0.0f, 1.0f, 0.0f,  0.0f, 0.0f
+	};
+	GLuint VBO, planeVAO;
+	glGenVertexArrays(1, &planeVAO);
+	glGenBuffers(1, &VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindVertexArray(planeVAO);
+	// 位置属性
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	// 纹理坐标属性
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(6 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
+
+	glm::mat4 model;
+	glm::mat4 projection = glm::perspective(45.0f, (GLfloat)WIDTH / (GLfloat)HEIGHT, 0.1f, 200.0f);
+
+	// 8.0主循环
+	while (!glfwWindowShouldClose(window))
+	{
+		GLfloat currentFrame = glfwGetTime();
+		deltaTime = currentFrame - lastFrame;
+		lastFrame = currentFrame;
+
+		glfwPollEvents();
+		do_movement();
+		glm::mat4 view = camera.GetViewMatrix();
+
+		// 8.1处理较早的反馈，载入缺少的瓦片（每帧有上限），更新页表
+		virtualTexture.Update();
+
+		// 8.2反馈：在小的离屏目标上画一遍，记录需要的瓦片
+		virtualTexture.BeginFeedback();
+		feedbackShader.Use();
+		virtualTexture.SetUniforms(feedbackShader.Program, 0, 1);
+		set_matrices(feedbackShader, model, view, projection);
+		glBindVertexArray(planeVAO);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		virtualTexture.EndFeedback();
+
+		// 8.3正常渲染：通过页表从物理缓存中取样
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		textureShader.Use();
+		virtualTexture.SetUniforms(textureShader.Program, 0, 1);
+		set_matrices(textureShader, model, view, projection);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		glBindVertexArray(0);
+
+		glfwSwapBuffers(window);
+	}
+
+	// 9.0统计：显存占用与整张贴图（含 mip）比较
+	const VirtualTextureHeader& header = textureFile.Header();
+	size_t fullBytes = size_t(header.width) * header.height * 3 * 4 / 3;
+	std::cout << "virtual texture " << header.width << "x" << header.height << ", " << header.levels << " levels, "
+	          << header.tileCount << " tiles" << std::endl;
+	std::cout << "gpu bytes " << virtualTexture.GpuBytes() << " (full texture " << fullBytes << ")" << std::endl;
+	std::cout << "resident " << virtualTexture.ResidentTiles() << ", uploads " << virtualTexture.Uploads()
+	          << ", evictions " << virtualTexture.Evictions() << std::endl;
+	std::cout << "cpu cache " << virtualTexture.CpuCache().Bytes() << " bytes, hits " << virtualTexture.CpuCache().Hits()
+	          << ", misses " << virtualTexture.CpuCache().Misses() << std::endl;
+
+	// 10.0释放资源
+	glDeleteVertexArrays(1, &planeVAO);
+	glDeleteBuffers(1, &VBO);
+	glfwTerminate();
+	return 0;
+}
+
+void set_matrices(const Shader& shader, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection)
+{
+	glUniformMatrix4fv(glGetUniformLocation(shader.Program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+	glUniformMatrix4fv(glGetUniformLocation(shader.Program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+	glUniformMatrix4fv(glGetUniformLocation(shader.Program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+}
+
+// 输入回调函数实现
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode) {
+	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+		glfwSetWindowShouldClose(window, GL_TRUE);
+
+	if (key >= 0 && key < 1024)
+	{
+		if (action == GLFW_PRESS)
+			keys[key] = true;
+		else if (action == GLFW_RELEASE)
+			keys[key] = false;
+	}
+}
+
+// 键位状态处理
+void do_movement()
+{
+	if (keys[GLFW_KEY_W])
+		camera.ProcessKeyboard(FORWARD, deltaTime);
+	if (keys[GLFW_KEY_S])
+		camera.ProcessKeyboard(BACKWARD, deltaTime);
+	if (keys[GLFW_KEY_A])
+		camera.ProcessKeyboard(LEFT, deltaTime);
+	if (keys[GLFW_KEY_D])
+		camera.ProcessKeyboard(RIGHT, deltaTime);
+}
+
+bool firstMouse = true;
+void mouse_callback(GLFWwindow* window, double xpos, double ypos)
+{
+	if (firstMouse)
+	{
+		lastX = xpos;
+		lastY = ypos;
+		firstMouse = false;
+	}
+
+	GLfloat xoffset = xpos - lastX;
+	GLfloat yoffset = lastY - ypos;
+	lastX = xpos;
+	lastY = ypos;
+
+	GLfloat sensitivity = 0.05; // 鼠标灵敏度
+	xoffset *= sensitivity;
+	yoffset *= sensitivity;
+
+	camera.ProcessMouseMovement(xoffset, yoffset);
+}
+
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+	camera.ProcessMouseScroll(yoffset);
+}
@@ -0,0 +1,31 @@
+#version 330 core
+in vec2 TexCoords;
+
+out vec4 color;
+
+// 虚拟纹理（见 virtual_texture.h）
+uniform sampler2D pageTable;     // 每级一层 mip，每个瓦片一个像素：槽位 x、y、驻留的级别
+uniform sampler2D physicalCache; // 驻留的瓦片，每块四周带 tileBorder 像素的边
+uniform vec2 virtualSize;        // 第 0 级的尺寸（像素）
+uniform float tileSize;
+uniform float tileBorder;
+uniform float physicalSize;
+uniform float maxLevel;
+
+void main()
+{
+	// 1. 按虚拟像素坐标的导数选级别（与 virtual_feedback.frag 相同）
+	vec2 px = clamp(TexCoords, 0.0, 0.99999) * virtualSize;
+	vec2 dx = dFdx(px), dy = dFdy(px);
+	float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8));
+	int level = int(clamp(floor(lod), 0.0, maxLevel));
+
+	// 2. 查页表：没有驻留时条目指向最近的驻留祖先，按它的级别换算瓦片内的坐标
+	ivec2 tile = ivec2(px / (tileSize * exp2(float(level))));
+	vec3 entry = texelFetch(pageTable, tile, level).rgb * 255.0;
+	vec2 inTile = mod(px / exp2(entry.b), tileSize);
+
+	// 3. 物理缓存中的坐标（跳过边），单级双线性
+	vec2 physical = (entry.rg * (tileSize + 2.0 * tileBorder) + tileBorder + inTile) / physicalSize;
+	color = vec4(textureLod(physicalCache, physical, 0.0).rgb, 1.0f);
+}
@@ -0,0 +1,15 @@
+#version 330 core
+layout (location = 0) in vec3 position;  // 数据位0 顶点位置
+layout (location = 2) in vec2 texCoords; // 数据位2 纹理坐标
+
+out vec2 TexCoords;
+
+uniform mat4 model;      // 模型矩阵
+uniform mat4 view;       // 视图矩阵
+uniform mat4 projection; // 投影矩阵
+
+void main()
+{
+	gl_Position = projection * view * model * vec4(position, 1.0f);
+	TexCoords = texCoords;
+}
@@ -0,0 +1,513 @@
+// CPU 热点路径的微基准测试（Google Benchmark）
+// 默认把结果同时写入 bench_results.json，便于长期跟踪性能趋势。
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+
+// GLEW
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Assimp
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+// Other Libs
+#include <SOIL.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Other includes
+#include <learnopengl/shader.h>
+#include <learnopengl/camera.h>
+#include <learnopengl/mesh.h>
+#include <learnopengl/filesystem.h>
+#include <learnopengl/shader_permutation.h>
+#include <learnopengl/light_assignment.h>
+#include <learnopengl/mipmap.h>
+#include <learnopengl/image_decoder.h>
+#include <learnopengl/entity_world.h>
+#include <learnopengl/animation.h>
+
+// 着色器相对本目录的路径
+#define LIGHTING_VS  "../2.Lighting/6.Multiple_lights/multiple_lights.vs"
+#define PHONG_FS     "../2.Lighting/6.Multiple_lights/multiple_lights.frag"
+
+#pragma region "Helpers"
+
+// 着色器相关的测试需要一个 OpenGL 上下文，使用隐藏窗口
+static bool EnsureContext()
+{
+    static GLFWwindow* window = nullptr;
+    if(window)
+        return true;
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    window = glfwCreateWindow(64, 64, "benchmark", nullptr, nullptr);
+    if(!window)
+        return false;
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    glewInit();
+    return true;
+}
+
+// 与 Model::processMesh 相同的方式把 aiMesh 转成顶点和索引
+static void ConvertScene(const aiScene* scene, std::vector<std::vector<Vertex> >& vertices, std::vector<std::vector<GLuint> >& indices)
+{
+    vertices.resize(scene->mNumMeshes);
+    indices.resize(scene->mNumMeshes);
+    for(GLuint m = 0; m < scene->mNumMeshes; m++)
+    {
+        const aiMesh* mesh = scene->mMeshes[m];
+        vertices[m].clear();
+        indices[m].clear();
+        for(GLuint i = 0; i < mesh->mNumVertices; i++)
+        {
+            Vertex vertex;
+            vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+            vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+            if(mesh->mTextureCoords[0])
+                vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+            else
+                vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+            vertices[m].push_back(vertex);
+        }
+        for(GLuint i = 0; i < mesh->mNumFaces; i++)
+        {
+            const aiFace& face = mesh->mFaces[i];
+            for(GLuint j = 0; j < face.mNumIndices; j++)
+                indices[m].push_back(face.mIndices[j]);
+        }
+    }
+}
+
+// 简单的网格缓存文件：网格数，然后每个网格的顶点数、索引数和原始数据
+static std::string WriteMeshCache(const std::vector<std::vector<Vertex> >& vertices, const std::vector<std::vector<GLuint> >& indices)
+{
+    std::string path = "nanosuit.meshcache";
+    std::ofstream file(path.c_str(), std::ios::binary);
+    GLuint count = GLuint(vertices.size());
+    file.write((const char*)&count, sizeof(count));
+    for(GLuint m = 0; m < count; m++)
+    {
+        GLuint vertexCount = GLuint(vertices[m].size()), indexCount = GLuint(indices[m].size());
+        file.write((const char*)&vertexCount, sizeof(vertexCount));
+        file.write((const char*)&indexCount, sizeof(indexCount));
+        file.write((const char*)vertices[m].data(), vertexCount * sizeof(Vertex));
+        file.write((const char*)indices[m].data(), indexCount * sizeof(GLuint));
+    }
+    return path;
+}
+
+static size_t ReadMeshCache(const std::string& path, std::vector<std::vector<Vertex> >& vertices, std::vector<std::vector<GLuint> >& indices)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    GLuint count = 0;
+    size_t bytes = 0;
+    file.read((char*)&count, sizeof(count));
+    vertices.resize(count);
+    indices.resize(count);
+    for(GLuint m = 0; m < count; m++)
+    {
+        GLuint vertexCount, indexCount;
+        file.read((char*)&vertexCount, sizeof(vertexCount));
+        file.read((char*)&indexCount, sizeof(indexCount));
+        vertices[m].resize(vertexCount);
+        indices[m].resize(indexCount);
+        file.read((char*)vertices[m].data(), vertexCount * sizeof(Vertex));
+        file.read((char*)indices[m].data(), indexCount * sizeof(GLuint));
+        bytes += vertexCount * sizeof(Vertex) + indexCount * sizeof(GLuint);
+    }
+    return bytes;
+}
+
+#pragma endregion
+
+#pragma region "Camera"
+
+static void BM_CameraGetViewMatrix(benchmark::State& state)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+    for(auto _ : state)
+    {
+        glm::mat4 view = camera.GetViewMatrix();
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_CameraGetViewMatrix);
+
+static void BM_CameraProcessMouseMovement(benchmark::State& state)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+    GLfloat offset = 0.5f;
+    for(auto _ : state)
+    {
+        camera.ProcessMouseMovement(offset, -offset);
+        offset = -offset; // 来回晃动，避免俯仰角一直被限制在边界上
+        benchmark::DoNotOptimize(camera.Front);
+    }
+}
+BENCHMARK(BM_CameraProcessMouseMovement);
+
+#pragma endregion
+
+#pragma region "Model matrices"
+
+// 与箱子循环相同：平移 + 按下标旋转
+static void BM_CubeModelMatrices(benchmark::State& state)
+{
+    std::vector<glm::vec3> positions(state.range(0));
+    for(size_t i = 0; i < positions.size(); i++)
+        positions[i] = glm::vec3(GLfloat(i % 7) - 3.0f, GLfloat(i % 5) - 2.0f, -GLfloat(i % 11));
+    std::vector<glm::mat4> models(positions.size());
+    for(auto _ : state)
+    {
+        for(GLuint i = 0; i < positions.size(); i++)
+        {
+            glm::mat4 model;
+            model = glm::translate(model, positions[i]);
+            model = glm::rotate(model, 20.0f * i, glm::vec3(1.0f, 0.3f, 0.5f));
+            models[i] = model;
+        }
+        benchmark::DoNotOptimize(models.data());
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_CubeModelMatrices)->Arg(10)->Arg(1000)->Arg(100000);
+
+// 同样的计算放在实体世界中：旋转系统 + 变换系统按块遍历（参数：实体数、线程数）
+static void BM_EntityTransformSystems(benchmark::State& state)
+{
+    EntityWorld world;
+    for(GLuint i = 0; i < GLuint(state.range(0)); i++)
+    {
+        Transform transform = { glm::vec3(GLfloat(i % 7) - 3.0f, GLfloat(i % 5) - 2.0f, -GLfloat(i % 11)), 1.0f,
+                                glm::vec3(1.0f, 0.3f, 0.5f), 20.0f * i };
+        MeshRef mesh = { 0, 0.87f };
+        Spin spin = { 1.0f };
+        world.Create(transform, WorldMatrix(), Bounds(), mesh, spin);
+    }
+    GLuint threads = GLuint(state.range(1));
+    for(auto _ : state)
+    {
+        SpinSystem(world, 0.016f, threads);
+        TransformSystem(world, threads);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EntityTransformSystems)->Args({1000, 1})->Args({100000, 1})->Args({100000, 4})->UseRealTime();
+
+// 同样的三个系统交给 RunSystems 调度：旋转一个阶段，矩阵和包围球在同一阶段并行，各分一半线程
+static void BM_EntityRunSystems(benchmark::State& state)
+{
+    EntityWorld world;
+    for(GLuint i = 0; i < GLuint(state.range(0)); i++)
+    {
+        Transform transform = { glm::vec3(GLfloat(i % 7) - 3.0f, GLfloat(i % 5) - 2.0f, -GLfloat(i % 11)), 1.0f,
+                                glm::vec3(1.0f, 0.3f, 0.5f), 20.0f * i };
+        MeshRef mesh = { 0, 0.87f };
+        Spin spin = { 1.0f };
+        world.Create(transform, WorldMatrix(), Bounds(), mesh, spin);
+    }
+    std::vector<EntitySystem> systems = TransformSystems(true, 0.016f);
+    GLuint threads = GLuint(state.range(1));
+    for(auto _ : state)
+    {
+        RunSystems(world, systems, threads);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EntityRunSystems)->Args({100000, 1})->Args({100000, 4})->UseRealTime();
+
+// 动画：一半正弦通道、一半循环的关键帧通道，每次迭代前进一帧
+static void BM_AnimatorUpdate(benchmark::State& state)
+{
+    std::vector<GLfloat> targets(state.range(0));
+    std::vector<Keyframe> keys = { { 0.0f, 0.0f }, { 1.0f, 1.0f }, { 3.0f, -1.0f }, { 4.0f, 0.0f } };
+    Animator animator;
+    for(size_t i = 0; i < targets.size(); i++)
+    {
+        GLuint property = animator.AddProperty(targets[i]);
+        if(i % 2)
+            animator.AddProcedural(property, 0, WAVE_SINE, 1.0f, 0.5f + i * 1e-5f);
+        else
+            animator.AddKeyframes(property, 0, keys, WRAP_LOOP);
+    }
+    GLuint frame = 0;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(animator.Update(frame++ * 0.016f));
+    state.SetItemsProcessed(state.iterations() * targets.size());
+}
+BENCHMARK(BM_AnimatorUpdate)->Arg(1000)->Arg(100000);
+
+#pragma endregion
+
+#pragma region "Mesh loading"
+
+// 用 Assimp 载入 nanosuit.obj（与 Model 相同的后处理选项，不含 GL 上传）
+static void BM_AssimpLoadNanosuit(benchmark::State& state)
+{
+    std::string path = FileSystem::getPath("resources/objects/nanosuit/nanosuit.obj");
+    std::vector<std::vector<Vertex> > vertices;
+    std::vector<std::vector<GLuint> > indices;
+    for(auto _ : state)
+    {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+        if(!scene)
+        {
+            state.SkipWithError(importer.GetErrorString());
+            break;
+        }
+        ConvertScene(scene, vertices, indices);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+}
+BENCHMARK(BM_AssimpLoadNanosuit)->Unit(benchmark::kMillisecond);
+
+// 读取预先转换好的二进制网格缓存
+static void BM_CachedMeshLoadNanosuit(benchmark::State& state)
+{
+    std::vector<std::vector<Vertex> > vertices;
+    std::vector<std::vector<GLuint> > indices;
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(FileSystem::getPath("resources/objects/nanosuit/nanosuit.obj"), aiProcess_Triangulate | aiProcess_FlipUVs);
+    if(!scene)
+    {
+        state.SkipWithError(importer.GetErrorString());
+        return;
+    }
+    ConvertScene(scene, vertices, indices);
+    std::string cache = WriteMeshCache(vertices, indices);
+
+    size_t bytes = 0;
+    for(auto _ : state)
+    {
+        bytes += ReadMeshCache(cache, vertices, indices);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetBytesProcessed(bytes);
+    std::remove(cache.c_str());
+}
+BENCHMARK(BM_CachedMeshLoadNanosuit)->Unit(benchmark::kMillisecond);
+
+#pragma endregion
+
+#pragma region "Image decode"
+
+static void BM_SoilLoadContainer2(benchmark::State& state)
+{
+    std::string path = FileSystem::getPath("resources/textures/container2.png");
+    size_t bytes = 0;
+    for(auto _ : state)
+    {
+        int width, height;
+        unsigned char* image = SOIL_load_image(path.c_str(), &width, &height, 0, SOIL_LOAD_RGB);
+        if(!image)
+        {
+            state.SkipWithError("SOIL_load_image failed");
+            break;
+        }
+        bytes += size_t(width) * height * 3;
+        SOIL_free_image_data(image);
+    }
+    state.SetBytesProcessed(bytes); // 解码后的字节数
+}
+BENCHMARK(BM_SoilLoadContainer2)->Unit(benchmark::kMillisecond);
+
+// 同一张图片走 image_decoder.h（libdeflate + 缓冲池），与上面的 SOIL 对比 MB/s
+static void BM_FastDecodeContainer2(benchmark::State& state)
+{
+    std::string path = FileSystem::getPath("resources/textures/container2.png");
+    size_t bytes = 0;
+    for(auto _ : state)
+    {
+        std::vector<unsigned char> pixels;
+        GLint width, height;
+        if(!DecodeImageFile(path, pixels, width, height))
+        {
+            state.SkipWithError("DecodeImageFile failed");
+            break;
+        }
+        bytes += size_t(width) * height * 3;
+        ImagePool().Release(std::move(pixels));
+    }
+    state.SetBytesProcessed(bytes); // 解码后的字节数
+}
+BENCHMARK(BM_FastDecodeContainer2)->Unit(benchmark::kMillisecond);
+
+// CPU 生成整条 mip 链（参数为滤波器），单线程，与解码任务中的用法相同
+static void BM_MipChainContainer2(benchmark::State& state)
+{
+    std::string path = FileSystem::getPath("resources/textures/container2.png");
+    int width, height;
+    unsigned char* image = SOIL_load_image(path.c_str(), &width, &height, 0, SOIL_LOAD_RGB);
+    if(!image)
+    {
+        state.SkipWithError("SOIL_load_image failed");
+        return;
+    }
+    for(auto _ : state)
+        benchmark::DoNotOptimize(GenerateMipChain(image, width, height, 3, MipFilter(state.range(0))));
+    state.SetBytesProcessed(state.iterations() * size_t(width) * height * 3);
+    SOIL_free_image_data(image);
+}
+BENCHMARK(BM_MipChainContainer2)->Arg(MIP_BOX)->Arg(MIP_LANCZOS3)->Arg(MIP_KAISER)->Unit(benchmark::kMillisecond);
+
+#pragma endregion
+
+#pragma region "Shaders"
+
+// 从文件读取并编译链接一个着色器程序
+static void BM_ShaderConstruction(benchmark::State& state)
+{
+    if(!EnsureContext())
+    {
+        state.SkipWithError("no OpenGL context");
+        return;
+    }
+    for(auto _ : state)
+    {
+        Shader shader(LIGHTING_VS, PHONG_FS);
+        glDeleteProgram(shader.Program);
+    }
+}
+BENCHMARK(BM_ShaderConstruction)->Unit(benchmark::kMillisecond);
+
+// 变体缓存命中的开销
+static void BM_ShaderPermutationCachedGet(benchmark::State& state)
+{
+    if(!EnsureContext())
+    {
+        state.SkipWithError("no OpenGL context");
+        return;
+    }
+    ShaderPermutation permutations(LIGHTING_VS, PHONG_FS);
+    GLuint key = PermutationKey(PERM_DIR_LIGHT | PERM_SPOT_LIGHT | PERM_SPECULAR_MAP, 4);
+    permutations.Get(key);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(permutations.Get(key));
+}
+BENCHMARK(BM_ShaderPermutationCachedGet);
+
+// 示例中的写法：每次上传前都用名字查询 uniform 地址
+static void BM_UniformUploadByName(benchmark::State& state)
+{
+    if(!EnsureContext())
+    {
+        state.SkipWithError("no OpenGL context");
+        return;
+    }
+    Shader shader(LIGHTING_VS, PHONG_FS);
+    shader.Use();
+    glm::mat4 model;
+    for(auto _ : state)
+    {
+        glUniformMatrix4fv(glGetUniformLocation(shader.Program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform3f(glGetUniformLocation(shader.Program, "pointLights[0].position"), 1.2f, 1.0f, 2.0f);
+        glUniform3f(glGetUniformLocation(shader.Program, "pointLights[0].diffuse"), 0.5f, 0.5f, 0.5f);
+        glUniform1f(glGetUniformLocation(shader.Program, "material.shininess"), 32.0f);
+    }
+    glDeleteProgram(shader.Program);
+}
+BENCHMARK(BM_UniformUploadByName);
+
+// 预先缓存 uniform 地址
+static void BM_UniformUploadCached(benchmark::State& state)
+{
+    if(!EnsureContext())
+    {
+        state.SkipWithError("no OpenGL context");
+        return;
+    }
+    Shader shader(LIGHTING_VS, PHONG_FS);
+    shader.Use();
+    GLint modelLoc     = glGetUniformLocation(shader.Program, "model");
+    GLint positionLoc  = glGetUniformLocation(shader.Program, "pointLights[0].position");
+    GLint diffuseLoc   = glGetUniformLocation(shader.Program, "pointLights[0].diffuse");
+    GLint shininessLoc = glGetUniformLocation(shader.Program, "material.shininess");
+    glm::mat4 model;
+    for(auto _ : state)
+    {
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        glUniform3f(positionLoc, 1.2f, 1.0f, 2.0f);
+        glUniform3f(diffuseLoc, 0.5f, 0.5f, 0.5f);
+        glUniform1f(shininessLoc, 32.0f);
+    }
+    glDeleteProgram(shader.Program);
+}
+BENCHMARK(BM_UniformUploadCached);
+
+// 按物体分配并上传点光源列表（场景灯光数量由参数给出）
+static void BM_LightAssignAndUpload(benchmark::State& state)
+{
+    if(!EnsureContext())
+    {
+        state.SkipWithError("no OpenGL context");
+        return;
+    }
+    ShaderPermutation permutations(LIGHTING_VS, PHONG_FS);
+    GLuint program = permutations.Use(PermutationKey(PERM_DIR_LIGHT | PERM_SPECULAR_MAP | PERM_LIGHT_LIST, 4));
+
+    std::vector<PointLight> lights(state.range(0));
+    for(size_t i = 0; i < lights.size(); i++)
+    {
+        PointLight& light = lights[i];
+        light.position  = glm::vec3(GLfloat(i % 13) - 6.0f, GLfloat(i % 3), -GLfloat(i % 17));
+        light.ambient   = glm::vec3(0.05f);
+        light.diffuse   = glm::vec3(0.8f);
+        light.specular  = glm::vec3(1.0f);
+        light.constant  = 1.0f;
+        light.linear    = 0.35f;
+        light.quadratic = 0.44f;
+    }
+    LightAssigner assigner(4);
+    assigner.SetLights(lights);
+    for(auto _ : state)
+    {
+        assigner.Assign(glm::vec3(0.0f, 1.0f, -5.0f), 0.87f);
+        assigner.Upload(program);
+    }
+}
+BENCHMARK(BM_LightAssignAndUpload)->Arg(4)->Arg(64)->Arg(1024);
+
+#pragma endregion
+
+// 没有指定 --benchmark_out 时默认输出 JSON 文件
+int main(int argc, char** argv)
+{
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOut = false;
+    for(int i = 1; i < argc; i++)
+        if(std::string(argv[i]).compare(0, 16, "--benchmark_out=") == 0)
+            hasOut = true;
+    char outArg[] = "--benchmark_out=bench_results.json";
+    char formatArg[] = "--benchmark_out_format=json";
+    if(!hasOut)
+    {
+        args.push_back(outArg);
+        args.push_back(formatArg);
+    }
+    int count = int(args.size());
+    benchmark::Initialize(&count, args.data());
+    if(benchmark::ReportUnrecognizedArguments(count, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    glfwTerminate();
+    return 0;
+}
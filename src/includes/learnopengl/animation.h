@@ -0,0 +1,275 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/simd.h>
+
+// == ======================================
+// 动画
+// 随时间变化的值原本直接写在主循环里（如 lightColor.x = sin(glfwGetTime() * 2.0f)），每帧无条件重算、重新上传。
+// 1. 属性：绑定到外部的若干个连续 float（灯光颜色、材质参数、位置、角度……），整体标记脏；
+// 2. 通道：驱动属性的一个分量，分两类，各自按 SoA 存放：
+//    程序化通道  offset + amplitude * wave(frequency * t + phase)，wave 为正弦或线性（匀速旋转、平移）；
+//    关键帧通道  在关键帧之间线性插值，循环或停在两端；
+// 3. Update 每帧先逐个通道找关键帧区间（缓存上次的位置，通常不用移动），
+//    然后用 simd.h 的 Float4 每次计算 4 个通道（多项式正弦、插值），没有分支；
+// 4. 新值与上一帧相同的分量不写回，只有确实改变了的属性标记为脏，案例只重新上传脏属性。
+// 绑定的 float 在 Animator 的生命周期内不能移动（不要绑定到会重新分配的 vector 元素）。
+// == ======================================
+
+// 程序化通道的波形
+enum AnimationWave
+{
+    WAVE_SINE,  // offset + amplitude * sin(frequency * t + phase)
+    WAVE_LINEAR // offset + amplitude * (frequency * t + phase)
+};
+
+// 关键帧通道的两端
+enum AnimationWrap
+{
+    WRAP_CLAMP, // 停在第一帧/最后一帧
+    WRAP_LOOP   // 从头循环
+};
+
+struct Keyframe
+{
+    GLfloat time;  // 秒，递增
+    GLfloat value;
+};
+
+// 4 路的正弦近似（|x| < 1000 时误差在 1e-4 以内）
+inline Float4 FastSin(Float4 x)
+{
+    // 减到 [-π, π]，再利用 sin(a) = sin(π - a) 折到 [0, π/2]
+    Float4 zero = Float4Set(0.0f);
+    Float4 turns = x * Float4Set(0.15915494f);
+    Float4 k = Float4Truncate(turns + Float4Select(Float4GreaterEqual(turns, zero), Float4Set(0.5f), Float4Set(-0.5f)));
+    Float4 r = x - k * Float4Set(6.2831853f);
+    Float4 a = Float4Abs(r);
+    a = Float4Min(a, Float4Set(3.14159265f) - a);
+    Float4 a2 = a * a;
+    Float4 p = Float4Set(2.7557319e-6f);
+    p = Float4Set(-1.9841270e-4f) + a2 * p;
+    p = Float4Set(8.3333333e-3f) + a2 * p;
+    p = Float4Set(-1.6666667e-1f) + a2 * p;
+    p = a * (Float4Set(1.0f) + a2 * p);
+    return Float4Select(Float4Less(r, zero), zero - p, p);
+}
+
+class Animator
+{
+public:
+    Animator() { }
+
+    // 绑定一个属性：target 起的 components 个 float，返回属性编号
+    GLuint AddProperty(GLfloat* target, GLuint components)
+    {
+        Property property = { target, GLuint(this->values.size()), components };
+        this->properties.push_back(property);
+        // 初始为 NaN，第一次 Update 时被通道驱动的分量一定写回、标记为脏
+        this->values.insert(this->values.end(), components, std::numeric_limits<GLfloat>::quiet_NaN());
+        this->dirty.push_back(0);
+        return GLuint(this->properties.size() - 1);
+    }
+
+    GLuint AddProperty(GLfloat& value)   { return this->AddProperty(&value, 1); }
+    GLuint AddProperty(glm::vec3& value) { return this->AddProperty(&value.x, 3); }
+
+    // 程序化通道，驱动属性的第 component 个分量（分量不存在时不添加，返回 false）
+    bool AddProcedural(GLuint property, GLuint component, AnimationWave wave,
+                       GLfloat amplitude, GLfloat frequency, GLfloat phase = 0.0f, GLfloat offset = 0.0f)
+    {
+        GLuint index;
+        if(!this->slot(property, component, index))
+            return false;
+        this->procSlot.push_back(index);
+        this->procSine.push_back(wave == WAVE_SINE ? 1.0f : 0.0f);
+        this->procAmplitude.push_back(amplitude);
+        this->procFrequency.push_back(frequency);
+        this->procPhase.push_back(phase);
+        this->procOffset.push_back(offset);
+        this->procValue.push_back(0.0f);
+        return true;
+    }
+
+    // 关键帧通道（至少一帧，时间递增），没有关键帧或分量不存在时不添加，返回 false
+    bool AddKeyframes(GLuint property, GLuint component, const std::vector<Keyframe>& keys, AnimationWrap wrap = WRAP_CLAMP)
+    {
+        GLuint index;
+        if(keys.empty() || !this->slot(property, component, index))
+            return false;
+        KeyChannel channel = { index, GLuint(this->keys.size()), GLuint(keys.size()), 0, wrap };
+        this->keyChannels.push_back(channel);
+        this->keys.insert(this->keys.end(), keys.begin(), keys.end());
+        this->keyTime.push_back(0.0f);
+        this->keyT0.push_back(0.0f);
+        this->keyT1.push_back(0.0f);
+        this->keyV0.push_back(0.0f);
+        this->keyV1.push_back(0.0f);
+        this->keyValue.push_back(0.0f);
+        return true;
+    }
+
+    // 计算 time（秒）时刻的所有通道，写回改变了的分量，返回本次改变了的属性数
+    GLuint Update(GLfloat time)
+    {
+        std::fill(this->dirty.begin(), this->dirty.end(), 0);
+
+        // 1. 程序化通道：批量计算
+        size_t procCount = this->procSlot.size();
+        const GLfloat* sine = this->procSine.data();
+        const GLfloat* amplitude = this->procAmplitude.data();
+        const GLfloat* frequency = this->procFrequency.data();
+        const GLfloat* phase = this->procPhase.data();
+        const GLfloat* offset = this->procOffset.data();
+        GLfloat* procOut = this->procValue.data();
+        Float4 t = Float4Set(time), one = Float4Set(1.0f);
+        for(size_t i = 0; i < procCount; i += 4)
+        {
+            size_t n = procCount - i;
+            Float4 s = Float4LoadN(sine + i, n);
+            Float4 x = Float4LoadN(frequency + i, n) * t + Float4LoadN(phase + i, n);
+            Float4 wave = s * FastSin(x) + (one - s) * x;
+            Float4StoreN(procOut + i, Float4LoadN(offset + i, n) + Float4LoadN(amplitude + i, n) * wave, n);
+        }
+
+        // 2. 关键帧通道：逐个找区间，再批量插值
+        size_t keyCount = this->keyChannels.size();
+        for(size_t i = 0; i < keyCount; i++)
+            this->findSegment(i, time);
+        const GLfloat* localTime = this->keyTime.data();
+        const GLfloat* t0 = this->keyT0.data();
+        const GLfloat* t1 = this->keyT1.data();
+        const GLfloat* v0 = this->keyV0.data();
+        const GLfloat* v1 = this->keyV1.data();
+        GLfloat* keyOut = this->keyValue.data();
+        Float4 zero = Float4Set(0.0f), epsilon = Float4Set(1e-6f);
+        for(size_t i = 0; i < keyCount; i += 4)
+        {
+            size_t n = keyCount - i;
+            Float4 start = Float4LoadN(t0 + i, n), from = Float4LoadN(v0 + i, n);
+            Float4 u = (Float4LoadN(localTime + i, n) - start) / Float4Max(Float4LoadN(t1 + i, n) - start, epsilon);
+            u = Float4Min(Float4Max(u, zero), one);
+            Float4StoreN(keyOut + i, from + (Float4LoadN(v1 + i, n) - from) * u, n);
+        }
+
+        // 3. 与上一帧比较，只写回改变了的分量
+        for(size_t i = 0; i < procCount; i++)
+            this->store(this->procSlot[i], procOut[i]);
+        for(size_t i = 0; i < keyCount; i++)
+            this->store(this->keyChannels[i].slot, keyOut[i]);
+
+        GLuint changed = 0;
+        this->dirtyList.clear();
+        for(GLuint p = 0; p < this->properties.size(); p++)
+        {
+            if(!this->dirty[p])
+                continue;
+            this->dirtyList.push_back(p);
+            changed++;
+        }
+        return changed;
+    }
+
+    // 上次 Update 中属性是否改变
+    bool Dirty(GLuint property) const { return this->dirty[property] != 0; }
+
+    // 上次 Update 中改变了的属性编号
+    const std::vector<GLuint>& DirtyProperties() const { return this->dirtyList; }
+
+    GLuint ChannelCount() const { return GLuint(this->procSlot.size() + this->keyChannels.size()); }
+
+private:
+    struct Property
+    {
+        GLfloat* target;
+        GLuint first;      // values 中的第一个分量
+        GLuint components;
+    };
+
+    struct KeyChannel
+    {
+        GLuint slot;
+        GLuint first, count; // keys 中的区间
+        GLuint cursor;       // 上次所在区间的起始帧（相对 first）
+        AnimationWrap wrap;
+    };
+
+    std::vector<Property> properties;
+    std::vector<GLfloat> values;       // 各属性分量的当前值（展开）
+    std::vector<GLuint> slotProperty;  // 分量所属的属性
+    std::vector<unsigned char> dirty;  // 按属性
+    std::vector<GLuint> dirtyList;
+
+    // 程序化通道（SoA）
+    std::vector<GLuint> procSlot;
+    std::vector<GLfloat> procSine, procAmplitude, procFrequency, procPhase, procOffset, procValue;
+
+    // 关键帧通道（SoA，区间查找的结果放在 keyT0/T1/V0/V1 中）
+    std::vector<KeyChannel> keyChannels;
+    std::vector<Keyframe> keys;
+    std::vector<GLfloat> keyTime, keyT0, keyT1, keyV0, keyV1, keyValue;
+
+    // 属性或分量不存在时输出错误并返回 false
+    bool slot(GLuint property, GLuint component, GLuint& index)
+    {
+        if(property >= this->properties.size() || component >= this->properties[property].components)
+        {
+            std::cout << "ERROR::ANIMATION:: property " << property << " has no component " << component << std::endl;
+            return false;
+        }
+        index = this->properties[property].first + component;
+        if(this->slotProperty.size() < this->values.size())
+            this->slotProperty.resize(this->values.size(), 0);
+        this->slotProperty[index] = property;
+        return true;
+    }
+
+    void store(GLuint slot, GLfloat value)
+    {
+        if(this->values[slot] == value)
+            return;
+        this->values[slot] = value;
+        GLuint property = this->slotProperty[slot];
+        const Property& p = this->properties[property];
+        p.target[slot - p.first] = value;
+        this->dirty[property] = 1;
+    }
+
+    // 求通道 i 在 time 时刻所在的区间，写入 keyTime/T0/T1/V0/V1
+    void findSegment(size_t i, GLfloat time)
+    {
+        KeyChannel& channel = this->keyChannels[i];
+        const Keyframe* k = &this->keys[channel.first];
+        GLfloat start = k[0].time, end = k[channel.count - 1].time;
+        GLfloat t = time;
+        if(channel.wrap == WRAP_LOOP && end > start)
+            t = start + std::fmod(std::max(t - start, 0.0f), end - start);
+        t = std::min(std::max(t, start), end);
+
+        // 时间通常只前进一点：从上次的区间向后找，倒退（循环回到开头）时从头找
+        GLuint cursor = channel.cursor;
+        if(cursor >= channel.count || k[cursor].time > t)
+            cursor = 0;
+        while(cursor + 1 < channel.count - 1 && k[cursor + 1].time <= t)
+            cursor++;
+        channel.cursor = cursor;
+
+        GLuint next = std::min(cursor + 1, channel.count - 1);
+        this->keyTime[i] = t;
+        this->keyT0[i] = k[cursor].time;
+        this->keyT1[i] = k[next].time;
+        this->keyV0[i] = k[cursor].value;
+        this->keyV1[i] = k[next].value;
+    }
+};
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <zstd.h>
+
+#include <learnopengl/mapped_file.h>
+
+// == ======================================
+// 资源包
+// 资源原本都是 FileSystem::getPath("resources/...") 下的散文件，启动时要逐个打开、stat、读取。
+// 资源包把它们放进一个文件：
+// 1. 文件头之后是按哈希排序的目录（TOC），每项记录路径哈希、偏移、大小和压缩标记；
+// 2. 数据块按 ASSET_PACK_ALIGNMENT 对齐，可选 zstd 压缩（PNG/JPEG 本身已压缩，保持原样）；
+// 3. 运行时整个包只 mmap 一次，目录直接在映射上二分查找，未压缩的资源返回零复制的视图。
+// 用 MountAssetPack 挂载后，AssetFile::Open 先在包中查找，找不到再读散文件，
+// 所以 LoadPackedObj（obj_asset_loader.h）、LoadAssimp、DecodeImage 等不需要改动调用方式。
+// 格式按小端序存储。
+// == ======================================
+
+const char ASSET_PACK_MAGIC[4] = { 'L', 'P', 'A', 'K' };
+const GLuint ASSET_PACK_VERSION = 1;
+const GLuint ASSET_PACK_ALIGNMENT = 64;
+
+enum AssetFlags
+{
+    ASSET_ZSTD = 1 << 0 // 数据块经过 zstd 压缩
+};
+
+struct AssetPackHeader
+{
+    char magic[4];
+    GLuint version;
+    GLuint entryCount;
+    GLuint reserved;
+    GLuint64 tocOffset;
+    GLuint64 dataOffset;
+};
+
+struct AssetPackEntry
+{
+    GLuint64 hash;    // 规范化相对路径的 FNV-1a 哈希
+    GLuint64 offset;  // 数据块在包中的偏移
+    GLuint64 size;    // 数据块大小
+    GLuint64 rawSize; // 解压后的大小
+    GLuint flags;
+    GLuint reserved[3];
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader layout");
+static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry layout");
+
+// 规范化路径：统一为 '/'，去掉重复的分隔符、"." 和 "dir/.."
+inline std::string NormalizeAssetPath(const std::string& path)
+{
+    std::vector<std::string> parts;
+    std::string part;
+    bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+    for(size_t i = 0; i <= path.size(); i++)
+    {
+        char c = (i < path.size()) ? path[i] : '/';
+        if(c != '/' && c != '\\')
+        {
+            part += c;
+            continue;
+        }
+        if(part == "..")
+        {
+            if(!parts.empty() && parts.back() != "..")
+                parts.pop_back();
+            else
+                parts.push_back(part);
+        }
+        else if(!part.empty() && part != ".")
+            parts.push_back(part);
+        part.clear();
+    }
+    std::string result = absolute ? "/" : "";
+    for(size_t i = 0; i < parts.size(); i++)
+        result += (i ? "/" : "") + parts[i];
+    return result;
+}
+
+inline GLuint64 HashAssetPath(const std::string& normalizedPath)
+{
+    GLuint64 hash = 14695981039346656037ull;
+    for(char c : normalizedPath)
+    {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 一个已映射的资源包
+class AssetPack
+{
+public:
+    AssetPack() : entries(nullptr), entryCount(0) { }
+
+    bool Open(const std::string& path)
+    {
+        this->entries = nullptr;
+        this->entryCount = 0;
+        if(!this->file.Open(path))
+            return false;
+        const AssetPackHeader* header = (const AssetPackHeader*)this->file.Data();
+        GLuint64 fileSize = this->file.Size();
+        bool ok = fileSize >= sizeof(AssetPackHeader) && std::memcmp(header->magic, ASSET_PACK_MAGIC, 4) == 0
+                  && header->version == ASSET_PACK_VERSION && header->tocOffset % 8 == 0 && header->tocOffset <= fileSize
+                  && GLuint64(header->entryCount) * sizeof(AssetPackEntry) <= fileSize - header->tocOffset;
+        // 每个数据块都必须在文件内，目录必须按哈希排序（Find 用二分查找），截断或损坏的包整个拒绝
+        const AssetPackEntry* toc = ok ? (const AssetPackEntry*)(this->file.Data() + header->tocOffset) : nullptr;
+        for(GLuint i = 0; ok && i < header->entryCount; i++)
+        {
+            const AssetPackEntry& entry = toc[i];
+            ok = entry.offset <= fileSize && entry.size <= fileSize - entry.offset && (i == 0 || toc[i - 1].hash <= entry.hash)
+                 && ((entry.flags & ASSET_ZSTD) || entry.rawSize == entry.size);
+        }
+        if(!ok)
+        {
+            std::cout << "ERROR::ASSET_PACK:: invalid pack " << path << std::endl;
+            this->file.Close();
+            return false;
+        }
+        this->entries = toc;
+        this->entryCount = header->entryCount;
+        return true;
+    }
+
+    // 按规范化的相对路径查找，没有时返回 nullptr
+    const AssetPackEntry* Find(const std::string& relativePath) const
+    {
+        GLuint64 hash = HashAssetPath(NormalizeAssetPath(relativePath));
+        const AssetPackEntry* end = this->entries + this->entryCount;
+        const AssetPackEntry* entry = std::lower_bound(this->entries, end, hash, [](const AssetPackEntry& e, GLuint64 h)
+        {
+            return e.hash < h;
+        });
+        return (entry != end && entry->hash == hash) ? entry : nullptr;
+    }
+
+    const char* Data(const AssetPackEntry& entry) const
+    {
+        return this->file.Data() + entry.offset;
+    }
+
+    GLuint EntryCount() const
+    {
+        return this->entryCount;
+    }
+
+private:
+    MappedFile file;
+    const AssetPackEntry* entries;
+    GLuint entryCount;
+};
+
+// 已挂载的资源包，root 为包内相对路径的起点（规范化后的绝对路径前缀）
+struct MountedAssetPack
+{
+    std::string root;
+    std::shared_ptr<AssetPack> pack;
+};
+
+inline std::vector<MountedAssetPack>& MountedAssetPacks()
+{
+    static std::vector<MountedAssetPack> packs;
+    return packs;
+}
+
+// 挂载资源包；root 对应打包时的根目录，通常为 FileSystem::getPath("")。
+// 应在开始载入资源之前（单线程）挂载，之后的查找可以在任意线程中进行。后挂载的包优先。
+inline bool MountAssetPack(const std::string& packPath, const std::string& root)
+{
+    std::shared_ptr<AssetPack> pack(new AssetPack());
+    if(!pack->Open(packPath))
+        return false;
+    MountedAssetPack mounted;
+    mounted.root = NormalizeAssetPath(root);
+    mounted.pack = pack;
+    MountedAssetPacks().insert(MountedAssetPacks().begin(), mounted);
+    return true;
+}
+
+// 在已挂载的包中查找资源，找到时 pack 为所在的包
+inline const AssetPackEntry* FindMountedAsset(const std::string& path, const AssetPack*& pack)
+{
+    std::string normalized = NormalizeAssetPath(path);
+    for(const MountedAssetPack& mounted : MountedAssetPacks())
+    {
+        const std::string& root = mounted.root;
+        std::string relative;
+        if(root.empty())
+            relative = normalized;
+        else if(normalized.size() > root.size() && normalized.compare(0, root.size(), root) == 0 && normalized[root.size()] == '/')
+            relative = normalized.substr(root.size() + 1);
+        else
+            continue;
+        const AssetPackEntry* entry = mounted.pack->Find(relative);
+        if(entry)
+        {
+            pack = mounted.pack.get();
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+// 资源是否存在：只查目录或打开散文件，不映射、不解压
+inline bool AssetExists(const std::string& path)
+{
+    const AssetPack* pack = nullptr;
+    if(FindMountedAsset(path, pack))
+        return true;
+    std::ifstream file(path.c_str(), std::ios::binary);
+    return file.good();
+}
+
+// 只读资源文件：先在已挂载的包中查找，找不到时映射散文件。
+// 接口与 MappedFile 相同；包中未压缩的资源直接指向包的映射，压缩的资源解压到自身的缓冲中。
+class AssetFile
+{
+public:
+    AssetFile() : data(nullptr), size(0), packed(false) { }
+
+    bool Open(const std::string& path)
+    {
+        this->Close();
+        const AssetPack* pack = nullptr;
+        const AssetPackEntry* entry = FindMountedAsset(path, pack);
+        if(entry)
+            return this->openEntry(*pack, *entry, path);
+
+        if(!this->file.Open(path))
+            return false;
+        this->data = this->file.Data();
+        this->size = this->file.Size();
+        return true;
+    }
+
+    void Close()
+    {
+        this->file.Close();
+        std::vector<char>().swap(this->inflated);
+        this->data = nullptr;
+        this->size = 0;
+        this->packed = false;
+    }
+
+    const char* Data() const
+    {
+        return this->data;
+    }
+
+    size_t Size() const
+    {
+        return this->size;
+    }
+
+    // 是否来自资源包
+    bool Packed() const
+    {
+        return this->packed;
+    }
+
+private:
+    AssetFile(const AssetFile&);
+    AssetFile& operator=(const AssetFile&);
+
+    MappedFile file;
+    std::vector<char> inflated;
+    const char* data;
+    size_t size;
+    bool packed;
+
+    bool openEntry(const AssetPack& pack, const AssetPackEntry& entry, const std::string& path)
+    {
+        this->packed = true;
+        if(!(entry.flags & ASSET_ZSTD))
+        {
+            this->data = pack.Data(entry);
+            this->size = size_t(entry.size);
+            return true;
+        }
+        this->inflated.resize(size_t(entry.rawSize));
+        size_t result = ZSTD_decompress(this->inflated.data(), this->inflated.size(), pack.Data(entry), size_t(entry.size));
+        if(ZSTD_isError(result) || result != this->inflated.size())
+        {
+            std::cout << "ERROR::ASSET_PACK:: cannot decompress " << path << std::endl;
+            this->Close();
+            return false;
+        }
+        this->data = this->inflated.data();
+        this->size = this->inflated.size();
+        return true;
+    }
+};
+
+// 把 root 下的一组文件（相对路径）写成资源包。
+// compress 为 true 时用 zstd 压缩，压缩后没有变小的文件和 PNG/JPEG 保持原样。
+inline bool WriteAssetPack(const std::string& packPath, const std::string& root, const std::vector<std::string>& files,
+                           bool compress = true, GLint compressionLevel = 9)
+{
+    struct PendingEntry
+    {
+        AssetPackEntry entry;
+        std::vector<char> data;
+    };
+    std::vector<PendingEntry> pending(files.size());
+    for(size_t i = 0; i < files.size(); i++)
+    {
+        std::string relative = NormalizeAssetPath(files[i]);
+        MappedFile file;
+        if(!file.Open(root + "/" + relative))
+        {
+            std::cout << "ERROR::ASSET_PACK:: cannot open " << root << "/" << relative << std::endl;
+            return false;
+        }
+        PendingEntry& item = pending[i];
+        std::memset(&item.entry, 0, sizeof(AssetPackEntry));
+        item.entry.hash = HashAssetPath(relative);
+        item.entry.rawSize = file.Size();
+
+        std::string extension = relative.substr(relative.find_last_of('.') + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        bool precompressed = (extension == "png" || extension == "jpg" || extension == "jpeg");
+        if(compress && !precompressed && file.Size() > 0)
+        {
+            item.data.resize(ZSTD_compressBound(file.Size()));
+            size_t packedSize = ZSTD_compress(item.data.data(), item.data.size(), file.Data(), file.Size(), compressionLevel);
+            if(!ZSTD_isError(packedSize) && packedSize < file.Size())
+            {
+                item.data.resize(packedSize);
+                item.entry.flags = ASSET_ZSTD;
+            }
+        }
+        if(!(item.entry.flags & ASSET_ZSTD))
+            item.data.assign(file.Data(), file.Data() + file.Size());
+        item.entry.size = item.data.size();
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b)
+    {
+        return a.entry.hash < b.entry.hash;
+    });
+    for(size_t i = 1; i < pending.size(); i++)
+        if(pending[i].entry.hash == pending[i - 1].entry.hash)
+        {
+            std::cout << "ERROR::ASSET_PACK:: duplicate path or hash collision" << std::endl;
+            return false;
+        }
+
+    // 文件头、目录、对齐的数据块
+    AssetPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, 4);
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = GLuint(pending.size());
+    header.tocOffset = sizeof(AssetPackHeader);
+    GLuint64 offset = header.tocOffset + pending.size() * sizeof(AssetPackEntry);
+    offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+    header.dataOffset = offset;
+    for(PendingEntry& item : pending)
+    {
+        item.entry.offset = offset;
+        offset += item.entry.size;
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+    }
+
+    std::ofstream out(packPath.c_str(), std::ios::binary);
+    if(!out)
+    {
+        std::cout << "ERROR::ASSET_PACK:: cannot write " << packPath << std::endl;
+        return false;
+    }
+    out.write((const char*)&header, sizeof(header));
+    for(const PendingEntry& item : pending)
+        out.write((const char*)&item.entry, sizeof(AssetPackEntry));
+    const char zeros[ASSET_PACK_ALIGNMENT] = { 0 };
+    GLuint64 written = header.tocOffset + pending.size() * sizeof(AssetPackEntry);
+    for(const PendingEntry& item : pending)
+    {
+        out.write(zeros, std::streamsize(item.entry.offset - written));
+        out.write(item.data.data(), std::streamsize(item.data.size()));
+        written = item.entry.offset + item.entry.size;
+    }
+    return bool(out);
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef ASSIMP_LOADER_H
+#define ASSIMP_LOADER_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include <learnopengl/model_data.h>
+#include <learnopengl/parallel.h>
+#include <learnopengl/asset_pack.h>
+#include <learnopengl/trace.h>
+
+// == ======================================
+// 多线程版的 Model::loadModel
+// Model 在一个线程中递归遍历节点，逐个顶点复制 aiMesh，并在遍历中同步载入贴图。
+// 这里先把节点树展开成网格列表，每个 aiMesh 作为一个任务在工作线程中转换成 MeshData；
+// 贴图只记录路径，由 MeshModel 去重后并行解码，最后在主线程中统一上传。
+// == ======================================
+
+// 把一个 aiMesh 转换成 MeshData（与 Model::processMesh 相同的顶点格式）
+inline void ConvertAssimpMesh(const aiMesh* mesh, MeshData& out)
+{
+    out.material = mesh->mMaterialIndex;
+    out.vertices.resize(mesh->mNumVertices);
+    bool hasNormals = mesh->mNormals != nullptr;
+    bool hasTexCoords = mesh->mTextureCoords[0] != nullptr;
+    for(GLuint i = 0; i < mesh->mNumVertices; i++)
+    {
+        Vertex& vertex = out.vertices[i];
+        vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        vertex.Normal = hasNormals ? glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z) : glm::vec3(0.0f);
+        vertex.TexCoords = hasTexCoords ? glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y) : glm::vec2(0.0f, 0.0f);
+    }
+
+    out.indices.clear();
+    out.indices.reserve(mesh->mNumFaces * 3);
+    for(GLuint i = 0; i < mesh->mNumFaces; i++)
+    {
+        const aiFace& face = mesh->mFaces[i];
+        out.indices.insert(out.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+    }
+}
+
+inline void ReadAssimpTextures(const aiMaterial* material, aiTextureType type, std::vector<std::string>& paths)
+{
+    for(GLuint i = 0; i < material->GetTextureCount(type); i++)
+    {
+        aiString str;
+        material->GetTexture(type, i, &str);
+        paths.push_back(str.C_Str());
+    }
+}
+
+// Assimp 的文件读取接口，通过 AssetFile 读取（已挂载的资源包优先）
+class AssetIOStream : public Assimp::IOStream
+{
+public:
+    AssetFile file;
+
+    AssetIOStream() : position(0) { }
+
+    size_t Read(void* buffer, size_t size, size_t count) override
+    {
+        if(size == 0)
+            return 0;
+        count = std::min(count, (this->file.Size() - this->position) / size);
+        std::memcpy(buffer, this->file.Data() + this->position, size * count);
+        this->position += size * count;
+        return count;
+    }
+
+    size_t Write(const void*, size_t, size_t) override
+    {
+        return 0;
+    }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override
+    {
+        size_t base = (origin == aiOrigin_CUR) ? this->position : (origin == aiOrigin_END) ? this->file.Size() : 0;
+        if(base + offset > this->file.Size())
+            return aiReturn_FAILURE;
+        this->position = base + offset;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override
+    {
+        return this->position;
+    }
+
+    size_t FileSize() const override
+    {
+        return this->file.Size();
+    }
+
+    void Flush() override { }
+
+private:
+    size_t position;
+};
+
+class AssetIOSystem : public Assimp::IOSystem
+{
+public:
+    bool Exists(const char* path) const override
+    {
+        return AssetExists(path);
+    }
+
+    char getOsSeparator() const override
+    {
+        return '/';
+    }
+
+    Assimp::IOStream* Open(const char* path, const char* mode = "rb") override
+    {
+        if(std::strchr(mode, 'w') || std::strchr(mode, 'a'))
+            return nullptr; // 只读
+        AssetIOStream* stream = new AssetIOStream();
+        if(!stream->file.Open(path))
+        {
+            delete stream;
+            return nullptr;
+        }
+        return stream;
+    }
+
+    void Close(Assimp::IOStream* stream) override
+    {
+        delete stream;
+    }
+};
+
+// 用 Assimp 载入模型，生成 CPU 端数据；threadCount 为 0 时使用全部硬件线程
+inline bool LoadAssimp(const std::string& path, ModelData& model, GLuint threadCount = 0)
+{
+    TRACE_SCOPE("LoadAssimp");
+    Assimp::Importer importer;
+    importer.SetIOHandler(new AssetIOSystem()); // 由 importer 释放
+    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+    if(!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    {
+        std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
+        return false;
+    }
+    model.directory = path.substr(0, path.find_last_of('/'));
+
+    // 1. 展开节点树，顺序与 Model::processNode 相同（先本节点的网格，再子节点）
+    std::vector<GLuint> meshRefs;
+    std::vector<const aiNode*> stack(1, scene->mRootNode);
+    while(!stack.empty())
+    {
+        const aiNode* node = stack.back();
+        stack.pop_back();
+        meshRefs.insert(meshRefs.end(), node->mMeshes, node->mMeshes + node->mNumMeshes);
+        for(GLuint i = node->mNumChildren; i > 0; i--)
+            stack.push_back(node->mChildren[i - 1]);
+    }
+
+    // 2. 每个 aiMesh 一个任务；被多个节点引用的网格只转换一次
+    std::vector<MeshData> converted(scene->mNumMeshes);
+    ParallelTasks(scene->mNumMeshes, WorkerCount(threadCount), [&](size_t i)
+    {
+        ConvertAssimpMesh(scene->mMeshes[i], converted[i]);
+    });
+    model.meshes.clear();
+    model.meshes.reserve(meshRefs.size());
+    for(GLuint ref : meshRefs)
+        model.meshes.push_back(converted[ref]);
+
+    // 3. 材质只记录贴图路径
+    model.materials.assign(scene->mNumMaterials, MaterialData());
+    for(GLuint i = 0; i < scene->mNumMaterials; i++)
+    {
+        ReadAssimpTextures(scene->mMaterials[i], aiTextureType_DIFFUSE, model.materials[i].diffuseMaps);
+        ReadAssimpTextures(scene->mMaterials[i], aiTextureType_SPECULAR, model.materials[i].specularMaps);
+    }
+    return true;
+}
+
+#endif
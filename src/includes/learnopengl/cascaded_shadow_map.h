@@ -0,0 +1,263 @@
+#ifndef CASCADED_SHADOW_MAP_H
+#define CASCADED_SHADOW_MAP_H
+
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// 平行光的级联阴影贴图（CSM）
+// 摄像机视锥按距离分成几段，每段用一个包围球拟合并投影到一层深度纹理数组上。
+// 级联中心按网格吸附：摄像机小范围移动时投影矩阵不变，阴影边缘不会闪烁，
+// 只含静态投射物的级联也可以一直沿用上次渲染的结果，
+// 只有灯光方向、静态物体或级联位置变化时才重新渲染。
+class CascadedShadowMap
+{
+public:
+    static const GLuint MAX_CASCADES = 4;
+
+    GLfloat SplitLambda;    // 对数/均匀分割的混合系数
+    GLfloat CasterDistance; // 视锥外仍会投下阴影的距离（沿灯光方向）
+    GLuint  SnapTexels;     // 级联每次移动的最小距离（纹素数）
+
+    CascadedShadowMap(GLuint resolution = 2048, GLuint cascadeCount = 3)
+        : SplitLambda(0.75f), CasterDistance(50.0f), SnapTexels(16),
+          resolution(resolution), cascadeCount(std::min(std::max(cascadeCount, 1u), MAX_CASCADES)),
+          lightDirection(0.0f, -1.0f, 0.0f), staticVersion(0), renderedCount(0), hasDynamic(false)
+    {
+        for(GLuint i = 0; i < MAX_CASCADES; i++)
+        {
+            this->cascades[i].lightCenter = glm::vec3(0.0f);
+            this->cascades[i].extent = 0.0f;
+            this->cascades[i].splitFar = 0.0f;
+            this->cascades[i].renderedVersion = ~0u;
+        }
+        this->staticDepth  = this->createDepthArray();
+        this->dynamicDepth = 0;
+        glGenFramebuffers(1, &this->FBO);
+        glGenFramebuffers(1, &this->copyFBO);
+        // 只有深度附件，不需要颜色缓冲
+        glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->copyFBO);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    ~CascadedShadowMap()
+    {
+        glDeleteTextures(1, &this->staticDepth);
+        if(this->dynamicDepth)
+            glDeleteTextures(1, &this->dynamicDepth);
+        glDeleteFramebuffers(1, &this->FBO);
+        glDeleteFramebuffers(1, &this->copyFBO);
+    }
+
+    // 灯光方向改变时所有级联都要重新渲染
+    void SetLightDirection(const glm::vec3& direction)
+    {
+        glm::vec3 dir = glm::normalize(direction);
+        if(dir == this->lightDirection)
+            return;
+        this->lightDirection = dir;
+        this->staticVersion++;
+    }
+
+    // 静态投射物（位置、数量）发生变化时调用
+    void InvalidateStatic()
+    {
+        this->staticVersion++;
+    }
+
+    // 按摄像机视锥计算各级联的分割距离和灯光空间矩阵
+    // fov、aspect、nearPlane、farPlane 与渲染时传给 glm::perspective 的参数相同（本仓库的 GLM 中 fov 以度为单位）
+    void Update(const glm::mat4& view, GLfloat fov, GLfloat aspect, GLfloat nearPlane, GLfloat farPlane)
+    {
+        // 分割距离：对数分割与均匀分割按 SplitLambda 混合
+        GLfloat splitNear = nearPlane;
+        glm::vec3 up = std::fabs(this->lightDirection.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), this->lightDirection, up);
+
+        for(GLuint i = 0; i < this->cascadeCount; i++)
+        {
+            GLfloat p = GLfloat(i + 1) / this->cascadeCount;
+            GLfloat logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+            GLfloat uniSplit = nearPlane + (farPlane - nearPlane) * p;
+            GLfloat splitFar = this->SplitLambda * logSplit + (1.0f - this->SplitLambda) * uniSplit;
+
+            // 这一段视锥的 8 个角点（世界空间）
+            glm::mat4 projection = glm::perspective(fov, aspect, splitNear, splitFar);
+            glm::mat4 inv = glm::inverse(projection * view);
+            glm::vec3 corners[8];
+            glm::vec3 center(0.0f);
+            for(GLuint c = 0; c < 8; c++)
+            {
+                glm::vec4 ndc((c & 1) ? 1.0f : -1.0f, (c & 2) ? 1.0f : -1.0f, (c & 4) ? 1.0f : -1.0f, 1.0f);
+                glm::vec4 world = inv * ndc;
+                corners[c] = glm::vec3(world) / world.w;
+                center += corners[c];
+            }
+            center /= 8.0f;
+
+            // 包围球半径只与分割距离和视角有关，取整后不随摄像机转动而变化
+            GLfloat radius = 0.0f;
+            for(GLuint c = 0; c < 8; c++)
+                radius = std::max(radius, glm::length(corners[c] - center));
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+
+            // 在灯光空间中把中心吸附到网格上，并按吸附步长扩大范围保证覆盖
+            GLfloat texel = 2.0f * radius / this->resolution;
+            GLfloat step = texel * this->SnapTexels;
+            GLfloat extent = radius + step;
+            texel = 2.0f * extent / this->resolution;
+            step = texel * this->SnapTexels;
+            glm::vec3 lightCenter = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+            lightCenter = glm::floor(lightCenter / step) * step;
+
+            Cascade& cascade = this->cascades[i];
+            if(lightCenter != cascade.lightCenter || extent != cascade.extent)
+            {
+                cascade.lightCenter = lightCenter;
+                cascade.extent = extent;
+                cascade.renderedVersion = ~0u; // 级联移动了，缓存失效
+            }
+            cascade.splitFar = splitFar;
+
+            // lookAt 朝 -z 看，近/远平面取中心前后的距离
+            glm::mat4 lightProjection = glm::ortho(lightCenter.x - extent, lightCenter.x + extent,
+                                                   lightCenter.y - extent, lightCenter.y + extent,
+                                                   -lightCenter.z - extent - this->CasterDistance,
+                                                   -lightCenter.z + extent);
+            cascade.lightSpace = lightProjection * lightRotation;
+
+            splitNear = splitFar;
+        }
+    }
+
+    // 渲染阴影贴图
+    // drawStatic/drawDynamic 使用传入的深度着色器程序绘制投射物（需设置 model 矩阵）。
+    // 没有动态投射物时 drawDynamic 传空，级联只在缓存失效时渲染；
+    // 有动态投射物时先复制静态缓存，再叠加动态物体。
+    void Render(GLuint depthProgram, const std::function<void(GLuint)>& drawStatic,
+                const std::function<void(GLuint)>& drawDynamic = std::function<void(GLuint)>())
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glViewport(0, 0, this->resolution, this->resolution);
+        glUseProgram(depthProgram);
+        GLint lightSpaceLoc = glGetUniformLocation(depthProgram, "lightSpaceMatrix");
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+
+        this->renderedCount = 0;
+        glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+        for(GLuint i = 0; i < this->cascadeCount; i++)
+        {
+            Cascade& cascade = this->cascades[i];
+            if(cascade.renderedVersion == this->staticVersion)
+                continue;
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->staticDepth, 0, i);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            glUniformMatrix4fv(lightSpaceLoc, 1, GL_FALSE, glm::value_ptr(cascade.lightSpace));
+            drawStatic(depthProgram);
+            cascade.renderedVersion = this->staticVersion;
+            this->renderedCount++;
+        }
+
+        this->hasDynamic = bool(drawDynamic);
+        if(this->hasDynamic)
+        {
+            if(!this->dynamicDepth)
+                this->dynamicDepth = this->createDepthArray();
+            for(GLuint i = 0; i < this->cascadeCount; i++)
+            {
+                // 复制静态缓存，再画动态物体
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, this->copyFBO);
+                glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->staticDepth, 0, i);
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->FBO);
+                glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->dynamicDepth, 0, i);
+                glBlitFramebuffer(0, 0, this->resolution, this->resolution, 0, 0, this->resolution, this->resolution,
+                                  GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+                glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+                glUniformMatrix4fv(lightSpaceLoc, 1, GL_FALSE, glm::value_ptr(this->cascades[i].lightSpace));
+                drawDynamic(depthProgram);
+            }
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+    // 绑定阴影贴图并上传采样所需的 uniform（需要先激活 program）
+    void Bind(GLuint program, GLuint textureUnit)
+    {
+        glActiveTexture(GL_TEXTURE0 + textureUnit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->hasDynamic ? this->dynamicDepth : this->staticDepth);
+        glUniform1i(glGetUniformLocation(program, "shadowMap"), textureUnit);
+        glUniform1i(glGetUniformLocation(program, "cascadeCount"), this->cascadeCount);
+        for(GLuint i = 0; i < this->cascadeCount; i++)
+        {
+            std::string index = "[" + std::to_string(i) + "]";
+            glUniformMatrix4fv(glGetUniformLocation(program, ("lightSpaceMatrices" + index).c_str()), 1, GL_FALSE,
+                               glm::value_ptr(this->cascades[i].lightSpace));
+            glUniform1f(glGetUniformLocation(program, ("cascadeSplits" + index).c_str()), this->cascades[i].splitFar);
+        }
+    }
+
+    // 上一次 Render 实际重新渲染的级联数量（静态场景中通常为 0）
+    GLuint RenderedCascades() const
+    {
+        return this->renderedCount;
+    }
+
+private:
+    struct Cascade
+    {
+        glm::mat4 lightSpace;
+        glm::vec3 lightCenter;
+        GLfloat   extent;
+        GLfloat   splitFar;
+        GLuint    renderedVersion; // 渲染时的静态版本号，~0u 表示需要重新渲染
+    };
+
+    GLuint resolution;
+    GLuint cascadeCount;
+    glm::vec3 lightDirection;
+    GLuint staticVersion;
+    GLuint renderedCount;
+    bool hasDynamic;
+    Cascade cascades[MAX_CASCADES];
+    GLuint staticDepth, dynamicDepth;
+    GLuint FBO, copyFBO;
+
+    CascadedShadowMap(const CascadedShadowMap&);
+    CascadedShadowMap& operator=(const CascadedShadowMap&);
+
+    GLuint createDepthArray()
+    {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, this->resolution, this->resolution, MAX_CASCADES,
+                     0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // 级联范围外视为没有阴影
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        GLfloat borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
+    }
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef DEPTH_PREPASS_H
+#define DEPTH_PREPASS_H
+
+#include <GL/glew.h>
+
+#include <learnopengl/shader_permutation.h>
+
+// == ======================================
+// 深度预渲染
+// multiple_lights.frag 对每个光栅化的片段都计算平行光、点光源和聚光灯并采样贴图，
+// 其中被后画的物体覆盖的片段全部白算。打开预渲染后每帧画两趟：
+// 1. 只有位置属性的 VAO + 只写深度的程序（depth_prepass.vs/.frag），关闭颜色写入；
+// 2. 照明着色器，深度测试改为 GL_EQUAL 并关闭深度写入，每个像素只着色最前面的一个片段。
+// 两趟的 gl_Position 都声明为 invariant，保证深度逐位相同。
+// 多出的是一趟很便宜的几何，省下的是重叠像素的照明计算；物体少、重叠少时可能得不偿失，所以可以按场景开关。
+// == ======================================
+class DepthPrepass
+{
+public:
+    // 着色器变体只用到 PERM_PACKED_VERTICES
+    DepthPrepass(const GLchar* vertexPath, const GLchar* fragmentPath) : shaders(vertexPath, fragmentPath) { }
+
+    // 第一趟：只写深度，返回激活的程序
+    GLuint Begin(GLuint key = 0)
+    {
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+        return this->shaders.Use(key);
+    }
+
+    // 第二趟：只着色深度与预渲染相等的片段
+    void BeginShading()
+    {
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_FALSE);
+        glDepthFunc(GL_EQUAL);
+    }
+
+    // 恢复默认状态（之后绘制的灯、透明物体等照常测试和写入深度）
+    void End()
+    {
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+    }
+
+private:
+    ShaderPermutation shaders;
+};
+
+#endif
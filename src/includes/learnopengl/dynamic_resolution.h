@@ -0,0 +1,221 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+#include <GL/glew.h>
+
+// == ======================================
+// 动态分辨率
+// 照明着色器是填充率瓶颈，每帧的开销基本和像素数成正比。
+// 场景先画到一个离屏目标的左下角 (输出尺寸 × 比例)，再用 glBlitFramebuffer 双线性放大到窗口。
+// 1. 离屏目标按输出尺寸一次分配，改变比例只改视口，不重新分配；
+// 2. 每帧用 GL_TIME_ELAPSED 查询 GPU 耗时（环形缓冲，不等待结果），和垂直同步、CPU 耗时无关；
+// 3. 像素数 ∝ 比例²，按 sqrt(目标 / 平滑后的耗时) 估计新比例，量化到 Step 并带滞回，
+//    比例改变后丢弃旧比例下的查询结果，避免来回振荡。
+// == ======================================
+
+// 比例的统计（从上次 ResetStats 起）
+struct DynamicResolutionStats
+{
+    GLuint  frames;
+    GLuint  changes;    // 比例改变的次数
+    GLfloat meanScale;
+    GLfloat minScale;
+    GLfloat maxScale;
+    GLfloat stddevScale;
+    GLfloat meanGpuTime; // 秒，已采纳的 GPU 耗时样本的平均值
+};
+
+class DynamicResolution
+{
+public:
+    GLfloat TargetFrameTime; // 秒
+    GLfloat MinScale, MaxScale;
+    GLfloat Step;            // 比例的量化步长，小于一步的变化忽略
+    GLfloat Smoothing;       // GPU 耗时的指数平滑系数
+    bool    Enabled;         // 关闭时固定为 MaxScale
+
+    DynamicResolution(GLuint outputWidth, GLuint outputHeight, GLfloat targetFrameTime = 1.0f / 60.0f)
+        : TargetFrameTime(targetFrameTime), MinScale(0.5f), MaxScale(1.0f), Step(1.0f / 32.0f), Smoothing(0.2f), Enabled(true),
+          outputWidth(outputWidth), outputHeight(outputHeight), scale(1.0f), filteredTime(0.0f), queryIndex(0), timing(false)
+    {
+        glGenTextures(1, &this->colorTexture);
+        glBindTexture(GL_TEXTURE_2D, this->colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, outputWidth, outputHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenRenderbuffers(1, &this->depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, this->depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, outputWidth, outputHeight);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &this->FBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->colorTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, this->depthBuffer);
+        if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::DYNAMIC_RESOLUTION::FRAMEBUFFER_INCOMPLETE" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        glGenQueries(QUERY_COUNT, this->queries);
+        for(GLuint i = 0; i < QUERY_COUNT; i++)
+        {
+            this->pending[i] = false;
+            this->queryScale[i] = 0.0f;
+        }
+        this->ResetStats();
+    }
+
+    ~DynamicResolution()
+    {
+        glDeleteQueries(QUERY_COUNT, this->queries);
+        glDeleteFramebuffers(1, &this->FBO);
+        glDeleteRenderbuffers(1, &this->depthBuffer);
+        glDeleteTextures(1, &this->colorTexture);
+    }
+
+    GLfloat Scale() const { return this->scale; }
+    GLuint RenderWidth() const { return std::max(1u, GLuint(this->outputWidth * this->scale + 0.5f)); }
+    GLuint RenderHeight() const { return std::max(1u, GLuint(this->outputHeight * this->scale + 0.5f)); }
+
+    // 开始一帧：先读回已完成的 GPU 耗时并更新比例，再绑定离屏目标和缩小后的视口
+    void Begin()
+    {
+        this->collectQueries();
+        if(!this->Enabled)
+            this->setScale(this->MaxScale);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+        glViewport(0, 0, this->RenderWidth(), this->RenderHeight());
+
+        // 上一轮的查询还没有结果时本帧不计时
+        this->timing = !this->pending[this->queryIndex];
+        if(this->timing)
+            glBeginQuery(GL_TIME_ELAPSED, this->queries[this->queryIndex]);
+    }
+
+    // 结束一帧：放大到默认帧缓冲，恢复全尺寸视口
+    void End()
+    {
+        if(this->timing)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            this->pending[this->queryIndex] = true;
+            this->queryScale[this->queryIndex] = this->scale;
+            this->queryIndex = (this->queryIndex + 1) % QUERY_COUNT;
+        }
+
+        GLuint width = this->RenderWidth(), height = this->RenderHeight();
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->FBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, this->outputWidth, this->outputHeight, GL_COLOR_BUFFER_BIT,
+                          (width == this->outputWidth && height == this->outputHeight) ? GL_NEAREST : GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, this->outputWidth, this->outputHeight);
+
+        this->frames++;
+        this->scaleSum += this->scale;
+        this->scaleSumSq += this->scale * this->scale;
+        this->minScale = std::min(this->minScale, this->scale);
+        this->maxScale = std::max(this->maxScale, this->scale);
+    }
+
+    // 控制器：输入一帧在当前比例下的 GPU 耗时（秒）
+    void Update(GLfloat gpuTime)
+    {
+        this->gpuTimeSum += gpuTime;
+        this->gpuSamples++;
+        this->filteredTime = (this->filteredTime <= 0.0f) ? gpuTime : this->filteredTime + this->Smoothing * (gpuTime - this->filteredTime);
+        if(!this->Enabled || this->filteredTime <= 0.0f)
+            return;
+
+        GLfloat desired = this->scale * std::sqrt(this->TargetFrameTime / this->filteredTime);
+        desired = std::min(std::max(desired, this->MinScale), this->MaxScale);
+        if(std::fabs(desired - this->scale) < this->Step)
+            return;
+        this->setScale(std::floor(desired / this->Step + 0.5f) * this->Step);
+    }
+
+    void ResetStats()
+    {
+        this->frames = 0;
+        this->changes = 0;
+        this->gpuSamples = 0;
+        this->scaleSum = this->scaleSumSq = 0.0;
+        this->gpuTimeSum = 0.0;
+        this->minScale = this->maxScale = this->scale;
+    }
+
+    DynamicResolutionStats Stats() const
+    {
+        DynamicResolutionStats stats;
+        stats.frames = this->frames;
+        stats.changes = this->changes;
+        GLdouble mean = this->frames ? this->scaleSum / this->frames : this->scale;
+        GLdouble variance = this->frames ? this->scaleSumSq / this->frames - mean * mean : 0.0;
+        stats.meanScale = GLfloat(mean);
+        stats.minScale = this->minScale;
+        stats.maxScale = this->maxScale;
+        stats.stddevScale = GLfloat(std::sqrt(std::max(variance, 0.0)));
+        stats.meanGpuTime = this->gpuSamples ? GLfloat(this->gpuTimeSum / this->gpuSamples) : 0.0f;
+        return stats;
+    }
+
+private:
+    static const GLuint QUERY_COUNT = 4;
+
+    GLuint outputWidth, outputHeight;
+    GLuint FBO, colorTexture, depthBuffer;
+    GLfloat scale;
+    GLfloat filteredTime;
+
+    GLuint  queries[QUERY_COUNT];
+    bool    pending[QUERY_COUNT];
+    GLfloat queryScale[QUERY_COUNT]; // 发出查询时的比例
+    GLuint  queryIndex;
+    bool    timing;
+
+    GLuint   frames, changes, gpuSamples;
+    GLdouble scaleSum, scaleSumSq, gpuTimeSum;
+    GLfloat  minScale, maxScale;
+
+    // 从最早发出的查询开始读回，遇到还没完成的就停止（之后的更不会完成）
+    void collectQueries()
+    {
+        for(GLuint n = 0; n < QUERY_COUNT; n++)
+        {
+            GLuint i = (this->queryIndex + n) % QUERY_COUNT;
+            if(!this->pending[i])
+                continue;
+            GLint available = 0;
+            glGetQueryObjectiv(this->queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if(!available)
+                break;
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(this->queries[i], GL_QUERY_RESULT, &elapsed);
+            this->pending[i] = false;
+            // 旧比例下的耗时不能用来估计当前比例
+            if(this->queryScale[i] == this->scale)
+                this->Update(GLfloat(elapsed * 1e-9));
+        }
+    }
+
+    void setScale(GLfloat newScale)
+    {
+        newScale = std::min(std::max(newScale, this->MinScale), this->MaxScale);
+        if(newScale == this->scale)
+            return;
+        this->scale = newScale;
+        this->filteredTime = 0.0f;
+        this->changes++;
+    }
+};
+
+#endif
@@ -0,0 +1,531 @@
+#ifndef ENTITY_WORLD_H
+#define ENTITY_WORLD_H
+
+#include <vector>
+#include <cstring>
+#include <functional>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <learnopengl/light_assignment.h>
+#include <learnopengl/parallel.h>
+
+// == ======================================
+// 实体-组件存储（按原型分块）
+// 场景状态原本散落在全局变量、局部数组和 lambda 里，每种数据各自一个 vector，物体之间靠下标对应。
+// 1. 实体只是一个编号，数据都在组件里；组件组合相同的实体属于同一个原型（archetype）；
+// 2. 每个原型把实体放在 16KB 的块中，块内每种组件各自一个连续数组（SoA），
+//    系统按块线性遍历，只读写用到的组件数组，不会把其他组件拉进缓存；
+// 3. 删除实体时用原型的最后一个实体填补空位，块始终是紧凑的；
+// 4. 块之间互不相关，ParallelForEachChunk 按块分给多个线程；
+//    RunSystems 把读写不冲突的相邻系统放在同一阶段并行执行，阶段内的系统平分线程数，总线程数不超过 threadCount。
+// 遍历期间不能创建、删除实体或增减组件（会移动数据）。
+// == ======================================
+
+// 组件（都是 POD，新建实体时清零）
+struct Transform
+{
+    glm::vec3 position;
+    GLfloat scale;     // 等比缩放
+    glm::vec3 axis;    // 旋转轴（单位向量）
+    GLfloat angle;     // 与 glm::rotate 的角度参数相同
+};
+
+struct WorldMatrix
+{
+    glm::mat4 model;
+};
+
+// 世界空间包围球（分配灯光、剔除）
+struct Bounds
+{
+    glm::vec3 center;
+    GLfloat radius;
+};
+
+struct MeshRef
+{
+    GLuint mesh;       // 由案例解释的网格编号
+    GLfloat radius;    // 模型空间包围球半径
+};
+
+struct MaterialRef
+{
+    GLuint material;   // 由案例解释的材质编号
+    GLfloat shininess;
+};
+
+// 绕 Transform.axis 匀速旋转
+struct Spin
+{
+    GLfloat speed;     // 角度/秒
+};
+
+// 点光源、聚光灯直接使用 light_assignment.h 中的 PointLight/SpotLight
+
+enum ComponentType
+{
+    COMP_TRANSFORM,
+    COMP_WORLD_MATRIX,
+    COMP_BOUNDS,
+    COMP_MESH,
+    COMP_MATERIAL,
+    COMP_SPIN,
+    COMP_POINT_LIGHT,
+    COMP_SPOT_LIGHT,
+    COMPONENT_TYPE_COUNT
+};
+
+typedef GLuint ComponentMask;
+
+template<typename T> struct ComponentInfo;
+template<> struct ComponentInfo<Transform>   { static const GLuint Type = COMP_TRANSFORM; };
+template<> struct ComponentInfo<WorldMatrix> { static const GLuint Type = COMP_WORLD_MATRIX; };
+template<> struct ComponentInfo<Bounds>      { static const GLuint Type = COMP_BOUNDS; };
+template<> struct ComponentInfo<MeshRef>     { static const GLuint Type = COMP_MESH; };
+template<> struct ComponentInfo<MaterialRef> { static const GLuint Type = COMP_MATERIAL; };
+template<> struct ComponentInfo<Spin>        { static const GLuint Type = COMP_SPIN; };
+template<> struct ComponentInfo<PointLight>  { static const GLuint Type = COMP_POINT_LIGHT; };
+template<> struct ComponentInfo<SpotLight>   { static const GLuint Type = COMP_SPOT_LIGHT; };
+
+inline GLuint ComponentSize(GLuint type)
+{
+    static const GLuint sizes[COMPONENT_TYPE_COUNT] = {
+        sizeof(Transform), sizeof(WorldMatrix), sizeof(Bounds), sizeof(MeshRef),
+        sizeof(MaterialRef), sizeof(Spin), sizeof(PointLight), sizeof(SpotLight)
+    };
+    return sizes[type];
+}
+
+template<typename T>
+inline ComponentMask ComponentBit()
+{
+    return 1u << ComponentInfo<T>::Type;
+}
+
+template<typename... Ts>
+inline ComponentMask ComponentMaskOf()
+{
+    ComponentMask bits[] = { 0u, ComponentBit<Ts>()... };
+    ComponentMask mask = 0;
+    for(ComponentMask bit : bits)
+        mask |= bit;
+    return mask;
+}
+
+// 实体句柄：编号 + 代数（编号被复用后旧句柄失效）
+struct Entity
+{
+    GLuint index;
+    GLuint generation;
+};
+
+const GLuint ENTITY_CHUNK_BYTES = 16 * 1024;
+
+// 一块实体：块头之后依次是实体句柄数组和各组件数组，每个数组按 16 字节对齐
+struct EntityChunk
+{
+    char* data;
+    GLuint count;
+    GLuint capacity;
+    const GLuint* offsets; // 各组件数组在 data 中的偏移（属于原型）
+
+    Entity* Entities() { return reinterpret_cast<Entity*>(this->data); }
+
+    template<typename T>
+    T* Array() { return reinterpret_cast<T*>(this->data + this->offsets[ComponentInfo<T>::Type]); }
+
+    char* Component(GLuint type, GLuint row) { return this->data + this->offsets[type] + size_t(row) * ComponentSize(type); }
+};
+
+struct EntityArchetype
+{
+    ComponentMask mask;
+    GLuint capacity; // 每块的实体数
+    GLuint offsets[COMPONENT_TYPE_COUNT];
+    std::vector<EntityChunk> chunks; // 除最后一块外都是满的
+};
+
+class EntityWorld
+{
+public:
+    EntityWorld() : count(0) { }
+
+    ~EntityWorld()
+    {
+        for(EntityArchetype* archetype : this->archetypes)
+        {
+            for(EntityChunk& chunk : archetype->chunks)
+                ::operator delete(chunk.data);
+            delete archetype;
+        }
+    }
+
+    // 创建实体，组件清零
+    Entity Create(ComponentMask mask)
+    {
+        GLuint index;
+        if(this->freeIndices.empty())
+        {
+            index = GLuint(this->records.size());
+            this->records.push_back(Record());
+            this->records.back().generation = 0;
+        }
+        else
+        {
+            index = this->freeIndices.back();
+            this->freeIndices.pop_back();
+        }
+        Record& record = this->records[index];
+        record.archetype = this->findArchetype(mask);
+        record.alive = true;
+        Entity entity = { index, record.generation };
+        this->append(record, entity);
+        EntityChunk& chunk = this->archetypes[record.archetype]->chunks[record.chunk];
+        for(GLuint type = 0; type < COMPONENT_TYPE_COUNT; type++)
+            if(mask & (1u << type))
+                std::memset(chunk.Component(type, record.row), 0, ComponentSize(type));
+        this->count++;
+        return entity;
+    }
+
+    // 创建实体并设置组件：world.Create(transform, meshRef, ...)
+    template<typename... Ts>
+    Entity Create(const Ts&... values)
+    {
+        Entity entity = this->Create(ComponentMaskOf<Ts...>());
+        int assign[] = { 0, (*this->Get<Ts>(entity) = values, 0)... };
+        (void)assign;
+        return entity;
+    }
+
+    void Destroy(Entity entity)
+    {
+        if(!this->Alive(entity))
+            return;
+        Record& record = this->records[entity.index];
+        this->removeRow(record);
+        record.alive = false;
+        record.generation++;
+        this->freeIndices.push_back(entity.index);
+        this->count--;
+    }
+
+    bool Alive(Entity entity) const
+    {
+        return entity.index < this->records.size() && this->records[entity.index].alive &&
+               this->records[entity.index].generation == entity.generation;
+    }
+
+    GLuint Count() const { return this->count; }
+
+    ComponentMask Mask(Entity entity) const
+    {
+        return this->Alive(entity) ? this->archetypes[this->records[entity.index].archetype]->mask : 0;
+    }
+
+    // 实体的组件，没有该组件时返回空指针
+    template<typename T>
+    T* Get(Entity entity)
+    {
+        if(!(this->Mask(entity) & ComponentBit<T>()))
+            return nullptr;
+        const Record& record = this->records[entity.index];
+        return reinterpret_cast<T*>(this->archetypes[record.archetype]->chunks[record.chunk].Component(ComponentInfo<T>::Type, record.row));
+    }
+
+    // 增减组件：实体移到新的原型，保留共有的组件
+    template<typename T>
+    void Add(Entity entity, const T& value)
+    {
+        if(!this->Alive(entity))
+            return;
+        this->changeArchetype(entity, this->Mask(entity) | ComponentBit<T>());
+        *this->Get<T>(entity) = value;
+    }
+
+    template<typename T>
+    void Remove(Entity entity)
+    {
+        if(this->Alive(entity))
+            this->changeArchetype(entity, this->Mask(entity) & ~ComponentBit<T>());
+    }
+
+    // 包含全部 Ts、不包含 exclude 中任何组件的块
+    template<typename... Ts>
+    std::vector<EntityChunk*> Chunks(ComponentMask exclude = 0)
+    {
+        ComponentMask mask = ComponentMaskOf<Ts...>();
+        std::vector<EntityChunk*> chunks;
+        for(EntityArchetype* archetype : this->archetypes)
+        {
+            if((archetype->mask & mask) != mask || (archetype->mask & exclude))
+                continue;
+            for(EntityChunk& chunk : archetype->chunks)
+                if(chunk.count > 0)
+                    chunks.push_back(&chunk);
+        }
+        return chunks;
+    }
+
+    // 逐块调用 func(count, Ts* ...)，顺序固定（原型创建顺序、块顺序、块内顺序）
+    template<typename... Ts, typename Func>
+    void ForEachChunk(Func func, ComponentMask exclude = 0)
+    {
+        for(EntityChunk* chunk : this->Chunks<Ts...>(exclude))
+            func(chunk->count, chunk->template Array<Ts>()...);
+    }
+
+    // 同上，块平均分给 threadCount 个线程（0 表示全部硬件线程）
+    template<typename... Ts, typename Func>
+    void ParallelForEachChunk(GLuint threadCount, Func func, ComponentMask exclude = 0)
+    {
+        std::vector<EntityChunk*> chunks = this->Chunks<Ts...>(exclude);
+        ParallelRanges(chunks.size(), WorkerCount(threadCount), [&](size_t begin, size_t end, GLuint)
+        {
+            for(size_t i = begin; i < end; i++)
+                func(chunks[i]->count, chunks[i]->template Array<Ts>()...);
+        });
+    }
+
+private:
+    struct Record
+    {
+        GLuint archetype, chunk, row;
+        GLuint generation;
+        bool alive;
+    };
+
+    EntityWorld(const EntityWorld&);
+    EntityWorld& operator=(const EntityWorld&);
+
+    std::vector<EntityArchetype*> archetypes;
+    std::vector<Record> records;
+    std::vector<GLuint> freeIndices;
+    GLuint count;
+
+    GLuint findArchetype(ComponentMask mask)
+    {
+        for(GLuint i = 0; i < this->archetypes.size(); i++)
+            if(this->archetypes[i]->mask == mask)
+                return i;
+
+        // 先按每个实体的总字节数估计容量，再扣掉对齐填充
+        EntityArchetype* archetype = new EntityArchetype();
+        archetype->mask = mask;
+        GLuint rowBytes = sizeof(Entity), arrays = 1;
+        for(GLuint type = 0; type < COMPONENT_TYPE_COUNT; type++)
+            if(mask & (1u << type))
+            {
+                rowBytes += ComponentSize(type);
+                arrays++;
+            }
+        archetype->capacity = std::max(1u, (ENTITY_CHUNK_BYTES - 16 * arrays) / rowBytes);
+        GLuint offset = (archetype->capacity * sizeof(Entity) + 15) & ~15u;
+        for(GLuint type = 0; type < COMPONENT_TYPE_COUNT; type++)
+        {
+            archetype->offsets[type] = offset;
+            if(mask & (1u << type))
+                offset = (offset + archetype->capacity * ComponentSize(type) + 15) & ~15u;
+        }
+        this->archetypes.push_back(archetype);
+        return GLuint(this->archetypes.size() - 1);
+    }
+
+    // 在原型的最后一块末尾分配一行
+    void append(Record& record, Entity entity)
+    {
+        EntityArchetype* archetype = this->archetypes[record.archetype];
+        if(archetype->chunks.empty() || archetype->chunks.back().count == archetype->capacity)
+        {
+            EntityChunk chunk;
+            chunk.data = static_cast<char*>(::operator new(ENTITY_CHUNK_BYTES));
+            chunk.count = 0;
+            chunk.capacity = archetype->capacity;
+            chunk.offsets = archetype->offsets;
+            archetype->chunks.push_back(chunk);
+        }
+        EntityChunk& chunk = archetype->chunks.back();
+        record.chunk = GLuint(archetype->chunks.size() - 1);
+        record.row = chunk.count++;
+        chunk.Entities()[record.row] = entity;
+    }
+
+    // 用原型的最后一个实体填补 record 所在的行
+    void removeRow(const Record& record)
+    {
+        EntityArchetype* archetype = this->archetypes[record.archetype];
+        EntityChunk& last = archetype->chunks.back();
+        EntityChunk& chunk = archetype->chunks[record.chunk];
+        GLuint lastRow = last.count - 1;
+        if(&chunk != &last || record.row != lastRow)
+        {
+            Entity moved = last.Entities()[lastRow];
+            chunk.Entities()[record.row] = moved;
+            for(GLuint type = 0; type < COMPONENT_TYPE_COUNT; type++)
+                if(archetype->mask & (1u << type))
+                    std::memcpy(chunk.Component(type, record.row), last.Component(type, lastRow), ComponentSize(type));
+            this->records[moved.index].chunk = record.chunk;
+            this->records[moved.index].row = record.row;
+        }
+        if(--last.count == 0)
+        {
+            ::operator delete(last.data);
+            archetype->chunks.pop_back();
+        }
+    }
+
+    void changeArchetype(Entity entity, ComponentMask mask)
+    {
+        Record& record = this->records[entity.index];
+        ComponentMask oldMask = this->archetypes[record.archetype]->mask;
+        if(mask == oldMask)
+            return;
+        Record old = record;
+        record.archetype = this->findArchetype(mask);
+        this->append(record, entity);
+        EntityChunk& from = this->archetypes[old.archetype]->chunks[old.chunk];
+        EntityChunk& to = this->archetypes[record.archetype]->chunks[record.chunk];
+        for(GLuint type = 0; type < COMPONENT_TYPE_COUNT; type++)
+        {
+            if(!(mask & (1u << type)))
+                continue;
+            if(oldMask & (1u << type))
+                std::memcpy(to.Component(type, record.row), from.Component(type, old.row), ComponentSize(type));
+            else
+                std::memset(to.Component(type, record.row), 0, ComponentSize(type));
+        }
+        this->removeRow(old);
+    }
+};
+
+// == ======================================
+// 系统
+// == ======================================
+
+// 声明读写的组件，RunSystems 据此决定哪些系统可以同时执行
+// run 的第二个参数是分给这个系统的线程数（传给 ParallelForEachChunk）
+struct EntitySystem
+{
+    const char* name;
+    ComponentMask reads;
+    ComponentMask writes;
+    std::function<void(EntityWorld&, GLuint)> run;
+};
+
+// 按顺序执行系统：相邻且读写不冲突的系统组成一个阶段，阶段内并行，阶段之间顺序执行
+// 同一阶段的 n 个系统各用 threadCount / n 个线程遍历块（至少 1 个），不会产生 threadCount² 个线程
+inline void RunSystems(EntityWorld& world, const std::vector<EntitySystem>& systems, GLuint threadCount)
+{
+    threadCount = WorkerCount(threadCount);
+    size_t begin = 0;
+    while(begin < systems.size())
+    {
+        size_t end = begin + 1;
+        ComponentMask reads = systems[begin].reads, writes = systems[begin].writes;
+        while(end < systems.size() && !(systems[end].writes & (reads | writes)) && !(systems[end].reads & writes))
+        {
+            reads |= systems[end].reads;
+            writes |= systems[end].writes;
+            end++;
+        }
+        GLuint stageSize = GLuint(end - begin);
+        GLuint systemThreads = std::max(1u, threadCount / stageSize);
+        ParallelTasks(stageSize, threadCount, [&](size_t i)
+        {
+            systems[begin + i].run(world, systemThreads);
+        });
+        begin = end;
+    }
+}
+
+// 旋转：angle += speed * deltaTime
+inline void SpinSystem(EntityWorld& world, GLfloat deltaTime, GLuint threadCount)
+{
+    world.ParallelForEachChunk<Transform, Spin>(threadCount, [deltaTime](GLuint count, Transform* transforms, Spin* spins)
+    {
+        for(GLuint i = 0; i < count; i++)
+            transforms[i].angle += spins[i].speed * deltaTime;
+    });
+}
+
+// 由 Transform 计算模型矩阵
+// 与案例中的写法相同：先平移，再旋转，再缩放
+inline void WorldMatrixSystem(EntityWorld& world, GLuint threadCount)
+{
+    world.ParallelForEachChunk<Transform, WorldMatrix>(threadCount, [](GLuint count, Transform* transforms, WorldMatrix* matrices)
+    {
+        for(GLuint i = 0; i < count; i++)
+        {
+            const Transform& transform = transforms[i];
+            glm::mat4 model;
+            model = glm::translate(model, transform.position);
+            model = glm::rotate(model, transform.angle, transform.axis);
+            model = glm::scale(model, glm::vec3(transform.scale));
+            matrices[i].model = model;
+        }
+    });
+}
+
+// 由 Transform 和网格半径计算世界空间包围球
+inline void BoundsSystem(EntityWorld& world, GLuint threadCount)
+{
+    world.ParallelForEachChunk<Transform, MeshRef, Bounds>(threadCount, [](GLuint count, Transform* transforms, MeshRef* meshes, Bounds* bounds)
+    {
+        for(GLuint i = 0; i < count; i++)
+        {
+            bounds[i].center = transforms[i].position;
+            bounds[i].radius = meshes[i].radius * transforms[i].scale;
+        }
+    });
+}
+
+inline void TransformSystem(EntityWorld& world, GLuint threadCount)
+{
+    WorldMatrixSystem(world, threadCount);
+    BoundsSystem(world, threadCount);
+}
+
+// 以上系统的 EntitySystem 描述，交给 RunSystems 调度：
+// 旋转写 Transform，单独一个阶段；矩阵和包围球都只读 Transform，在同一阶段并行
+inline std::vector<EntitySystem> TransformSystems(bool spin = false, GLfloat deltaTime = 0.0f)
+{
+    std::vector<EntitySystem> systems;
+    if(spin)
+    {
+        EntitySystem spinSystem = { "Spin", ComponentMaskOf<Transform, Spin>(), ComponentMaskOf<Transform>(),
+                                    [deltaTime](EntityWorld& world, GLuint threads) { SpinSystem(world, deltaTime, threads); } };
+        systems.push_back(spinSystem);
+    }
+    EntitySystem matrixSystem = { "WorldMatrix", ComponentMaskOf<Transform>(), ComponentMaskOf<WorldMatrix>(), WorldMatrixSystem };
+    EntitySystem boundsSystem = { "Bounds", ComponentMaskOf<Transform, MeshRef>(), ComponentMaskOf<Bounds>(), BoundsSystem };
+    systems.push_back(matrixSystem);
+    systems.push_back(boundsSystem);
+    return systems;
+}
+
+// 收集世界中的灯光（传给 LightAssigner 等）
+inline std::vector<PointLight> CollectPointLights(EntityWorld& world)
+{
+    std::vector<PointLight> lights;
+    world.ForEachChunk<PointLight>([&](GLuint count, PointLight* chunkLights)
+    {
+        lights.insert(lights.end(), chunkLights, chunkLights + count);
+    });
+    return lights;
+}
+
+inline std::vector<SpotLight> CollectSpotLights(EntityWorld& world)
+{
+    std::vector<SpotLight> lights;
+    world.ForEachChunk<SpotLight>([&](GLuint count, SpotLight* chunkLights)
+    {
+        lights.insert(lights.end(), chunkLights, chunkLights + count);
+    });
+    return lights;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef FRAME_INVALIDATION_H
+#define FRAME_INVALIDATION_H
+
+#include <atomic>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// == ======================================
+// 按需渲染
+// 摄像机、灯光和物体都静止时，每帧画出来的都是同一张图。
+// 输入回调、摄像机移动、动画和资源载入完成时标记"脏"，主循环只在有脏标记时才绘制和交换缓冲；
+// 没有脏标记时阻塞在 glfwWaitEventsTimeout 中，CPU/GPU 都空闲下来。
+// 其他线程（如资源载入线程）用 InvalidateFromThread 标记，同时用空事件唤醒主线程。
+// 用法：
+//     while(...)
+//     {
+//         invalidator.WaitEvents();
+//         ... 处理输入，摄像机移动了就 Invalidate(DIRTY_CAMERA)
+//         if(!invalidator.ConsumeDirty())
+//             continue;
+//         ... 绘制、交换缓冲
+//     }
+// == ======================================
+
+enum DirtyReason
+{
+    DIRTY_INPUT     = 1,
+    DIRTY_CAMERA    = 2,
+    DIRTY_ANIMATION = 4,
+    DIRTY_ASSET     = 8,
+    DIRTY_WINDOW    = 16, // 窗口重绘、尺寸改变
+    DIRTY_ALL       = 0xFF
+};
+
+class FrameInvalidator
+{
+public:
+    GLdouble IdleTimeout; // 秒，没有事件时最多阻塞多久（超时后仍不绘制，只是回到主循环）
+    bool     OnDemand;    // 关闭时每帧都绘制（原来的连续渲染）
+
+    FrameInvalidator(GLdouble idleTimeout = 0.5)
+        : IdleTimeout(idleTimeout), OnDemand(true), dirty(DIRTY_ALL), animations(0), waited(false),
+          renderedFrames(0), skippedFrames(0) { }
+
+    // 主线程中标记（回调函数、摄像机移动等）
+    void Invalidate(GLuint reasons)
+    {
+        this->dirty.fetch_or(reasons);
+    }
+
+    // 其他线程中标记，并唤醒阻塞在等待中的主线程
+    void InvalidateFromThread(GLuint reasons)
+    {
+        this->dirty.fetch_or(reasons);
+        glfwPostEmptyEvent();
+    }
+
+    // 动画开始/结束：有动画在播放时每帧都是脏的
+    void BeginAnimation() { this->animations++; }
+    void EndAnimation()   { if(this->animations > 0) this->animations--; }
+
+    // 处理事件：有脏标记或动画时只轮询，否则阻塞等待
+    void WaitEvents()
+    {
+        this->waited = this->OnDemand && this->animations == 0 && this->dirty.load() == 0;
+        if(this->waited)
+            glfwWaitEventsTimeout(this->IdleTimeout);
+        else
+            glfwPollEvents();
+    }
+
+    // 上一次 WaitEvents 是否阻塞过（阻塞后的 deltaTime 包含空闲时间，不能用来移动摄像机）
+    bool Waited() const { return this->waited; }
+
+    // 本帧是否需要绘制，同时清除脏标记
+    bool ConsumeDirty()
+    {
+        bool draw = !this->OnDemand || this->animations > 0;
+        draw = (this->dirty.exchange(0) != 0) || draw;
+        if(draw)
+            this->renderedFrames++;
+        else
+            this->skippedFrames++;
+        return draw;
+    }
+
+    GLuint64 RenderedFrames() const { return this->renderedFrames; }
+    GLuint64 SkippedFrames() const { return this->skippedFrames; }
+
+private:
+    std::atomic<GLuint> dirty;
+    GLuint animations;
+    bool   waited;
+    GLuint64 renderedFrames, skippedFrames;
+};
+
+#endif
@@ -0,0 +1,1505 @@
+#ifndef GL_CAPTURE_H
+#define GL_CAPTURE_H
+
+#include <set>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <functional>
+
+#include <GL/glew.h>
+
+// == ======================================
+// GL 命令录制与回放
+// 复现性能问题时不用再手动飞摄像机：录下若干帧的 GL 调用（连同缓冲和贴图数据）写成一个二进制文件，
+// 再用 tools/gl_replay 在一个紧凑的循环里反复提交，只剩驱动和 GPU 的开销。
+// 录制层需要在编译时打开：定义 GL_CAPTURE，并在 #include <GL/glew.h> 之后紧接着包含本文件，
+// 之后的 glXxx 调用被宏替换为 CaptureXxx（先调用真正的函数，再记录）。
+// 文件分三段：
+// 1. setup：从启动起一直记录的资源调用（生成/删除对象、缓冲和贴图数据、着色器、VAO/FBO 设置），
+//    绑定只在资源调用需要时补记，每帧的绑定和绘制不进入这一段，内存不会随帧数增长；
+// 2. state：开始录制时用 glGet 读回的状态（各纹理单元、VAO、FBO、程序、开关、视口）和所有程序的 uniform 值；
+// 3. frames：录制期间的全部调用，每帧以 CAP_FRAME_END 结尾。
+// 回放时 setup 只执行一次，之后每轮先恢复 state 再执行 frames。对象名和 uniform 位置在回放时重新映射。
+// 不录制查询、glGet 和 glFinish；录制期间新建的对象在每轮回放中复用同一个对象。
+// == ======================================
+
+namespace gl_capture_detail
+{
+    typedef std::vector<unsigned char> Stream;
+
+    const GLuint CAPTURE_MAGIC   = 0x50434C47; // "GLCP"
+    const GLuint CAPTURE_VERSION = 1;
+
+    struct CaptureHeader
+    {
+        GLuint magic;
+        GLuint version;
+        GLuint width, height; // 开始录制时的视口
+        GLuint frameCount;
+        GLuint reserved;
+        GLuint64 setupSize, stateSize, framesSize;
+    };
+
+    // 对象名空间
+    enum NameSpace
+    {
+        NS_BUFFER, NS_TEXTURE, NS_VERTEX_ARRAY, NS_FRAMEBUFFER, NS_RENDERBUFFER, NS_SHADER, NS_PROGRAM, NS_COUNT
+    };
+
+    enum Opcode
+    {
+        CAP_GEN = 1, CAP_DELETE,
+        CAP_CREATE_SHADER, CAP_SHADER_SOURCE, CAP_COMPILE_SHADER, CAP_CREATE_PROGRAM, CAP_ATTACH_SHADER, CAP_LINK_PROGRAM,
+        CAP_DELETE_SHADER, CAP_DELETE_PROGRAM, CAP_GET_UNIFORM_LOCATION,
+        CAP_BIND_BUFFER, CAP_BUFFER_DATA,
+        CAP_ACTIVE_TEXTURE, CAP_BIND_TEXTURE, CAP_TEX_IMAGE_2D, CAP_TEX_IMAGE_3D, CAP_TEX_SUB_IMAGE_3D,
+        CAP_TEX_PARAMETER_I, CAP_TEX_PARAMETER_FV, CAP_GENERATE_MIPMAP, CAP_PIXEL_STORE_I,
+        CAP_BIND_VERTEX_ARRAY, CAP_VERTEX_ATTRIB_POINTER, CAP_ENABLE_VERTEX_ATTRIB_ARRAY,
+        CAP_BIND_FRAMEBUFFER, CAP_FRAMEBUFFER_TEXTURE_2D, CAP_FRAMEBUFFER_TEXTURE_LAYER, CAP_FRAMEBUFFER_RENDERBUFFER,
+        CAP_BIND_RENDERBUFFER, CAP_RENDERBUFFER_STORAGE, CAP_DRAW_BUFFER, CAP_READ_BUFFER,
+        CAP_USE_PROGRAM, CAP_UNIFORM_1F, CAP_UNIFORM_1I, CAP_UNIFORM_3F, CAP_UNIFORM_3FV, CAP_UNIFORM_4FV, CAP_UNIFORM_MATRIX_4FV,
+        CAP_SET_UNIFORM, // state 段：按名字设置 uniform
+        CAP_ENABLE, CAP_DISABLE, CAP_DEPTH_FUNC, CAP_DEPTH_MASK, CAP_COLOR_MASK, CAP_CLEAR_COLOR, CAP_CLEAR, CAP_VIEWPORT,
+        CAP_POLYGON_MODE, CAP_POLYGON_OFFSET,
+        CAP_DRAW_ARRAYS, CAP_DRAW_ELEMENTS, CAP_DRAW_ELEMENTS_BASE_VERTEX, CAP_BLIT_FRAMEBUFFER,
+        CAP_FRAME_END
+    };
+
+    template<typename T>
+    inline void Put(Stream& out, T value)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    inline void PutAll(Stream&) { }
+
+    template<typename T, typename... Rest>
+    inline void PutAll(Stream& out, T value, Rest... rest)
+    {
+        Put(out, value);
+        PutAll(out, rest...);
+    }
+
+    // 长度（64位）+ 数据；data 为空时只写长度 0
+    inline void PutBytes(Stream& out, const void* data, size_t size)
+    {
+        Put(out, GLuint64(data ? size : 0));
+        if(data && size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+    }
+
+    inline void PutString(Stream& out, const std::string& text)
+    {
+        PutBytes(out, text.data(), text.size());
+    }
+
+    // 按格式和类型计算一个像素的字节数
+    inline size_t PixelBytes(GLenum format, GLenum type)
+    {
+        size_t components = 4;
+        switch(format)
+        {
+        case GL_RED: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: case GL_DEPTH_STENCIL: components = 1; break;
+        case GL_RG: components = 2; break;
+        case GL_RGB: case GL_BGR: components = 3; break;
+        default: components = 4; break;
+        }
+        switch(type)
+        {
+        case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+        case GL_UNSIGNED_INT_24_8: return 4;
+        default: return components * 4; // GL_FLOAT、GL_UNSIGNED_INT、GL_INT
+        }
+    }
+
+    // 贴图数据的字节数（按 GL_UNPACK_ALIGNMENT 对齐每行，最后一行不补齐）
+    inline size_t ImageBytes(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, GLint alignment)
+    {
+        if(width <= 0 || height <= 0 || depth <= 0)
+            return 0;
+        size_t row = size_t(width) * PixelBytes(format, type);
+        size_t stride = (row + alignment - 1) / alignment * alignment;
+        return stride * (size_t(height) * depth - 1) + row;
+    }
+
+    // 顺序读取录制流，越界时标记失败并返回零值
+    class Reader
+    {
+    public:
+        Reader(const unsigned char* data, size_t size) : data(data), size(size), offset(0), failed(false) { }
+
+        bool AtEnd() const { return this->offset >= this->size || this->failed; }
+        bool Failed() const { return this->failed; }
+
+        template<typename T>
+        T Get()
+        {
+            T value = T();
+            if(this->offset + sizeof(T) > this->size)
+            {
+                this->failed = true;
+                return value;
+            }
+            std::memcpy(&value, this->data + this->offset, sizeof(T));
+            this->offset += sizeof(T);
+            return value;
+        }
+
+        // 返回数据指针（长度为 0 时返回 NULL），不复制
+        const void* GetBytes(size_t& length)
+        {
+            length = size_t(this->Get<GLuint64>());
+            if(length == 0 || this->offset + length > this->size)
+            {
+                if(length)
+                    this->failed = true;
+                length = 0;
+                return NULL;
+            }
+            const void* bytes = this->data + this->offset;
+            this->offset += length;
+            return bytes;
+        }
+
+        std::string GetString()
+        {
+            size_t length;
+            const char* text = static_cast<const char*>(this->GetBytes(length));
+            return text ? std::string(text, length) : std::string();
+        }
+
+    private:
+        const unsigned char* data;
+        size_t size, offset;
+        bool failed;
+    };
+}
+
+// == ======================================
+// 回放
+// == ======================================
+class GLCaptureReplay
+{
+public:
+    GLCaptureReplay() : currentProgram(0), inFrames(false)
+    {
+        std::memset(&this->header, 0, sizeof(this->header));
+    }
+
+    bool Load(const std::string& path)
+    {
+        using namespace gl_capture_detail;
+        std::ifstream file(path.c_str(), std::ios::binary);
+        if(!file || !file.read(reinterpret_cast<char*>(&this->header), sizeof(this->header)) ||
+           this->header.magic != CAPTURE_MAGIC || this->header.version != CAPTURE_VERSION)
+        {
+            std::cout << "ERROR::GL_CAPTURE:: not a capture file " << path << std::endl;
+            return false;
+        }
+        this->setup.resize(size_t(this->header.setupSize));
+        this->state.resize(size_t(this->header.stateSize));
+        this->frames.resize(size_t(this->header.framesSize));
+        if(!readStream(file, this->setup) || !readStream(file, this->state) || !readStream(file, this->frames))
+        {
+            std::cout << "ERROR::GL_CAPTURE:: truncated capture file " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    GLuint Width() const { return this->header.width; }
+    GLuint Height() const { return this->header.height; }
+    GLuint FrameCount() const { return this->header.frameCount; }
+
+    // 重建资源，只调用一次
+    bool ReplaySetup()
+    {
+        this->inFrames = false;
+        return this->execute(this->setup, std::function<void()>());
+    }
+
+    // 恢复录制开始时的状态并执行所有帧，每帧结束时调用 onFrameEnd（例如交换缓冲）
+    bool ReplayFrames(const std::function<void()>& onFrameEnd)
+    {
+        this->inFrames = false;
+        if(!this->execute(this->state, std::function<void()>()))
+            return false;
+        this->inFrames = true;
+        return this->execute(this->frames, onFrameEnd);
+    }
+
+private:
+    gl_capture_detail::CaptureHeader header;
+    gl_capture_detail::Stream setup, state, frames;
+    std::map<GLuint, GLuint> names[gl_capture_detail::NS_COUNT];
+    std::map<std::pair<GLuint, GLint>, GLint> locations; // (录制时的程序, 录制时的位置) -> 回放时的位置
+    GLuint currentProgram; // 录制时的程序名
+    bool inFrames;
+
+    static bool readStream(std::ifstream& file, gl_capture_detail::Stream& stream)
+    {
+        return stream.empty() || bool(file.read(reinterpret_cast<char*>(&stream[0]), stream.size()));
+    }
+
+    GLuint name(GLuint space, GLuint captured) const
+    {
+        if(captured == 0)
+            return 0;
+        std::map<GLuint, GLuint>::const_iterator it = this->names[space].find(captured);
+        return it != this->names[space].end() ? it->second : captured;
+    }
+
+    GLint location(GLint captured) const
+    {
+        if(captured < 0)
+            return captured;
+        std::map<std::pair<GLuint, GLint>, GLint>::const_iterator it = this->locations.find(std::make_pair(this->currentProgram, captured));
+        return it != this->locations.end() ? it->second : captured;
+    }
+
+    void gen(GLuint space, GLsizei count, const GLuint* captured)
+    {
+        for(GLsizei i = 0; i < count; i++)
+        {
+            // 帧内新建的对象在每轮回放中复用
+            if(this->inFrames && this->names[space].count(captured[i]))
+                continue;
+            GLuint object = 0;
+            switch(space)
+            {
+            case gl_capture_detail::NS_BUFFER:       glGenBuffers(1, &object); break;
+            case gl_capture_detail::NS_TEXTURE:      glGenTextures(1, &object); break;
+            case gl_capture_detail::NS_VERTEX_ARRAY: glGenVertexArrays(1, &object); break;
+            case gl_capture_detail::NS_FRAMEBUFFER:  glGenFramebuffers(1, &object); break;
+            case gl_capture_detail::NS_RENDERBUFFER: glGenRenderbuffers(1, &object); break;
+            }
+            this->names[space][captured[i]] = object;
+        }
+    }
+
+    void remove(GLuint space, GLsizei count, const GLuint* captured)
+    {
+        if(this->inFrames)
+            return;
+        for(GLsizei i = 0; i < count; i++)
+        {
+            GLuint object = this->name(space, captured[i]);
+            switch(space)
+            {
+            case gl_capture_detail::NS_BUFFER:       glDeleteBuffers(1, &object); break;
+            case gl_capture_detail::NS_TEXTURE:      glDeleteTextures(1, &object); break;
+            case gl_capture_detail::NS_VERTEX_ARRAY: glDeleteVertexArrays(1, &object); break;
+            case gl_capture_detail::NS_FRAMEBUFFER:  glDeleteFramebuffers(1, &object); break;
+            case gl_capture_detail::NS_RENDERBUFFER: glDeleteRenderbuffers(1, &object); break;
+            }
+            this->names[space].erase(captured[i]);
+        }
+    }
+
+    // 按 uniform 类型设置（state 段，值总是按 16 个 4 字节存放）
+    static void setUniform(GLint loc, GLenum type, const GLfloat* f, const GLint* i)
+    {
+        switch(type)
+        {
+        case GL_FLOAT:      glUniform1fv(loc, 1, f); break;
+        case GL_FLOAT_VEC2: glUniform2fv(loc, 1, f); break;
+        case GL_FLOAT_VEC3: glUniform3fv(loc, 1, f); break;
+        case GL_FLOAT_VEC4: glUniform4fv(loc, 1, f); break;
+        case GL_FLOAT_MAT3: glUniformMatrix3fv(loc, 1, GL_FALSE, f); break;
+        case GL_FLOAT_MAT4: glUniformMatrix4fv(loc, 1, GL_FALSE, f); break;
+        case GL_INT_VEC2:   glUniform2iv(loc, 1, i); break;
+        case GL_INT_VEC3:   glUniform3iv(loc, 1, i); break;
+        case GL_INT_VEC4:   glUniform4iv(loc, 1, i); break;
+        default:            glUniform1iv(loc, 1, i); break; // int、bool、采样器
+        }
+    }
+
+    bool execute(const gl_capture_detail::Stream& stream, const std::function<void()>& onFrameEnd)
+    {
+        using namespace gl_capture_detail;
+        if(stream.empty())
+            return true;
+        Reader in(&stream[0], stream.size());
+        size_t length;
+        while(!in.AtEnd())
+        {
+            unsigned char op = in.Get<unsigned char>();
+            switch(op)
+            {
+            case CAP_GEN:
+            case CAP_DELETE:
+            {
+                unsigned char space = in.Get<unsigned char>();
+                GLsizei count = in.Get<GLsizei>();
+                std::vector<GLuint> captured(std::max(count, 0));
+                for(GLsizei i = 0; i < count; i++)
+                    captured[i] = in.Get<GLuint>();
+                if(space >= NS_COUNT)
+                    return this->corrupt();
+                if(op == CAP_GEN)
+                    this->gen(space, count, captured.data());
+                else
+                    this->remove(space, count, captured.data());
+                break;
+            }
+            case CAP_CREATE_SHADER:
+            {
+                GLenum type = in.Get<GLenum>();
+                GLuint captured = in.Get<GLuint>();
+                if(!this->inFrames || !this->names[NS_SHADER].count(captured))
+                    this->names[NS_SHADER][captured] = glCreateShader(type);
+                break;
+            }
+            case CAP_SHADER_SOURCE:
+            {
+                GLuint shader = this->name(NS_SHADER, in.Get<GLuint>());
+                std::string source = in.GetString();
+                const GLchar* text = source.c_str();
+                GLint size = GLint(source.size());
+                glShaderSource(shader, 1, &text, &size);
+                break;
+            }
+            case CAP_COMPILE_SHADER: glCompileShader(this->name(NS_SHADER, in.Get<GLuint>())); break;
+            case CAP_CREATE_PROGRAM:
+            {
+                GLuint captured = in.Get<GLuint>();
+                if(!this->inFrames || !this->names[NS_PROGRAM].count(captured))
+                    this->names[NS_PROGRAM][captured] = glCreateProgram();
+                break;
+            }
+            case CAP_ATTACH_SHADER:
+            {
+                GLuint program = this->name(NS_PROGRAM, in.Get<GLuint>());
+                glAttachShader(program, this->name(NS_SHADER, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_LINK_PROGRAM: glLinkProgram(this->name(NS_PROGRAM, in.Get<GLuint>())); break;
+            case CAP_DELETE_SHADER:
+            {
+                GLuint captured = in.Get<GLuint>();
+                if(!this->inFrames)
+                {
+                    glDeleteShader(this->name(NS_SHADER, captured));
+                    this->names[NS_SHADER].erase(captured);
+                }
+                break;
+            }
+            case CAP_DELETE_PROGRAM:
+            {
+                GLuint captured = in.Get<GLuint>();
+                if(!this->inFrames)
+                {
+                    glDeleteProgram(this->name(NS_PROGRAM, captured));
+                    this->names[NS_PROGRAM].erase(captured);
+                }
+                break;
+            }
+            case CAP_GET_UNIFORM_LOCATION:
+            {
+                GLuint program = in.Get<GLuint>();
+                std::string uniform = in.GetString();
+                GLint captured = in.Get<GLint>();
+                this->locations[std::make_pair(program, captured)] = glGetUniformLocation(this->name(NS_PROGRAM, program), uniform.c_str());
+                break;
+            }
+            case CAP_BIND_BUFFER:
+            {
+                GLenum target = in.Get<GLenum>();
+                glBindBuffer(target, this->name(NS_BUFFER, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_BUFFER_DATA:
+            {
+                GLenum target = in.Get<GLenum>();
+                GLuint64 size = in.Get<GLuint64>();
+                GLenum usage = in.Get<GLenum>();
+                const void* data = in.GetBytes(length);
+                glBufferData(target, GLsizeiptr(size), data, usage);
+                break;
+            }
+            case CAP_ACTIVE_TEXTURE: glActiveTexture(in.Get<GLenum>()); break;
+            case CAP_BIND_TEXTURE:
+            {
+                GLenum target = in.Get<GLenum>();
+                glBindTexture(target, this->name(NS_TEXTURE, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_TEX_IMAGE_2D:
+            {
+                GLenum target = in.Get<GLenum>();
+                GLint level = in.Get<GLint>(), internalFormat = in.Get<GLint>();
+                GLsizei width = in.Get<GLsizei>(), height = in.Get<GLsizei>();
+                GLint border = in.Get<GLint>();
+                GLenum format = in.Get<GLenum>(), type = in.Get<GLenum>();
+                const void* pixels = in.GetBytes(length);
+                glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+                break;
+            }
+            case CAP_TEX_IMAGE_3D:
+            {
+                GLenum target = in.Get<GLenum>();
+                GLint level = in.Get<GLint>(), internalFormat = in.Get<GLint>();
+                GLsizei width = in.Get<GLsizei>(), height = in.Get<GLsizei>(), depth = in.Get<GLsizei>();
+                GLint border = in.Get<GLint>();
+                GLenum format = in.Get<GLenum>(), type = in.Get<GLenum>();
+                const void* pixels = in.GetBytes(length);
+                glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+                break;
+            }
+            case CAP_TEX_SUB_IMAGE_3D:
+            {
+                GLenum target = in.Get<GLenum>();
+                GLint level = in.Get<GLint>(), x = in.Get<GLint>(), y = in.Get<GLint>(), z = in.Get<GLint>();
+                GLsizei width = in.Get<GLsizei>(), height = in.Get<GLsizei>(), depth = in.Get<GLsizei>();
+                GLenum format = in.Get<GLenum>(), type = in.Get<GLenum>();
+                const void* pixels = in.GetBytes(length);
+                glTexSubImage3D(target, level, x, y, z, width, height, depth, format, type, pixels);
+                break;
+            }
+            case CAP_TEX_PARAMETER_I:
+            {
+                GLenum target = in.Get<GLenum>(), pname = in.Get<GLenum>();
+                glTexParameteri(target, pname, in.Get<GLint>());
+                break;
+            }
+            case CAP_TEX_PARAMETER_FV:
+            {
+                GLenum target = in.Get<GLenum>(), pname = in.Get<GLenum>();
+                GLfloat values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                const void* data = in.GetBytes(length);
+                std::memcpy(values, data, std::min(length, sizeof(values)));
+                glTexParameterfv(target, pname, values);
+                break;
+            }
+            case CAP_GENERATE_MIPMAP: glGenerateMipmap(in.Get<GLenum>()); break;
+            case CAP_PIXEL_STORE_I:
+            {
+                GLenum pname = in.Get<GLenum>();
+                glPixelStorei(pname, in.Get<GLint>());
+                break;
+            }
+            case CAP_BIND_VERTEX_ARRAY: glBindVertexArray(this->name(NS_VERTEX_ARRAY, in.Get<GLuint>())); break;
+            case CAP_VERTEX_ATTRIB_POINTER:
+            {
+                GLuint index = in.Get<GLuint>();
+                GLint size = in.Get<GLint>();
+                GLenum type = in.Get<GLenum>();
+                GLboolean normalized = in.Get<GLboolean>();
+                GLsizei stride = in.Get<GLsizei>();
+                GLuint64 offset = in.Get<GLuint64>();
+                glVertexAttribPointer(index, size, type, normalized, stride, (GLvoid*)(size_t)offset);
+                break;
+            }
+            case CAP_ENABLE_VERTEX_ATTRIB_ARRAY: glEnableVertexAttribArray(in.Get<GLuint>()); break;
+            case CAP_BIND_FRAMEBUFFER:
+            {
+                GLenum target = in.Get<GLenum>();
+                glBindFramebuffer(target, this->name(NS_FRAMEBUFFER, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_FRAMEBUFFER_TEXTURE_2D:
+            {
+                GLenum target = in.Get<GLenum>(), attachment = in.Get<GLenum>(), textarget = in.Get<GLenum>();
+                GLuint texture = this->name(NS_TEXTURE, in.Get<GLuint>());
+                glFramebufferTexture2D(target, attachment, textarget, texture, in.Get<GLint>());
+                break;
+            }
+            case CAP_FRAMEBUFFER_TEXTURE_LAYER:
+            {
+                GLenum target = in.Get<GLenum>(), attachment = in.Get<GLenum>();
+                GLuint texture = this->name(NS_TEXTURE, in.Get<GLuint>());
+                GLint level = in.Get<GLint>();
+                glFramebufferTextureLayer(target, attachment, texture, level, in.Get<GLint>());
+                break;
+            }
+            case CAP_FRAMEBUFFER_RENDERBUFFER:
+            {
+                GLenum target = in.Get<GLenum>(), attachment = in.Get<GLenum>(), renderbufferTarget = in.Get<GLenum>();
+                glFramebufferRenderbuffer(target, attachment, renderbufferTarget, this->name(NS_RENDERBUFFER, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_BIND_RENDERBUFFER:
+            {
+                GLenum target = in.Get<GLenum>();
+                glBindRenderbuffer(target, this->name(NS_RENDERBUFFER, in.Get<GLuint>()));
+                break;
+            }
+            case CAP_RENDERBUFFER_STORAGE:
+            {
+                GLenum target = in.Get<GLenum>(), internalFormat = in.Get<GLenum>();
+                GLsizei width = in.Get<GLsizei>();
+                glRenderbufferStorage(target, internalFormat, width, in.Get<GLsizei>());
+                break;
+            }
+            case CAP_DRAW_BUFFER: glDrawBuffer(in.Get<GLenum>()); break;
+            case CAP_READ_BUFFER: glReadBuffer(in.Get<GLenum>()); break;
+            case CAP_USE_PROGRAM:
+                this->currentProgram = in.Get<GLuint>();
+                glUseProgram(this->name(NS_PROGRAM, this->currentProgram));
+                break;
+            case CAP_UNIFORM_1F:
+            {
+                GLint loc = this->location(in.Get<GLint>());
+                glUniform1f(loc, in.Get<GLfloat>());
+                break;
+            }
+            case CAP_UNIFORM_1I:
+            {
+                GLint loc = this->location(in.Get<GLint>());
+                glUniform1i(loc, in.Get<GLint>());
+                break;
+            }
+            case CAP_UNIFORM_3F:
+            {
+                GLint loc = this->location(in.Get<GLint>());
+                GLfloat x = in.Get<GLfloat>(), y = in.Get<GLfloat>(), z = in.Get<GLfloat>();
+                glUniform3f(loc, x, y, z);
+                break;
+            }
+            case CAP_UNIFORM_3FV:
+            case CAP_UNIFORM_4FV:
+            case CAP_UNIFORM_MATRIX_4FV:
+            {
+                GLint loc = this->location(in.Get<GLint>());
+                GLsizei count = in.Get<GLsizei>();
+                GLboolean transpose = in.Get<GLboolean>();
+                const GLfloat* values = static_cast<const GLfloat*>(in.GetBytes(length));
+                if(!values)
+                    break;
+                if(op == CAP_UNIFORM_3FV)
+                    glUniform3fv(loc, count, values);
+                else if(op == CAP_UNIFORM_4FV)
+                    glUniform4fv(loc, count, values);
+                else
+                    glUniformMatrix4fv(loc, count, transpose, values);
+                break;
+            }
+            case CAP_SET_UNIFORM:
+            {
+                GLuint program = this->name(NS_PROGRAM, in.Get<GLuint>());
+                std::string uniform = in.GetString();
+                GLenum type = in.Get<GLenum>();
+                GLfloat f[16];
+                GLint i[16];
+                const void* data = in.GetBytes(length);
+                if(!data || length != sizeof(f))
+                    break;
+                std::memcpy(f, data, sizeof(f));
+                std::memcpy(i, data, sizeof(i));
+                glUseProgram(program);
+                setUniform(glGetUniformLocation(program, uniform.c_str()), type, f, i);
+                break;
+            }
+            case CAP_ENABLE: glEnable(in.Get<GLenum>()); break;
+            case CAP_DISABLE: glDisable(in.Get<GLenum>()); break;
+            case CAP_DEPTH_FUNC: glDepthFunc(in.Get<GLenum>()); break;
+            case CAP_DEPTH_MASK: glDepthMask(in.Get<GLboolean>()); break;
+            case CAP_COLOR_MASK:
+            {
+                GLboolean r = in.Get<GLboolean>(), g = in.Get<GLboolean>(), b = in.Get<GLboolean>(), a = in.Get<GLboolean>();
+                glColorMask(r, g, b, a);
+                break;
+            }
+            case CAP_CLEAR_COLOR:
+            {
+                GLfloat r = in.Get<GLfloat>(), g = in.Get<GLfloat>(), b = in.Get<GLfloat>(), a = in.Get<GLfloat>();
+                glClearColor(r, g, b, a);
+                break;
+            }
+            case CAP_CLEAR: glClear(in.Get<GLbitfield>()); break;
+            case CAP_VIEWPORT:
+            {
+                GLint x = in.Get<GLint>(), y = in.Get<GLint>();
+                GLsizei width = in.Get<GLsizei>(), height = in.Get<GLsizei>();
+                glViewport(x, y, width, height);
+                break;
+            }
+            case CAP_POLYGON_MODE:
+            {
+                GLenum face = in.Get<GLenum>();
+                glPolygonMode(face, in.Get<GLenum>());
+                break;
+            }
+            case CAP_POLYGON_OFFSET:
+            {
+                GLfloat factor = in.Get<GLfloat>();
+                glPolygonOffset(factor, in.Get<GLfloat>());
+                break;
+            }
+            case CAP_DRAW_ARRAYS:
+            {
+                GLenum mode = in.Get<GLenum>();
+                GLint first = in.Get<GLint>();
+                glDrawArrays(mode, first, in.Get<GLsizei>());
+                break;
+            }
+            case CAP_DRAW_ELEMENTS:
+            case CAP_DRAW_ELEMENTS_BASE_VERTEX:
+            {
+                GLenum mode = in.Get<GLenum>();
+                GLsizei count = in.Get<GLsizei>();
+                GLenum type = in.Get<GLenum>();
+                GLvoid* offset = (GLvoid*)(size_t)in.Get<GLuint64>();
+                if(op == CAP_DRAW_ELEMENTS)
+                    glDrawElements(mode, count, type, offset);
+                else
+                    glDrawElementsBaseVertex(mode, count, type, offset, in.Get<GLint>());
+                break;
+            }
+            case CAP_BLIT_FRAMEBUFFER:
+            {
+                GLint v[8];
+                for(GLuint k = 0; k < 8; k++)
+                    v[k] = in.Get<GLint>();
+                GLbitfield mask = in.Get<GLbitfield>();
+                glBlitFramebuffer(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], mask, in.Get<GLenum>());
+                break;
+            }
+            case CAP_FRAME_END:
+                if(onFrameEnd)
+                    onFrameEnd();
+                break;
+            default:
+                return this->corrupt();
+            }
+        }
+        return in.Failed() ? this->corrupt() : true;
+    }
+
+    bool corrupt()
+    {
+        std::cout << "ERROR::GL_CAPTURE:: corrupt command stream" << std::endl;
+        return false;
+    }
+};
+
+#ifdef GL_CAPTURE
+
+// == ======================================
+// 录制
+// == ======================================
+namespace gl_capture_detail
+{
+    class Recorder
+    {
+    public:
+        Stream setup, state, frames;
+        bool capturing;
+
+        Recorder() : capturing(false), activeUnit(0), vertexArray(0), drawFramebuffer(0), readFramebuffer(0), renderbuffer(0),
+                     unpackAlignment(4), pending(false), framesLeft(0), frameCount(0), width(0), height(0),
+                     setupVertexArray(0), setupDrawFramebuffer(0), setupReadFramebuffer(0), setupRenderbuffer(0) { }
+
+        // 在下一个帧边界开始录制 frameCount 帧
+        bool Request(const std::string& capturePath, GLuint count)
+        {
+            if(this->capturing || this->pending || count == 0)
+                return false;
+            this->path = capturePath;
+            this->frameCount = count;
+            this->pending = true;
+            return true;
+        }
+
+        bool Active() const { return this->pending || this->capturing; }
+
+        void EndFrame()
+        {
+            if(this->capturing)
+            {
+                Put(this->frames, (unsigned char)CAP_FRAME_END);
+                if(--this->framesLeft == 0)
+                {
+                    this->capturing = false;
+                    this->write();
+                    this->state.clear();
+                    this->frames.clear();
+                }
+            }
+            else if(this->pending)
+            {
+                this->pending = false;
+                this->snapshot();
+                this->framesLeft = this->frameCount;
+                this->capturing = true;
+            }
+        }
+
+        // 记录一个只影响当前帧的调用
+        template<typename... Args>
+        void Frame(Opcode op, Args... args)
+        {
+            if(this->capturing)
+                PutAll(this->frames, (unsigned char)op, args...);
+        }
+
+        // 资源调用：总是写入 setup，录制期间同时写入 frames
+        template<typename... Args>
+        void Resource(Opcode op, Args... args)
+        {
+            PutAll(this->setup, (unsigned char)op, args...);
+            if(this->capturing)
+                PutAll(this->frames, (unsigned char)op, args...);
+        }
+
+        void ResourceNames(GLsizei n, const GLuint* names)
+        {
+            for(GLsizei i = 0; i < n; i++)
+            {
+                Put(this->setup, names[i]);
+                if(this->capturing)
+                    Put(this->frames, names[i]);
+            }
+        }
+
+        void FrameBytes(const void* data, size_t size)
+        {
+            if(this->capturing)
+                PutBytes(this->frames, data, size);
+        }
+
+        void ResourceBytes(const void* data, size_t size)
+        {
+            PutBytes(this->setup, data, size);
+            if(this->capturing)
+                PutBytes(this->frames, data, size);
+        }
+
+        // 记录 uniform 位置（每个 (程序, 名字) 只记一次）
+        void UniformLocation(GLuint program, const GLchar* name, GLint location)
+        {
+            if(!this->locations.insert(std::make_pair(program, std::string(name))).second && !this->capturing)
+                return;
+            Stream& out = this->capturing ? this->frames : this->setup;
+            Put(out, (unsigned char)CAP_GET_UNIFORM_LOCATION);
+            Put(out, program);
+            PutString(out, name);
+            Put(out, location);
+        }
+
+        // == 影子状态：所有绑定调用都会更新，setup 段按需补记绑定 ==
+        GLuint activeUnit;
+        std::map<GLuint64, GLuint> textures; // (单元 << 32 | 目标) -> 贴图
+        std::map<GLenum, GLuint> buffers;
+        GLuint vertexArray, drawFramebuffer, readFramebuffer, renderbuffer;
+        GLint  unpackAlignment;
+        std::set<GLuint> programs;
+
+        void SetupTexture(GLenum target)
+        {
+            GLuint texture = this->textures[(GLuint64(this->activeUnit) << 32) | target];
+            if(this->setupTextures[target] == texture)
+                return;
+            this->setupTextures[target] = texture;
+            PutAll(this->setup, (unsigned char)CAP_BIND_TEXTURE, target, texture);
+        }
+
+        void SetupVertexArray()
+        {
+            if(this->setupVertexArray == this->vertexArray)
+                return;
+            this->setupVertexArray = this->vertexArray;
+            PutAll(this->setup, (unsigned char)CAP_BIND_VERTEX_ARRAY, this->vertexArray);
+        }
+
+        // 索引缓冲的绑定是 VAO 状态，绑定时就补记
+        void SetupElementBuffer(GLuint buffer)
+        {
+            this->SetupVertexArray();
+            GLuint& recorded = this->setupElements[this->vertexArray];
+            if(recorded == buffer)
+                return;
+            recorded = buffer;
+            PutAll(this->setup, (unsigned char)CAP_BIND_BUFFER, GLenum(GL_ELEMENT_ARRAY_BUFFER), buffer);
+        }
+
+        void SetupBuffer(GLenum target)
+        {
+            if(target == GL_ELEMENT_ARRAY_BUFFER)
+            {
+                this->SetupElementBuffer(this->elementBuffers[this->vertexArray]);
+                return;
+            }
+            GLuint buffer = this->buffers[target];
+            if(this->setupBuffers[target] == buffer)
+                return;
+            this->setupBuffers[target] = buffer;
+            PutAll(this->setup, (unsigned char)CAP_BIND_BUFFER, target, buffer);
+        }
+
+        void BindElementBuffer(GLuint buffer)
+        {
+            this->elementBuffers[this->vertexArray] = buffer;
+            this->SetupElementBuffer(buffer);
+        }
+
+        void SetupFramebuffer(GLenum target)
+        {
+            if(target != GL_READ_FRAMEBUFFER && this->setupDrawFramebuffer != this->drawFramebuffer)
+            {
+                this->setupDrawFramebuffer = this->drawFramebuffer;
+                PutAll(this->setup, (unsigned char)CAP_BIND_FRAMEBUFFER, GLenum(GL_DRAW_FRAMEBUFFER), this->drawFramebuffer);
+            }
+            if(target == GL_READ_FRAMEBUFFER && this->setupReadFramebuffer != this->readFramebuffer)
+            {
+                this->setupReadFramebuffer = this->readFramebuffer;
+                PutAll(this->setup, (unsigned char)CAP_BIND_FRAMEBUFFER, GLenum(GL_READ_FRAMEBUFFER), this->readFramebuffer);
+            }
+        }
+
+        void SetupRenderbuffer()
+        {
+            if(this->setupRenderbuffer == this->renderbuffer)
+                return;
+            this->setupRenderbuffer = this->renderbuffer;
+            PutAll(this->setup, (unsigned char)CAP_BIND_RENDERBUFFER, GLenum(GL_RENDERBUFFER), this->renderbuffer);
+        }
+
+    private:
+        std::string path;
+        bool pending;
+        GLuint framesLeft, frameCount;
+        GLuint width, height;
+        std::set<std::pair<GLuint, std::string> > locations;
+        std::map<GLuint, GLuint> elementBuffers; // VAO -> 索引缓冲
+
+        // setup 段回放到这里时的绑定（setup 只使用 0 号纹理单元）
+        std::map<GLenum, GLuint> setupTextures, setupBuffers;
+        std::map<GLuint, GLuint> setupElements;
+        GLuint setupVertexArray, setupDrawFramebuffer, setupReadFramebuffer, setupRenderbuffer;
+
+        // 开始录制时读回当前状态（直接用 glGet，包括不是经由录制层设置的状态）
+        void snapshot()
+        {
+            Stream& out = this->state;
+            out.clear();
+            this->frames.clear();
+            GLint value = 0, values[4];
+
+            // 所有程序的 uniform
+            for(GLuint program : this->programs)
+            {
+                GLint linked = 0, count = 0;
+                glGetProgramiv(program, GL_LINK_STATUS, &linked);
+                if(!linked)
+                    continue;
+                glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+                for(GLint u = 0; u < count; u++)
+                {
+                    GLchar name[256];
+                    GLsizei nameLength = 0;
+                    GLint size = 0;
+                    GLenum type = 0;
+                    glGetActiveUniform(program, GLuint(u), sizeof(name), &nameLength, &size, &type, name);
+                    std::string base(name, nameLength);
+                    if(size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+                        base.resize(base.size() - 3);
+                    for(GLint e = 0; e < size; e++)
+                    {
+                        std::string element = (size > 1) ? base + "[" + std::to_string(e) + "]" : base;
+                        GLint loc = glGetUniformLocation(program, element.c_str());
+                        if(loc < 0)
+                            continue;
+                        unsigned char data[16 * 4];
+                        std::memset(data, 0, sizeof(data));
+                        bool floats = type == GL_FLOAT || type == GL_FLOAT_VEC2 || type == GL_FLOAT_VEC3 ||
+                                      type == GL_FLOAT_VEC4 || type == GL_FLOAT_MAT3 || type == GL_FLOAT_MAT4;
+                        if(floats)
+                            glGetUniformfv(program, loc, reinterpret_cast<GLfloat*>(data));
+                        else
+                            glGetUniformiv(program, loc, reinterpret_cast<GLint*>(data));
+                        Put(out, (unsigned char)CAP_SET_UNIFORM);
+                        Put(out, program);
+                        PutString(out, element);
+                        Put(out, type);
+                        PutBytes(out, data, sizeof(data));
+                    }
+                }
+            }
+            glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+            PutAll(out, (unsigned char)CAP_USE_PROGRAM, GLuint(value));
+
+            // 各纹理单元的绑定
+            GLint units = 0, activeTexture = GL_TEXTURE0;
+            glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+            glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+            for(GLint unit = 0; unit < std::min(units, 16); unit++)
+            {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                PutAll(out, (unsigned char)CAP_ACTIVE_TEXTURE, GLenum(GL_TEXTURE0 + unit));
+                glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+                PutAll(out, (unsigned char)CAP_BIND_TEXTURE, GLenum(GL_TEXTURE_2D), GLuint(value));
+                glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &value);
+                PutAll(out, (unsigned char)CAP_BIND_TEXTURE, GLenum(GL_TEXTURE_2D_ARRAY), GLuint(value));
+            }
+            glActiveTexture(activeTexture);
+            PutAll(out, (unsigned char)CAP_ACTIVE_TEXTURE, GLenum(activeTexture));
+
+            // 对象绑定
+            glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+            PutAll(out, (unsigned char)CAP_BIND_VERTEX_ARRAY, GLuint(value));
+            glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &value);
+            PutAll(out, (unsigned char)CAP_BIND_BUFFER, GLenum(GL_ARRAY_BUFFER), GLuint(value));
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &value);
+            PutAll(out, (unsigned char)CAP_BIND_FRAMEBUFFER, GLenum(GL_DRAW_FRAMEBUFFER), GLuint(value));
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &value);
+            PutAll(out, (unsigned char)CAP_BIND_FRAMEBUFFER, GLenum(GL_READ_FRAMEBUFFER), GLuint(value));
+            glGetIntegerv(GL_RENDERBUFFER_BINDING, &value);
+            PutAll(out, (unsigned char)CAP_BIND_RENDERBUFFER, GLenum(GL_RENDERBUFFER), GLuint(value));
+
+            // 开关和固定功能状态
+            const GLenum caps[] = { GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_POLYGON_OFFSET_FILL, GL_SCISSOR_TEST };
+            for(GLenum cap : caps)
+                PutAll(out, (unsigned char)(glIsEnabled(cap) ? CAP_ENABLE : CAP_DISABLE), cap);
+            glGetIntegerv(GL_DEPTH_FUNC, &value);
+            PutAll(out, (unsigned char)CAP_DEPTH_FUNC, GLenum(value));
+            GLboolean masks[4];
+            glGetBooleanv(GL_DEPTH_WRITEMASK, masks);
+            PutAll(out, (unsigned char)CAP_DEPTH_MASK, masks[0]);
+            glGetBooleanv(GL_COLOR_WRITEMASK, masks);
+            PutAll(out, (unsigned char)CAP_COLOR_MASK, masks[0], masks[1], masks[2], masks[3]);
+            GLfloat color[4];
+            glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
+            PutAll(out, (unsigned char)CAP_CLEAR_COLOR, color[0], color[1], color[2], color[3]);
+            glGetFloatv(GL_POLYGON_OFFSET_FACTOR, &color[0]);
+            glGetFloatv(GL_POLYGON_OFFSET_UNITS, &color[1]);
+            PutAll(out, (unsigned char)CAP_POLYGON_OFFSET, color[0], color[1]);
+            glGetIntegerv(GL_POLYGON_MODE, values);
+            PutAll(out, (unsigned char)CAP_POLYGON_MODE, GLenum(GL_FRONT_AND_BACK), GLenum(values[0]));
+            glGetIntegerv(GL_UNPACK_ALIGNMENT, &value);
+            PutAll(out, (unsigned char)CAP_PIXEL_STORE_I, GLenum(GL_UNPACK_ALIGNMENT), value);
+            glGetIntegerv(GL_VIEWPORT, values);
+            PutAll(out, (unsigned char)CAP_VIEWPORT, values[0], values[1], GLsizei(values[2]), GLsizei(values[3]));
+            this->width = GLuint(values[2]);
+            this->height = GLuint(values[3]);
+        }
+
+        void write()
+        {
+            std::ofstream file(this->path.c_str(), std::ios::binary);
+            CaptureHeader header;
+            std::memset(&header, 0, sizeof(header));
+            header.magic = CAPTURE_MAGIC;
+            header.version = CAPTURE_VERSION;
+            header.width = this->width;
+            header.height = this->height;
+            header.frameCount = this->frameCount;
+            header.setupSize = this->setup.size();
+            header.stateSize = this->state.size();
+            header.framesSize = this->frames.size();
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if(!this->setup.empty())
+                file.write(reinterpret_cast<const char*>(&this->setup[0]), this->setup.size());
+            if(!this->state.empty())
+                file.write(reinterpret_cast<const char*>(&this->state[0]), this->state.size());
+            if(!this->frames.empty())
+                file.write(reinterpret_cast<const char*>(&this->frames[0]), this->frames.size());
+            if(!file)
+                std::cout << "ERROR::GL_CAPTURE:: cannot write " << this->path << std::endl;
+            else
+                std::cout << "GL_CAPTURE:: wrote " << this->frameCount << " frames to " << this->path << std::endl;
+        }
+    };
+
+    inline Recorder& GetRecorder()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+}
+
+// 在下一帧开始录制 frameCount 帧，写入 path；正在录制时返回 false
+inline bool CaptureFrames(const std::string& path, GLuint frameCount = 1)
+{
+    return gl_capture_detail::GetRecorder().Request(path, frameCount);
+}
+
+// 帧边界：在 glfwSwapBuffers 之前调用
+inline void CaptureEndFrame()
+{
+    gl_capture_detail::GetRecorder().EndFrame();
+}
+
+// 已请求或正在录制（按需渲染时要保持每帧都绘制）
+inline bool CaptureInProgress()
+{
+    return gl_capture_detail::GetRecorder().Active();
+}
+
+// == 录制函数：先调用真正的 GL 函数，再记录 ==
+namespace gl_capture_detail
+{
+    inline void RecordNames(Opcode op, NameSpace space, GLsizei n, const GLuint* names)
+    {
+        Recorder& r = GetRecorder();
+        r.Resource(op, (unsigned char)space, n);
+        r.ResourceNames(n, names);
+    }
+
+    // 立方体贴图的各个面绑定在 GL_TEXTURE_CUBE_MAP 上
+    inline GLenum BindingTarget(GLenum target)
+    {
+        return (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) ? GLenum(GL_TEXTURE_CUBE_MAP) : target;
+    }
+}
+
+// 对象
+inline void CaptureGenBuffers(GLsizei n, GLuint* names)       { glGenBuffers(n, names);       gl_capture_detail::RecordNames(gl_capture_detail::CAP_GEN, gl_capture_detail::NS_BUFFER, n, names); }
+inline void CaptureGenTextures(GLsizei n, GLuint* names)      { glGenTextures(n, names);      gl_capture_detail::RecordNames(gl_capture_detail::CAP_GEN, gl_capture_detail::NS_TEXTURE, n, names); }
+inline void CaptureGenVertexArrays(GLsizei n, GLuint* names)  { glGenVertexArrays(n, names);  gl_capture_detail::RecordNames(gl_capture_detail::CAP_GEN, gl_capture_detail::NS_VERTEX_ARRAY, n, names); }
+inline void CaptureGenFramebuffers(GLsizei n, GLuint* names)  { glGenFramebuffers(n, names);  gl_capture_detail::RecordNames(gl_capture_detail::CAP_GEN, gl_capture_detail::NS_FRAMEBUFFER, n, names); }
+inline void CaptureGenRenderbuffers(GLsizei n, GLuint* names) { glGenRenderbuffers(n, names); gl_capture_detail::RecordNames(gl_capture_detail::CAP_GEN, gl_capture_detail::NS_RENDERBUFFER, n, names); }
+inline void CaptureDeleteBuffers(GLsizei n, const GLuint* names)       { glDeleteBuffers(n, names);       gl_capture_detail::RecordNames(gl_capture_detail::CAP_DELETE, gl_capture_detail::NS_BUFFER, n, names); }
+inline void CaptureDeleteTextures(GLsizei n, const GLuint* names)      { glDeleteTextures(n, names);      gl_capture_detail::RecordNames(gl_capture_detail::CAP_DELETE, gl_capture_detail::NS_TEXTURE, n, names); }
+inline void CaptureDeleteVertexArrays(GLsizei n, const GLuint* names)  { glDeleteVertexArrays(n, names);  gl_capture_detail::RecordNames(gl_capture_detail::CAP_DELETE, gl_capture_detail::NS_VERTEX_ARRAY, n, names); }
+inline void CaptureDeleteFramebuffers(GLsizei n, const GLuint* names)  { glDeleteFramebuffers(n, names);  gl_capture_detail::RecordNames(gl_capture_detail::CAP_DELETE, gl_capture_detail::NS_FRAMEBUFFER, n, names); }
+inline void CaptureDeleteRenderbuffers(GLsizei n, const GLuint* names) { glDeleteRenderbuffers(n, names); gl_capture_detail::RecordNames(gl_capture_detail::CAP_DELETE, gl_capture_detail::NS_RENDERBUFFER, n, names); }
+
+// 着色器和程序
+inline GLuint CaptureCreateShader(GLenum type)
+{
+    GLuint shader = glCreateShader(type);
+    gl_capture_detail::GetRecorder().Resource(gl_capture_detail::CAP_CREATE_SHADER, type, shader);
+    return shader;
+}
+
+inline void CaptureShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+{
+    glShaderSource(shader, count, strings, lengths);
+    std::string source;
+    for(GLsizei i = 0; i < count; i++)
+        source += (lengths && lengths[i] >= 0) ? std::string(strings[i], lengths[i]) : std::string(strings[i]);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.Resource(gl_capture_detail::CAP_SHADER_SOURCE, shader);
+    r.ResourceBytes(source.data(), source.size());
+}
+
+inline void CaptureCompileShader(GLuint shader) { glCompileShader(shader); gl_capture_detail::GetRecorder().Resource(gl_capture_detail::CAP_COMPILE_SHADER, shader); }
+
+inline GLuint CaptureCreateProgram()
+{
+    GLuint program = glCreateProgram();
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.programs.insert(program);
+    r.Resource(gl_capture_detail::CAP_CREATE_PROGRAM, program);
+    return program;
+}
+
+inline void CaptureAttachShader(GLuint program, GLuint shader) { glAttachShader(program, shader); gl_capture_detail::GetRecorder().Resource(gl_capture_detail::CAP_ATTACH_SHADER, program, shader); }
+inline void CaptureLinkProgram(GLuint program) { glLinkProgram(program); gl_capture_detail::GetRecorder().Resource(gl_capture_detail::CAP_LINK_PROGRAM, program); }
+inline void CaptureDeleteShader(GLuint shader) { glDeleteShader(shader); gl_capture_detail::GetRecorder().Resource(gl_capture_detail::CAP_DELETE_SHADER, shader); }
+
+inline void CaptureDeleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.programs.erase(program);
+    r.Resource(gl_capture_detail::CAP_DELETE_PROGRAM, program);
+}
+
+inline GLint CaptureGetUniformLocation(GLuint program, const GLchar* name)
+{
+    GLint location = glGetUniformLocation(program, name);
+    gl_capture_detail::GetRecorder().UniformLocation(program, name, location);
+    return location;
+}
+
+// 缓冲
+inline void CaptureBindBuffer(GLenum target, GLuint buffer)
+{
+    glBindBuffer(target, buffer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    if(target == GL_ELEMENT_ARRAY_BUFFER)
+        r.BindElementBuffer(buffer);
+    else
+        r.buffers[target] = buffer;
+    r.Frame(gl_capture_detail::CAP_BIND_BUFFER, target, buffer);
+}
+
+inline void CaptureBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    glBufferData(target, size, data, usage);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupBuffer(target);
+    r.Resource(gl_capture_detail::CAP_BUFFER_DATA, target, GLuint64(size), usage);
+    r.ResourceBytes(data, size_t(size));
+}
+
+// 贴图
+inline void CaptureActiveTexture(GLenum unit)
+{
+    glActiveTexture(unit);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.activeUnit = unit - GL_TEXTURE0;
+    r.Frame(gl_capture_detail::CAP_ACTIVE_TEXTURE, unit);
+}
+
+inline void CaptureBindTexture(GLenum target, GLuint texture)
+{
+    glBindTexture(target, texture);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.textures[(GLuint64(r.activeUnit) << 32) | target] = texture;
+    r.Frame(gl_capture_detail::CAP_BIND_TEXTURE, target, texture);
+}
+
+inline void CaptureTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
+                              GLenum format, GLenum type, const void* pixels)
+{
+    glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(gl_capture_detail::BindingTarget(target));
+    r.Resource(gl_capture_detail::CAP_TEX_IMAGE_2D, target, level, internalFormat, width, height, border, format, type);
+    r.ResourceBytes(pixels, gl_capture_detail::ImageBytes(width, height, 1, format, type, r.unpackAlignment));
+}
+
+inline void CaptureTexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth,
+                              GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(target);
+    r.Resource(gl_capture_detail::CAP_TEX_IMAGE_3D, target, level, internalFormat, width, height, depth, border, format, type);
+    r.ResourceBytes(pixels, gl_capture_detail::ImageBytes(width, height, depth, format, type, r.unpackAlignment));
+}
+
+inline void CaptureTexSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+                                 GLenum format, GLenum type, const void* pixels)
+{
+    glTexSubImage3D(target, level, x, y, z, width, height, depth, format, type, pixels);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(target);
+    r.Resource(gl_capture_detail::CAP_TEX_SUB_IMAGE_3D, target, level, x, y, z, width, height, depth, format, type);
+    r.ResourceBytes(pixels, gl_capture_detail::ImageBytes(width, height, depth, format, type, r.unpackAlignment));
+}
+
+inline void CaptureTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    glTexParameteri(target, pname, param);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(target);
+    r.Resource(gl_capture_detail::CAP_TEX_PARAMETER_I, target, pname, param);
+}
+
+inline void CaptureTexParameterfv(GLenum target, GLenum pname, const GLfloat* params)
+{
+    glTexParameterfv(target, pname, params);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(target);
+    r.Resource(gl_capture_detail::CAP_TEX_PARAMETER_FV, target, pname);
+    r.ResourceBytes(params, (pname == GL_TEXTURE_BORDER_COLOR ? 4 : 1) * sizeof(GLfloat));
+}
+
+inline void CaptureGenerateMipmap(GLenum target)
+{
+    glGenerateMipmap(target);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupTexture(target);
+    r.Resource(gl_capture_detail::CAP_GENERATE_MIPMAP, target);
+}
+
+inline void CapturePixelStorei(GLenum pname, GLint param)
+{
+    glPixelStorei(pname, param);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    if(pname == GL_UNPACK_ALIGNMENT)
+        r.unpackAlignment = param;
+    r.Resource(gl_capture_detail::CAP_PIXEL_STORE_I, pname, param);
+}
+
+// 顶点数组
+inline void CaptureBindVertexArray(GLuint vertexArray)
+{
+    glBindVertexArray(vertexArray);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.vertexArray = vertexArray;
+    r.Frame(gl_capture_detail::CAP_BIND_VERTEX_ARRAY, vertexArray);
+}
+
+inline void CaptureVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupVertexArray();
+    r.SetupBuffer(GL_ARRAY_BUFFER);
+    r.Resource(gl_capture_detail::CAP_VERTEX_ATTRIB_POINTER, index, size, type, normalized, stride, GLuint64(size_t(pointer)));
+}
+
+inline void CaptureEnableVertexAttribArray(GLuint index)
+{
+    glEnableVertexAttribArray(index);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupVertexArray();
+    r.Resource(gl_capture_detail::CAP_ENABLE_VERTEX_ATTRIB_ARRAY, index);
+}
+
+// 帧缓冲
+inline void CaptureBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    glBindFramebuffer(target, framebuffer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    if(target != GL_READ_FRAMEBUFFER)
+        r.drawFramebuffer = framebuffer;
+    if(target != GL_DRAW_FRAMEBUFFER)
+        r.readFramebuffer = framebuffer;
+    r.Frame(gl_capture_detail::CAP_BIND_FRAMEBUFFER, target, framebuffer);
+}
+
+inline void CaptureFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    glFramebufferTexture2D(target, attachment, textarget, texture, level);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupFramebuffer(target);
+    r.Resource(gl_capture_detail::CAP_FRAMEBUFFER_TEXTURE_2D, target, attachment, textarget, texture, level);
+}
+
+inline void CaptureFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)
+{
+    glFramebufferTextureLayer(target, attachment, texture, level, layer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupFramebuffer(target);
+    r.Resource(gl_capture_detail::CAP_FRAMEBUFFER_TEXTURE_LAYER, target, attachment, texture, level, layer);
+}
+
+inline void CaptureFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer)
+{
+    glFramebufferRenderbuffer(target, attachment, renderbufferTarget, renderbuffer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupFramebuffer(target);
+    r.Resource(gl_capture_detail::CAP_FRAMEBUFFER_RENDERBUFFER, target, attachment, renderbufferTarget, renderbuffer);
+}
+
+inline void CaptureBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    glBindRenderbuffer(target, renderbuffer);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.renderbuffer = renderbuffer;
+    r.Frame(gl_capture_detail::CAP_BIND_RENDERBUFFER, target, renderbuffer);
+}
+
+inline void CaptureRenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height)
+{
+    glRenderbufferStorage(target, internalFormat, width, height);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupRenderbuffer();
+    r.Resource(gl_capture_detail::CAP_RENDERBUFFER_STORAGE, target, internalFormat, width, height);
+}
+
+inline void CaptureDrawBuffer(GLenum mode)
+{
+    glDrawBuffer(mode);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupFramebuffer(GL_DRAW_FRAMEBUFFER);
+    r.Resource(gl_capture_detail::CAP_DRAW_BUFFER, mode);
+}
+
+inline void CaptureReadBuffer(GLenum mode)
+{
+    glReadBuffer(mode);
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.SetupFramebuffer(GL_READ_FRAMEBUFFER);
+    r.Resource(gl_capture_detail::CAP_READ_BUFFER, mode);
+}
+
+// 程序和 uniform（只在录制期间记录）
+inline void CaptureUseProgram(GLuint program) { glUseProgram(program); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_USE_PROGRAM, program); }
+inline void CaptureUniform1f(GLint location, GLfloat x) { glUniform1f(location, x); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_UNIFORM_1F, location, x); }
+inline void CaptureUniform1i(GLint location, GLint x) { glUniform1i(location, x); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_UNIFORM_1I, location, x); }
+inline void CaptureUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z) { glUniform3f(location, x, y, z); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_UNIFORM_3F, location, x, y, z); }
+
+inline void CaptureUniformArray(gl_capture_detail::Opcode op, GLint location, GLsizei count, GLboolean transpose, const GLfloat* values, GLuint components)
+{
+    gl_capture_detail::Recorder& r = gl_capture_detail::GetRecorder();
+    r.Frame(op, location, count, transpose);
+    r.FrameBytes(values, size_t(count) * components * sizeof(GLfloat));
+}
+
+inline void CaptureUniform3fv(GLint location, GLsizei count, const GLfloat* values) { glUniform3fv(location, count, values); CaptureUniformArray(gl_capture_detail::CAP_UNIFORM_3FV, location, count, GL_FALSE, values, 3); }
+inline void CaptureUniform4fv(GLint location, GLsizei count, const GLfloat* values) { glUniform4fv(location, count, values); CaptureUniformArray(gl_capture_detail::CAP_UNIFORM_4FV, location, count, GL_FALSE, values, 4); }
+inline void CaptureUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* values) { glUniformMatrix4fv(location, count, transpose, values); CaptureUniformArray(gl_capture_detail::CAP_UNIFORM_MATRIX_4FV, location, count, transpose, values, 16); }
+
+// 固定功能状态
+inline void CaptureEnable(GLenum cap) { glEnable(cap); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_ENABLE, cap); }
+inline void CaptureDisable(GLenum cap) { glDisable(cap); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DISABLE, cap); }
+inline void CaptureDepthFunc(GLenum func) { glDepthFunc(func); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DEPTH_FUNC, func); }
+inline void CaptureDepthMask(GLboolean flag) { glDepthMask(flag); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DEPTH_MASK, flag); }
+inline void CaptureColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) { glColorMask(r, g, b, a); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_COLOR_MASK, r, g, b, a); }
+inline void CaptureClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { glClearColor(r, g, b, a); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_CLEAR_COLOR, r, g, b, a); }
+inline void CaptureClear(GLbitfield mask) { glClear(mask); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_CLEAR, mask); }
+inline void CaptureViewport(GLint x, GLint y, GLsizei width, GLsizei height) { glViewport(x, y, width, height); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_VIEWPORT, x, y, width, height); }
+inline void CapturePolygonMode(GLenum face, GLenum mode) { glPolygonMode(face, mode); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_POLYGON_MODE, face, mode); }
+inline void CapturePolygonOffset(GLfloat factor, GLfloat units) { glPolygonOffset(factor, units); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_POLYGON_OFFSET, factor, units); }
+
+// 绘制
+inline void CaptureDrawArrays(GLenum mode, GLint first, GLsizei count) { glDrawArrays(mode, first, count); gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DRAW_ARRAYS, mode, first, count); }
+
+inline void CaptureDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+    glDrawElements(mode, count, type, indices);
+    gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DRAW_ELEMENTS, mode, count, type, GLuint64(size_t(indices)));
+}
+
+inline void CaptureDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex)
+{
+    glDrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_DRAW_ELEMENTS_BASE_VERTEX, mode, count, type, GLuint64(size_t(indices)), baseVertex);
+}
+
+inline void CaptureBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1,
+                                   GLbitfield mask, GLenum filter)
+{
+    glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    gl_capture_detail::GetRecorder().Frame(gl_capture_detail::CAP_BLIT_FRAMEBUFFER, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+}
+
+// == 之后的 glXxx 调用都经过录制层 ==
+#undef glGenBuffers
+#define glGenBuffers CaptureGenBuffers
+#undef glGenTextures
+#define glGenTextures CaptureGenTextures
+#undef glGenVertexArrays
+#define glGenVertexArrays CaptureGenVertexArrays
+#undef glGenFramebuffers
+#define glGenFramebuffers CaptureGenFramebuffers
+#undef glGenRenderbuffers
+#define glGenRenderbuffers CaptureGenRenderbuffers
+#undef glDeleteBuffers
+#define glDeleteBuffers CaptureDeleteBuffers
+#undef glDeleteTextures
+#define glDeleteTextures CaptureDeleteTextures
+#undef glDeleteVertexArrays
+#define glDeleteVertexArrays CaptureDeleteVertexArrays
+#undef glDeleteFramebuffers
+#define glDeleteFramebuffers CaptureDeleteFramebuffers
+#undef glDeleteRenderbuffers
+#define glDeleteRenderbuffers CaptureDeleteRenderbuffers
+#undef glCreateShader
+#define glCreateShader CaptureCreateShader
+#undef glShaderSource
+#define glShaderSource CaptureShaderSource
+#undef glCompileShader
+#define glCompileShader CaptureCompileShader
+#undef glCreateProgram
+#define glCreateProgram CaptureCreateProgram
+#undef glAttachShader
+#define glAttachShader CaptureAttachShader
+#undef glLinkProgram
+#define glLinkProgram CaptureLinkProgram
+#undef glDeleteShader
+#define glDeleteShader CaptureDeleteShader
+#undef glDeleteProgram
+#define glDeleteProgram CaptureDeleteProgram
+#undef glGetUniformLocation
+#define glGetUniformLocation CaptureGetUniformLocation
+#undef glBindBuffer
+#define glBindBuffer CaptureBindBuffer
+#undef glBufferData
+#define glBufferData CaptureBufferData
+#undef glActiveTexture
+#define glActiveTexture CaptureActiveTexture
+#undef glBindTexture
+#define glBindTexture CaptureBindTexture
+#undef glTexImage2D
+#define glTexImage2D CaptureTexImage2D
+#undef glTexImage3D
+#define glTexImage3D CaptureTexImage3D
+#undef glTexSubImage3D
+#define glTexSubImage3D CaptureTexSubImage3D
+#undef glTexParameteri
+#define glTexParameteri CaptureTexParameteri
+#undef glTexParameterfv
+#define glTexParameterfv CaptureTexParameterfv
+#undef glGenerateMipmap
+#define glGenerateMipmap CaptureGenerateMipmap
+#undef glPixelStorei
+#define glPixelStorei CapturePixelStorei
+#undef glBindVertexArray
+#define glBindVertexArray CaptureBindVertexArray
+#undef glVertexAttribPointer
+#define glVertexAttribPointer CaptureVertexAttribPointer
+#undef glEnableVertexAttribArray
+#define glEnableVertexAttribArray CaptureEnableVertexAttribArray
+#undef glBindFramebuffer
+#define glBindFramebuffer CaptureBindFramebuffer
+#undef glFramebufferTexture2D
+#define glFramebufferTexture2D CaptureFramebufferTexture2D
+#undef glFramebufferTextureLayer
+#define glFramebufferTextureLayer CaptureFramebufferTextureLayer
+#undef glFramebufferRenderbuffer
+#define glFramebufferRenderbuffer CaptureFramebufferRenderbuffer
+#undef glBindRenderbuffer
+#define glBindRenderbuffer CaptureBindRenderbuffer
+#undef glRenderbufferStorage
+#define glRenderbufferStorage CaptureRenderbufferStorage
+#undef glDrawBuffer
+#define glDrawBuffer CaptureDrawBuffer
+#undef glReadBuffer
+#define glReadBuffer CaptureReadBuffer
+#undef glUseProgram
+#define glUseProgram CaptureUseProgram
+#undef glUniform1f
+#define glUniform1f CaptureUniform1f
+#undef glUniform1i
+#define glUniform1i CaptureUniform1i
+#undef glUniform3f
+#define glUniform3f CaptureUniform3f
+#undef glUniform3fv
+#define glUniform3fv CaptureUniform3fv
+#undef glUniform4fv
+#define glUniform4fv CaptureUniform4fv
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv CaptureUniformMatrix4fv
+#undef glEnable
+#define glEnable CaptureEnable
+#undef glDisable
+#define glDisable CaptureDisable
+#undef glDepthFunc
+#define glDepthFunc CaptureDepthFunc
+#undef glDepthMask
+#define glDepthMask CaptureDepthMask
+#undef glColorMask
+#define glColorMask CaptureColorMask
+#undef glClearColor
+#define glClearColor CaptureClearColor
+#undef glClear
+#define glClear CaptureClear
+#undef glViewport
+#define glViewport CaptureViewport
+#undef glPolygonMode
+#define glPolygonMode CapturePolygonMode
+#undef glPolygonOffset
+#define glPolygonOffset CapturePolygonOffset
+#undef glDrawArrays
+#define glDrawArrays CaptureDrawArrays
+#undef glDrawElements
+#define glDrawElements CaptureDrawElements
+#undef glDrawElementsBaseVertex
+#define glDrawElementsBaseVertex CaptureDrawElementsBaseVertex
+#undef glBlitFramebuffer
+#define glBlitFramebuffer CaptureBlitFramebuffer
+
+#else
+
+// 没有定义 GL_CAPTURE 时录制层不存在
+inline bool CaptureFrames(const std::string& path, GLuint /* frameCount */ = 1)
+{
+    std::cout << "ERROR::GL_CAPTURE:: rebuild with GL_CAPTURE defined to capture " << path << std::endl;
+    return false;
+}
+
+inline void CaptureEndFrame() { }
+
+inline bool CaptureInProgress() { return false; }
+
+#endif // GL_CAPTURE
+
+#endif
@@ -0,0 +1,361 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <SOIL.h>
+#include <libdeflate.h>  // 向量化的 inflate
+#include <turbojpeg.h>   // libjpeg-turbo
+
+#include <learnopengl/asset_pack.h>
+
+// == ======================================
+// 批量载入用的图片解码
+// SOIL（stb_image）逐字节 inflate，且每次都分配新缓冲。这里：
+// 1. PNG 自己解析分块，IDAT 交给 libdeflate 解压，再做行过滤还原；
+// 2. JPEG 交给 libjpeg-turbo（SIMD IDCT/颜色转换）；
+// 3. 输出直接写入调用者提供的缓冲，或从 ImageBufferPool 取出的缓冲；
+// 4. 解码器的上下文和临时缓冲按线程复用（ThreadImageDecoder）。
+// 输出与 SOIL_LOAD_RGB 一致（RGB，每通道 8 位，首行在前）。
+// 隔行扫描的 PNG、低于 8 位的灰度 PNG 以及其他格式退回 SOIL。
+// SOIL 的结果字符串和 stb_image 的错误原因都是全局变量，退回 SOIL 时用 SoilMutex() 串行化。
+// == ======================================
+
+// 所有 SOIL 调用共用的锁（SOIL 不是线程安全的）
+inline std::mutex& SoilMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+enum ImageFormat
+{
+    IMAGE_UNKNOWN,
+    IMAGE_PNG,
+    IMAGE_JPEG
+};
+
+inline ImageFormat DetectImageFormat(const unsigned char* data, size_t size)
+{
+    static const unsigned char pngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    if(size >= 8 && std::memcmp(data, pngSignature, 8) == 0)
+        return IMAGE_PNG;
+    if(size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+        return IMAGE_JPEG;
+    return IMAGE_UNKNOWN;
+}
+
+// 像素缓冲池：解码结果上传后把缓冲还回来，下一张图片直接复用，避免反复分配大块内存
+class ImageBufferPool
+{
+public:
+    ImageBufferPool(size_t maxBuffers = 16) : maxBuffers(maxBuffers) { }
+
+    // 取出一个至少能容纳 size 字节的缓冲（size() 即为 size）
+    std::vector<unsigned char> Acquire(size_t size)
+    {
+        std::vector<unsigned char> buffer;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            // 选容量足够的缓冲中最小的一个
+            size_t best = this->buffers.size();
+            for(size_t i = 0; i < this->buffers.size(); i++)
+                if(this->buffers[i].capacity() >= size && (best == this->buffers.size() || this->buffers[i].capacity() < this->buffers[best].capacity()))
+                    best = i;
+            if(best == this->buffers.size() && !this->buffers.empty())
+                best = 0; // 都不够大时扩容其中一个，至少省掉一次释放
+            if(best < this->buffers.size())
+            {
+                buffer.swap(this->buffers[best]);
+                this->buffers.erase(this->buffers.begin() + best);
+            }
+        }
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void Release(std::vector<unsigned char>&& buffer)
+    {
+        if(buffer.capacity() == 0)
+            return;
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if(this->buffers.size() < this->maxBuffers)
+            this->buffers.push_back(std::move(buffer));
+        buffer = std::vector<unsigned char>();
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::vector<unsigned char> > buffers;
+    size_t maxBuffers;
+};
+
+// 全局缓冲池
+inline ImageBufferPool& ImagePool()
+{
+    static ImageBufferPool pool;
+    return pool;
+}
+
+// 图片解码器：持有 libdeflate/libjpeg-turbo 的上下文和临时缓冲，不是线程安全的，每个线程一个
+class ImageDecoder
+{
+public:
+    ImageDecoder() : inflater(libdeflate_alloc_decompressor()), jpeg(tjInitDecompress()) { }
+
+    ~ImageDecoder()
+    {
+        if(this->inflater)
+            libdeflate_free_decompressor(this->inflater);
+        if(this->jpeg)
+            tjDestroy(this->jpeg);
+    }
+
+    // 只读取尺寸（用于预先准备缓冲）；不支持的格式返回 false
+    bool ReadInfo(const unsigned char* data, size_t size, GLint& width, GLint& height)
+    {
+        switch(DetectImageFormat(data, size))
+        {
+        case IMAGE_PNG:
+            if(size < 33 || std::memcmp(data + 12, "IHDR", 4) != 0)
+                return false;
+            width = GLint(ReadBigEndian(data + 16));
+            height = GLint(ReadBigEndian(data + 20));
+            return width > 0 && height > 0;
+        case IMAGE_JPEG:
+        {
+            int w, h, subsamp, colorspace;
+            if(!this->jpeg || tjDecompressHeader3(this->jpeg, data, (unsigned long)size, &w, &h, &subsamp, &colorspace) != 0)
+                return false;
+            width = w;
+            height = h;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    // 解码成 RGB 写入 dst（容量至少 width * height * 3）；返回 false 时调用者应退回 SOIL
+    bool DecodeInto(const unsigned char* data, size_t size, unsigned char* dst, size_t capacity, GLint& width, GLint& height)
+    {
+        if(!this->ReadInfo(data, size, width, height) || size_t(width) * height * 3 > capacity)
+            return false;
+        switch(DetectImageFormat(data, size))
+        {
+        case IMAGE_PNG:
+            return this->decodePng(data, size, dst);
+        case IMAGE_JPEG:
+            return tjDecompress2(this->jpeg, data, (unsigned long)size, dst, width, width * 3, height, TJPF_RGB, TJFLAG_FASTDCT) == 0;
+        default:
+            return false;
+        }
+    }
+
+    // 解码到缓冲池取出的缓冲中；不支持的格式用 SOIL 解码后复制过去
+    bool Decode(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, GLint& width, GLint& height)
+    {
+        if(this->ReadInfo(data, size, width, height))
+        {
+            pixels = ImagePool().Acquire(size_t(width) * height * 3);
+            if(this->DecodeInto(data, size, &pixels[0], pixels.size(), width, height))
+                return true;
+            ImagePool().Release(std::move(pixels));
+        }
+
+        std::lock_guard<std::mutex> lock(SoilMutex());
+        int w, h;
+        unsigned char* image = SOIL_load_image_from_memory(data, int(size), &w, &h, 0, SOIL_LOAD_RGB);
+        if(!image)
+            return false;
+        width = w;
+        height = h;
+        pixels = ImagePool().Acquire(size_t(w) * h * 3);
+        std::memcpy(&pixels[0], image, pixels.size());
+        SOIL_free_image_data(image);
+        return true;
+    }
+
+private:
+    libdeflate_decompressor* inflater;
+    tjhandle jpeg;
+    std::vector<unsigned char> compressed; // 拼接后的 IDAT
+    std::vector<unsigned char> filtered;   // 解压后的带过滤字节的扫描行
+
+    ImageDecoder(const ImageDecoder&);
+    ImageDecoder& operator=(const ImageDecoder&);
+
+    static GLuint ReadBigEndian(const unsigned char* p)
+    {
+        return (GLuint(p[0]) << 24) | (GLuint(p[1]) << 16) | (GLuint(p[2]) << 8) | GLuint(p[3]);
+    }
+
+    static unsigned char Paeth(unsigned char a, unsigned char b, unsigned char c)
+    {
+        GLint p = GLint(a) + b - c;
+        GLint pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if(pa <= pb && pa <= pc)
+            return a;
+        return (pb <= pc) ? b : c;
+    }
+
+    bool decodePng(const unsigned char* data, size_t size, unsigned char* dst)
+    {
+        if(!this->inflater)
+            return false;
+        GLuint width = 0, height = 0, depth = 0, colorType = 0, interlace = 0;
+        const unsigned char* palette = nullptr;
+        GLuint paletteSize = 0;
+        this->compressed.clear();
+
+        // 1. 分块
+        size_t pos = 8;
+        while(pos + 12 <= size)
+        {
+            GLuint length = ReadBigEndian(data + pos);
+            const unsigned char* type = data + pos + 4;
+            const unsigned char* body = data + pos + 8;
+            if(length > size - pos - 12)
+                return false;
+            if(std::memcmp(type, "IHDR", 4) == 0 && length >= 13)
+            {
+                width = ReadBigEndian(body);
+                height = ReadBigEndian(body + 4);
+                depth = body[8];
+                colorType = body[9];
+                interlace = body[12];
+            }
+            else if(std::memcmp(type, "PLTE", 4) == 0)
+            {
+                palette = body;
+                paletteSize = length / 3;
+            }
+            else if(std::memcmp(type, "IDAT", 4) == 0)
+                this->compressed.insert(this->compressed.end(), body, body + length);
+            else if(std::memcmp(type, "IEND", 4) == 0)
+                break;
+            pos += size_t(length) + 12;
+        }
+
+        // 2. 支持的格式：不隔行，8/16 位的灰度、RGB、灰度+alpha、RGBA，以及 8 位调色板
+        GLuint channels;
+        switch(colorType)
+        {
+        case 0: channels = 1; break;
+        case 2: channels = 3; break;
+        case 3: channels = 1; break;
+        case 4: channels = 2; break;
+        case 6: channels = 4; break;
+        default: return false;
+        }
+        if(interlace != 0 || width == 0 || height == 0 || (depth != 8 && depth != 16) || (colorType == 3 && (depth != 8 || !palette)))
+            return false;
+        GLuint bytesPerPixel = channels * depth / 8;
+        size_t stride = size_t(width) * bytesPerPixel;
+
+        // 3. 解压
+        this->filtered.resize((stride + 1) * height);
+        size_t actual = 0;
+        if(this->compressed.empty()
+           || libdeflate_zlib_decompress(this->inflater, &this->compressed[0], this->compressed.size(),
+                                         &this->filtered[0], this->filtered.size(), &actual) != LIBDEFLATE_SUCCESS
+           || actual != this->filtered.size())
+            return false;
+
+        // 4. 逐行还原过滤（原地），同时转换成 RGB
+        const unsigned char* previous = nullptr;
+        for(GLuint y = 0; y < height; y++)
+        {
+            unsigned char* row = &this->filtered[y * (stride + 1)];
+            unsigned char filter = row[0];
+            unsigned char* line = row + 1;
+            switch(filter)
+            {
+            case 0:
+                break;
+            case 1: // Sub
+                for(size_t i = bytesPerPixel; i < stride; i++)
+                    line[i] = (unsigned char)(line[i] + line[i - bytesPerPixel]);
+                break;
+            case 2: // Up
+                if(previous)
+                    for(size_t i = 0; i < stride; i++)
+                        line[i] = (unsigned char)(line[i] + previous[i]);
+                break;
+            case 3: // Average
+                for(size_t i = 0; i < stride; i++)
+                {
+                    GLuint left = (i >= bytesPerPixel) ? line[i - bytesPerPixel] : 0;
+                    GLuint up = previous ? previous[i] : 0;
+                    line[i] = (unsigned char)(line[i] + ((left + up) >> 1));
+                }
+                break;
+            case 4: // Paeth
+                for(size_t i = 0; i < stride; i++)
+                {
+                    unsigned char left = (i >= bytesPerPixel) ? line[i - bytesPerPixel] : 0;
+                    unsigned char up = previous ? previous[i] : 0;
+                    unsigned char upLeft = (previous && i >= bytesPerPixel) ? previous[i - bytesPerPixel] : 0;
+                    line[i] = (unsigned char)(line[i] + Paeth(left, up, upLeft));
+                }
+                break;
+            default:
+                return false;
+            }
+            previous = line;
+
+            // 16 位取高字节
+            unsigned char* out = dst + size_t(y) * width * 3;
+            GLuint sampleStep = depth / 8;
+            for(GLuint x = 0; x < width; x++)
+            {
+                const unsigned char* pixel = line + size_t(x) * bytesPerPixel;
+                switch(colorType)
+                {
+                case 0:
+                case 4:
+                    out[0] = out[1] = out[2] = pixel[0];
+                    break;
+                case 3:
+                {
+                    const unsigned char* entry = (pixel[0] < paletteSize) ? palette + pixel[0] * 3 : palette;
+                    out[0] = entry[0]; out[1] = entry[1]; out[2] = entry[2];
+                    break;
+                }
+                default:
+                    out[0] = pixel[0];
+                    out[1] = pixel[sampleStep];
+                    out[2] = pixel[2 * sampleStep];
+                    break;
+                }
+                out += 3;
+            }
+        }
+        return true;
+    }
+};
+
+// 当前线程的解码器
+inline ImageDecoder& ThreadImageDecoder()
+{
+    static thread_local ImageDecoder decoder;
+    return decoder;
+}
+
+// 从文件解码（内存映射读取），像素缓冲来自 ImagePool()，用完后应 Release 回去
+inline bool DecodeImageFile(const std::string& path, std::vector<unsigned char>& pixels, GLint& width, GLint& height)
+{
+    AssetFile file;
+    if(!file.Open(path) || file.Size() == 0)
+        return false;
+    return ThreadImageDecoder().Decode((const unsigned char*)file.Data(), file.Size(), pixels, width, height);
+}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef LIGHT_ASSIGNMENT_H
+#define LIGHT_ASSIGNMENT_H
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// 点光源属性，与着色器中的 PointLight 结构体一致
+struct PointLight
+{
+    glm::vec3 position;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+    GLfloat constant;  // 衰减的常数
+    GLfloat linear;    // 线性衰减值
+    GLfloat quadratic; // 二次方衰减值
+    GLfloat range;     // 影响范围，由 LightRange 计算
+};
+
+// 聚光灯属性，与着色器中的 SpotLight 结构体一致
+struct SpotLight
+{
+    glm::vec3 position;
+    glm::vec3 direction;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+    GLfloat cutOff;      // 内部光切角（余弦）
+    GLfloat outerCutOff; // 外部光切角（余弦）
+    GLfloat constant;
+    GLfloat linear;
+    GLfloat quadratic;
+};
+
+// 灯光的强度：环境光、漫反射、高光中最亮的通道。
+// 影响范围和按物体分配时的贡献估计都用它，两者才不会矛盾。
+inline GLfloat LightIntensity(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular)
+{
+    glm::vec3 peak = glm::max(glm::max(ambient, diffuse), specular);
+    return std::max(peak.x, std::max(peak.y, peak.z));
+}
+
+// 由衰减系数推出灯光的影响范围：
+// LightIntensity * 1/(constant + linear*d + quadratic*d^2) 降到 threshold 以下的距离。
+// 默认阈值 5/256，即 8 位颜色下已看不出差别。
+inline GLfloat AttenuationRange(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular,
+                                GLfloat constant, GLfloat linear, GLfloat quadratic, GLfloat threshold)
+{
+    GLfloat intensity = LightIntensity(ambient, diffuse, specular);
+    GLfloat c = constant - intensity / threshold;
+    if(c >= 0.0f)
+        return 0.0f; // 在光源处就已经低于阈值
+    if(quadratic > 0.0f)
+        return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic);
+    if(linear > 0.0f)
+        return -c / linear;
+    return 1e30f; // 不衰减
+}
+
+inline GLfloat LightRange(const PointLight& light, GLfloat threshold = 5.0f / 256.0f)
+{
+    return AttenuationRange(light.ambient, light.diffuse, light.specular, light.constant, light.linear, light.quadratic, threshold);
+}
+
+inline GLfloat LightRange(const SpotLight& light, GLfloat threshold = 5.0f / 256.0f)
+{
+    return AttenuationRange(light.ambient, light.diffuse, light.specular, light.constant, light.linear, light.quadratic, threshold);
+}
+
+// 关闭的聚光灯：着色器里的聚光灯槽位没有灯可用时上传它。
+// 方向必须是单位向量（着色器要 normalize），cutOff 与 outerCutOff 不能相等（着色器要除以两者之差），
+// 颜色全为 0，所以计算出的强度有限且贡献为 0。
+inline SpotLight OffSpotLight()
+{
+    SpotLight light = {};
+    light.direction   = glm::vec3(0.0f, -1.0f, 0.0f);
+    light.cutOff      = 1.0f;
+    light.outerCutOff = 0.99f;
+    light.constant    = 1.0f;
+    return light;
+}
+
+// 按物体分配灯光
+// 对每个物体只挑选范围内贡献最大的 N 个点光源，作为这次绘制的灯光列表上传，
+// 这样片段着色器的开销只和 N 有关，和场景中的灯光总数无关。
+class LightAssigner
+{
+public:
+    LightAssigner(GLuint maxLightsPerObject)
+        : maxLights(maxLightsPerObject), cachedProgram(0)
+    {
+    }
+
+    // 设置场景灯光，同时计算影响范围
+    void SetLights(const std::vector<PointLight>& sceneLights)
+    {
+        this->lights = sceneLights;
+        for(PointLight& light : this->lights)
+            light.range = LightRange(light);
+    }
+
+    const std::vector<PointLight>& Lights() const
+    {
+        return this->lights;
+    }
+
+    // 为包围球 (center, radius) 的物体挑选灯光，返回灯光下标（按贡献从大到小）
+    const std::vector<GLuint>& Assign(const glm::vec3& center, GLfloat radius)
+    {
+        this->candidates.clear();
+        for(GLuint i = 0; i < this->lights.size(); i++)
+        {
+            const PointLight& light = this->lights[i];
+            GLfloat distance = std::max(glm::length(light.position - center) - radius, 0.0f);
+            if(distance > light.range)
+                continue;
+            // 用包围球上离灯最近的点估计贡献
+            GLfloat intensity = LightIntensity(light.ambient, light.diffuse, light.specular);
+            GLfloat attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * distance * distance);
+            this->candidates.push_back(std::make_pair(intensity * attenuation, i));
+        }
+
+        size_t count = std::min<size_t>(this->maxLights, this->candidates.size());
+        std::partial_sort(this->candidates.begin(), this->candidates.begin() + count, this->candidates.end(),
+                          [](const std::pair<GLfloat, GLuint>& a, const std::pair<GLfloat, GLuint>& b) { return a.first > b.first; });
+
+        this->assigned.clear();
+        for(size_t i = 0; i < count; i++)
+            this->assigned.push_back(this->candidates[i].second);
+        return this->assigned;
+    }
+
+    // 把上一次 Assign 的结果上传到 pointLights[] 和 nrPointLights（需要先激活 program）
+    void Upload(GLuint program)
+    {
+        if(program != this->cachedProgram)
+            this->cacheLocations(program);
+
+        glUniform1i(this->countLoc, GLint(this->assigned.size()));
+        for(GLuint i = 0; i < this->assigned.size(); i++)
+        {
+            const PointLight& light = this->lights[this->assigned[i]];
+            const Locations& loc = this->locations[i];
+            glUniform3f(loc.position, light.position.x, light.position.y, light.position.z);
+            glUniform3f(loc.ambient,  light.ambient.x,  light.ambient.y,  light.ambient.z);
+            glUniform3f(loc.diffuse,  light.diffuse.x,  light.diffuse.y,  light.diffuse.z);
+            glUniform3f(loc.specular, light.specular.x, light.specular.y, light.specular.z);
+            glUniform1f(loc.constant,  light.constant);
+            glUniform1f(loc.linear,    light.linear);
+            glUniform1f(loc.quadratic, light.quadratic);
+        }
+    }
+
+private:
+    struct Locations
+    {
+        GLint position, ambient, diffuse, specular, constant, linear, quadratic;
+    };
+
+    GLuint maxLights;
+    std::vector<PointLight> lights;
+    std::vector<std::pair<GLfloat, GLuint> > candidates;
+    std::vector<GLuint> assigned;
+
+    // uniform 地址缓存，每个物体都要上传，不能每次都查询
+    GLuint cachedProgram;
+    GLint countLoc;
+    std::vector<Locations> locations;
+
+    void cacheLocations(GLuint program)
+    {
+        this->cachedProgram = program;
+        this->countLoc = glGetUniformLocation(program, "nrPointLights");
+        this->locations.resize(this->maxLights);
+        for(GLuint i = 0; i < this->maxLights; i++)
+        {
+            std::string name = "pointLights[" + std::to_string(i) + "].";
+            Locations& loc = this->locations[i];
+            loc.position  = glGetUniformLocation(program, (name + "position").c_str());
+            loc.ambient   = glGetUniformLocation(program, (name + "ambient").c_str());
+            loc.diffuse   = glGetUniformLocation(program, (name + "diffuse").c_str());
+            loc.specular  = glGetUniformLocation(program, (name + "specular").c_str());
+            loc.constant  = glGetUniformLocation(program, (name + "constant").c_str());
+            loc.linear    = glGetUniformLocation(program, (name + "linear").c_str());
+            loc.quadratic = glGetUniformLocation(program, (name + "quadratic").c_str());
+        }
+    }
+};
+
+#endif
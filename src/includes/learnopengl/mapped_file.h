@@ -0,0 +1,133 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// 只读内存映射文件
+// 文件内容直接映射到进程地址空间，由系统按需分页读入，不需要额外的缓冲和复制。
+class MappedFile
+{
+public:
+    MappedFile() : data(nullptr), size(0)
+    {
+#ifdef _WIN32
+        this->file = INVALID_HANDLE_VALUE;
+        this->mapping = NULL;
+#else
+        this->fd = -1;
+#endif
+    }
+
+    ~MappedFile()
+    {
+        this->Close();
+    }
+
+    bool Open(const std::string& path)
+    {
+        this->Close();
+#ifdef _WIN32
+        this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if(this->file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(this->file, &fileSize))
+        {
+            this->Close();
+            return false;
+        }
+        this->size = size_t(fileSize.QuadPart);
+        if(this->size == 0)
+            return true;
+        this->mapping = CreateFileMappingA(this->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(!this->mapping)
+        {
+            this->Close();
+            return false;
+        }
+        this->data = (const char*)MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+        this->fd = open(path.c_str(), O_RDONLY);
+        if(this->fd < 0)
+            return false;
+        struct stat info;
+        if(fstat(this->fd, &info) != 0)
+        {
+            this->Close();
+            return false;
+        }
+        this->size = size_t(info.st_size);
+        if(this->size == 0)
+            return true;
+        void* view = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+        this->data = (view == MAP_FAILED) ? nullptr : (const char*)view;
+#endif
+        if(!this->data)
+        {
+            this->Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close()
+    {
+#ifdef _WIN32
+        if(this->data)
+            UnmapViewOfFile(this->data);
+        if(this->mapping)
+            CloseHandle(this->mapping);
+        if(this->file != INVALID_HANDLE_VALUE)
+            CloseHandle(this->file);
+        this->file = INVALID_HANDLE_VALUE;
+        this->mapping = NULL;
+#else
+        if(this->data)
+            munmap((void*)this->data, this->size);
+        if(this->fd >= 0)
+            close(this->fd);
+        this->fd = -1;
+#endif
+        this->data = nullptr;
+        this->size = 0;
+    }
+
+    const char* Data() const
+    {
+        return this->data;
+    }
+
+    size_t Size() const
+    {
+        return this->size;
+    }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+};
+
+#endif
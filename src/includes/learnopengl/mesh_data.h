@@ -0,0 +1,35 @@
+#ifndef MESH_DATA_H
+#define MESH_DATA_H
+
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <learnopengl/mesh.h>
+
+// 网格的 CPU 端数据（顶点格式与 Mesh 相同），可以在任意线程中生成
+struct MeshData
+{
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> indices;
+    GLuint material; // ModelData::materials 中的下标
+};
+
+// 材质只记录贴图文件（相对模型目录），贴图在主线程中载入
+struct MaterialData
+{
+    std::string name;
+    std::vector<std::string> diffuseMaps;
+    std::vector<std::string> specularMaps;
+};
+
+// 模型的 CPU 端数据
+struct ModelData
+{
+    std::string directory;
+    std::vector<MeshData> meshes;
+    std::vector<MaterialData> materials;
+};
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef MIPMAP_H
+#define MIPMAP_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <GL/glew.h>
+
+#include <learnopengl/parallel.h>
+#include <learnopengl/simd.h>
+
+// == ======================================
+// CPU 端生成 mipmap
+// glGenerateMipmap 在 GL 线程中执行，而且是各驱动实现不一的盒式滤波。
+// 这里在工作线程中逐级缩小：
+// 1. 8 位 sRGB 先转换到线性空间，在线性空间中滤波，再转回 sRGB，避免暗部被抹亮；
+// 2. 可分离滤波，先纵向后横向。纵向一趟对整行做 dst += w * src，每次 4 个 float；
+//    横向一趟每个像素的所有通道放在一个 Float4 中累加（simd.h）；
+// 3. 采样按 GL_REPEAT 环绕，与贴图的寻址方式一致；
+// 4. 每一级都由上一级（float）生成，最后一次性转换成 8 位。
+// == ======================================
+enum MipFilter
+{
+    MIP_NONE,     // 不在 CPU 生成，由 glGenerateMipmap 生成
+    MIP_BOX,      // 盒式（2x2 平均）
+    MIP_LANCZOS3, // Lanczos，半径 3
+    MIP_KAISER    // Kaiser 窗 sinc，半径 3，alpha 4
+};
+
+namespace mip_detail
+{
+    inline GLfloat Sinc(GLfloat x)
+    {
+        if(std::fabs(x) < 1e-6f)
+            return 1.0f;
+        x *= 3.14159265f;
+        return std::sin(x) / x;
+    }
+
+    // 第一类零阶修正贝塞尔函数（级数展开）
+    inline GLdouble BesselI0(GLdouble x)
+    {
+        GLdouble sum = 1.0, term = 1.0, half = x * 0.5;
+        for(GLint k = 1; k < 32; k++)
+        {
+            term *= (half / k) * (half / k);
+            sum += term;
+            if(term < sum * 1e-12)
+                break;
+        }
+        return sum;
+    }
+
+    inline GLfloat Radius(MipFilter filter)
+    {
+        return (filter == MIP_BOX) ? 0.5f : 3.0f;
+    }
+
+    inline GLfloat Kernel(MipFilter filter, GLfloat x)
+    {
+        GLfloat radius = Radius(filter);
+        if(std::fabs(x) >= radius)
+            return 0.0f;
+        switch(filter)
+        {
+        case MIP_BOX:
+            return 1.0f;
+        case MIP_LANCZOS3:
+            return Sinc(x) * Sinc(x / radius);
+        case MIP_KAISER:
+        default:
+        {
+            const GLdouble alpha = 4.0;
+            GLdouble t = x / radius;
+            return GLfloat(Sinc(x) * BesselI0(alpha * std::sqrt(1.0 - t * t)) / BesselI0(alpha));
+        }
+        }
+    }
+
+    // 一维缩放的采样表：每个目标像素的源下标（已环绕）和归一化权重
+    struct FilterTaps
+    {
+        GLint taps; // 每个目标像素的采样数
+        std::vector<GLint> indices;
+        std::vector<GLfloat> weights;
+    };
+
+    inline FilterTaps BuildTaps(GLint srcSize, GLint dstSize, MipFilter filter)
+    {
+        FilterTaps result;
+        GLfloat scale = GLfloat(srcSize) / dstSize;
+        GLfloat support = Radius(filter) * scale;
+        result.taps = GLint(std::ceil(support * 2.0f)) + 1;
+        result.indices.resize(size_t(dstSize) * result.taps);
+        result.weights.resize(size_t(dstSize) * result.taps);
+        for(GLint i = 0; i < dstSize; i++)
+        {
+            GLfloat center = (i + 0.5f) * scale;
+            GLint first = GLint(std::floor(center - support));
+            GLfloat total = 0.0f;
+            for(GLint k = 0; k < result.taps; k++)
+            {
+                GLint j = first + k;
+                GLfloat w = Kernel(filter, (j + 0.5f - center) / scale);
+                result.indices[size_t(i) * result.taps + k] = ((j % srcSize) + srcSize) % srcSize;
+                result.weights[size_t(i) * result.taps + k] = w;
+                total += w;
+            }
+            for(GLint k = 0; k < result.taps; k++)
+                result.weights[size_t(i) * result.taps + k] /= (total != 0.0f) ? total : 1.0f;
+        }
+        return result;
+    }
+
+    // sRGB <-> 线性（查表；局部静态变量的初始化是线程安全的）
+    inline std::vector<GLfloat> BuildSrgbToLinear()
+    {
+        std::vector<GLfloat> values(256);
+        for(GLint i = 0; i < 256; i++)
+        {
+            GLfloat c = i / 255.0f;
+            values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }
+
+    const GLint LINEAR_STEPS = 4096;
+
+    inline std::vector<unsigned char> BuildLinearToSrgb()
+    {
+        std::vector<unsigned char> values(LINEAR_STEPS + 1);
+        for(GLint i = 0; i <= LINEAR_STEPS; i++)
+        {
+            GLfloat l = GLfloat(i) / LINEAR_STEPS;
+            GLfloat c = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            values[i] = (unsigned char)std::min(255.0f, std::max(0.0f, c * 255.0f + 0.5f));
+        }
+        return values;
+    }
+
+    inline const GLfloat* SrgbToLinearTable()
+    {
+        static const std::vector<GLfloat> table = BuildSrgbToLinear();
+        return &table[0];
+    }
+
+    inline const unsigned char* LinearToSrgbTable()
+    {
+        static const std::vector<unsigned char> table = BuildLinearToSrgb();
+        return &table[0];
+    }
+
+    // 缩小一级：src 为 srcW x srcH x channels 的 float 数组
+    inline void Downsample(const std::vector<GLfloat>& src, GLint srcW, GLint srcH, GLint channels,
+                           std::vector<GLfloat>& dst, GLint dstW, GLint dstH, MipFilter filter, GLuint threadCount)
+    {
+        FilterTaps vertical = BuildTaps(srcH, dstH, filter);
+        FilterTaps horizontal = BuildTaps(srcW, dstW, filter);
+        size_t srcRow = size_t(srcW) * channels;
+        // 很小的级别不值得开线程
+        GLuint threads = (size_t(srcW) * srcH < 128 * 128) ? 1u : threadCount;
+
+        // 1. 纵向：srcH 行 -> dstH 行（宽度不变）
+        std::vector<GLfloat> temp(size_t(dstH) * srcRow);
+        ParallelRanges(size_t(dstH), threads, [&](size_t begin, size_t end, GLuint)
+        {
+            for(size_t y = begin; y < end; y++)
+            {
+                GLfloat* out = &temp[y * srcRow];
+                std::fill(out, out + srcRow, 0.0f);
+                for(GLint k = 0; k < vertical.taps; k++)
+                {
+                    GLfloat w = vertical.weights[y * vertical.taps + k];
+                    if(w == 0.0f)
+                        continue;
+                    const GLfloat* in = &src[size_t(vertical.indices[y * vertical.taps + k]) * srcRow];
+                    Float4 weight = Float4Set(w);
+                    for(size_t x = 0; x < srcRow; x += 4)
+                    {
+                        size_t n = srcRow - x;
+                        Float4StoreN(out + x, Float4LoadN(out + x, n) + weight * Float4LoadN(in + x, n), n);
+                    }
+                }
+            }
+        });
+
+        // 2. 横向：srcW 列 -> dstW 列
+        dst.assign(size_t(dstW) * dstH * channels, 0.0f);
+        ParallelRanges(size_t(dstH), threads, [&](size_t begin, size_t end, GLuint)
+        {
+            for(size_t y = begin; y < end; y++)
+            {
+                const GLfloat* in = &temp[y * srcRow];
+                GLfloat* out = &dst[y * dstW * channels];
+                for(GLint x = 0; x < dstW; x++)
+                {
+                    const GLint* indices = &horizontal.indices[size_t(x) * horizontal.taps];
+                    const GLfloat* weights = &horizontal.weights[size_t(x) * horizontal.taps];
+                    if(channels <= 4)
+                    {
+                        Float4 sum = Float4Set(0.0f);
+                        for(GLint k = 0; k < horizontal.taps; k++)
+                            sum = sum + Float4Set(weights[k]) * Float4LoadN(in + indices[k] * channels, size_t(channels));
+                        Float4StoreN(out + x * channels, sum, size_t(channels));
+                        continue;
+                    }
+                    for(GLint k = 0; k < horizontal.taps; k++)
+                        for(GLint c = 0; c < channels; c++)
+                            out[x * channels + c] += weights[k] * in[indices[k] * channels + c];
+                }
+            }
+        });
+    }
+}
+
+// 生成 8 位图像的 mip 链（不含第 0 级），levels[i] 为第 i+1 级，尺寸按 GL 规则逐级减半（向下取整，最小为 1）。
+// srgb 为 true 时先转到线性空间再滤波；镜面、法线等不是颜色的贴图传 false，直接对编码值滤波。threadCount 为每一级内部使用的线程数
+// （在已经并行的解码任务中调用时应为 1，避免线程过多）。
+inline std::vector<std::vector<unsigned char> > GenerateMipChain(const unsigned char* pixels, GLint width, GLint height, GLint channels,
+                                                                 MipFilter filter = MIP_KAISER, bool srgb = true, GLuint threadCount = 1)
+{
+    using namespace mip_detail;
+    std::vector<std::vector<unsigned char> > levels;
+    if(filter == MIP_NONE || width <= 0 || height <= 0)
+        return levels;
+
+    const GLfloat* toLinear = SrgbToLinearTable();
+    const unsigned char* toSrgb = LinearToSrgbTable();
+    std::vector<GLfloat> current(size_t(width) * height * channels), next;
+    for(size_t i = 0; i < current.size(); i++)
+        current[i] = srgb ? toLinear[pixels[i]] : pixels[i] / 255.0f;
+
+    GLint w = width, h = height;
+    while(w > 1 || h > 1)
+    {
+        GLint nw = std::max(w / 2, 1), nh = std::max(h / 2, 1);
+        Downsample(current, w, h, channels, next, nw, nh, filter, threadCount);
+
+        std::vector<unsigned char> level(next.size());
+        for(size_t i = 0; i < next.size(); i++)
+        {
+            GLfloat v = std::min(std::max(next[i], 0.0f), 1.0f); // Lanczos/Kaiser 有负瓣，可能越界
+            level[i] = srgb ? toSrgb[GLint(v * LINEAR_STEPS + 0.5f)] : (unsigned char)(v * 255.0f + 0.5f);
+        }
+        levels.push_back(level);
+        current.swap(next);
+        w = nw;
+        h = nh;
+    }
+    return levels;
+}
+
+#endif
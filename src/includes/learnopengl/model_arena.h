@@ -0,0 +1,352 @@
+#ifndef MODEL_ARENA_H
+#define MODEL_ARENA_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/shader.h>
+#include <learnopengl/model_data.h>
+#include <learnopengl/vertex_packing.h>
+#include <learnopengl/texture_array.h>
+
+// == ======================================
+// 连续存储的模型
+// Model 的每个 Mesh 各自持有顶点、索引、贴图三个 vector 以及一组 VAO/VBO/EBO。
+// 这里把整个模型的顶点和索引放进两块连续数组，网格只记录自己的范围；
+// 上传时整个模型只有一个 VBO 和一个 EBO，绘制时用 glDrawElementsBaseVertex 定位网格。
+// == ======================================
+
+// 网格在模型数组中的范围（索引保持网格内的局部下标，由 baseVertex 偏移）
+struct MeshRange
+{
+    GLint  baseVertex;
+    GLuint vertexCount;
+    GLuint firstIndex;
+    GLuint indexCount;
+    GLuint material;
+};
+
+// 模型的 CPU 端连续数据，可以在任意线程中生成
+struct ModelArena
+{
+    std::string directory;
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> indices;
+    std::vector<MeshRange> ranges;
+    std::vector<MaterialData> materials;
+};
+
+// 把 ModelData 打包成连续数组：先统计总量一次分配，再依次复制；
+// 相同材质的网格排在一起，绘制时减少贴图切换
+inline void BuildArena(const ModelData& data, ModelArena& arena)
+{
+    arena.directory = data.directory;
+    arena.materials = data.materials;
+
+    size_t vertexCount = 0, indexCount = 0;
+    for(const MeshData& mesh : data.meshes)
+    {
+        vertexCount += mesh.vertices.size();
+        indexCount += mesh.indices.size();
+    }
+    arena.vertices.clear();
+    arena.indices.clear();
+    arena.ranges.clear();
+    arena.vertices.reserve(vertexCount);
+    arena.indices.reserve(indexCount);
+    arena.ranges.reserve(data.meshes.size());
+
+    std::vector<GLuint> order(data.meshes.size());
+    for(GLuint i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](GLuint a, GLuint b)
+    {
+        return data.meshes[a].material < data.meshes[b].material;
+    });
+
+    for(GLuint i : order)
+    {
+        const MeshData& mesh = data.meshes[i];
+        MeshRange range;
+        range.baseVertex  = GLint(arena.vertices.size());
+        range.vertexCount = GLuint(mesh.vertices.size());
+        range.firstIndex  = GLuint(arena.indices.size());
+        range.indexCount  = GLuint(mesh.indices.size());
+        range.material    = mesh.material;
+        arena.vertices.insert(arena.vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        arena.indices.insert(arena.indices.end(), mesh.indices.begin(), mesh.indices.end());
+        arena.ranges.push_back(range);
+    }
+}
+
+// 静态合批：把材质相同的相邻网格合并成一个范围（BuildArena 已按材质排序，
+// 因此每个材质只剩一次绘制）。合并后的索引改为相对批次第一个顶点，
+// 顶点和索引数组本身不移动。批次的 material 即绘制时使用的材质（贴图）下标。
+inline void MergeRangesByMaterial(ModelArena& arena)
+{
+    std::vector<MeshRange> batches;
+    for(const MeshRange& range : arena.ranges)
+    {
+        bool contiguous = !batches.empty()
+            && batches.back().material == range.material
+            && GLuint(batches.back().baseVertex) + batches.back().vertexCount == GLuint(range.baseVertex)
+            && batches.back().firstIndex + batches.back().indexCount == range.firstIndex;
+        if(!contiguous)
+        {
+            batches.push_back(range);
+            continue;
+        }
+        MeshRange& batch = batches.back();
+        GLuint offset = GLuint(range.baseVertex - batch.baseVertex);
+        for(GLuint i = range.firstIndex; i < range.firstIndex + range.indexCount; i++)
+            arena.indices[i] += offset;
+        batch.vertexCount += range.vertexCount;
+        batch.indexCount += range.indexCount;
+    }
+    arena.ranges.swap(batches);
+}
+
+// 由 ModelArena 创建的可绘制模型：一个 VAO/VBO/EBO
+// packed 为 true 时顶点使用压缩格式（每个网格按自己的包围盒量化），着色器需要打开 PACKED_VERTICES；
+// textureArray 为 true 时所有贴图放进一个贴图数组（texture_array.h），整个模型只绑定一次贴图，
+// 每次绘制只更新层和 UV 矩形，着色器需要打开 TEXTURE_ARRAY。
+class ArenaModel
+{
+public:
+    std::vector<MeshRange> ranges;
+    std::vector<PackedBounds> bounds; // 每个网格的位置还原参数（仅压缩格式）
+    std::vector<std::vector<Texture> > materialTextures; // 每个材质的贴图
+    std::vector<Texture> textures_loaded;
+    TextureArray textureArray;
+    std::vector<glm::ivec2> materialSlots; // 每个材质的漫反射、镜面贴图在 textureArray.slots 中的下标（没有为 -1）
+    std::string directory;
+
+    // 必须在 OpenGL 上下文所在的线程中调用
+    ArenaModel(const ModelArena& arena, GLuint threadCount = 0, bool packed = false, bool textureArray = false)
+        : packed(packed), useTextureArray(textureArray)
+    {
+        this->directory = arena.directory;
+        this->ranges = arena.ranges;
+        if(this->useTextureArray)
+        {
+            MaterialFiles files = CollectMaterialFiles(arena.materials, this->directory);
+            std::vector<DecodedImage> images = DecodeImages(files.files, threadCount, MIP_NONE, files.linear);
+            this->textureArray.Build(images, MIP_KAISER, threadCount);
+            ReleaseImages(images);
+            this->materialSlots.assign(arena.materials.size(), glm::ivec2(-1, -1));
+            for(GLuint m = 0; m < arena.materials.size(); m++)
+            {
+                if(!arena.materials[m].diffuseMaps.empty())
+                    this->materialSlots[m].x = GLint(files.references[m][0]);
+                if(!arena.materials[m].specularMaps.empty())
+                    this->materialSlots[m].y = GLint(files.references[m][arena.materials[m].diffuseMaps.size()]);
+            }
+        }
+        else
+            this->materialTextures = LoadMaterialTextures(arena.materials, this->directory, threadCount, this->textures_loaded);
+        this->setupBuffers(arena.vertices, arena.indices);
+    }
+
+    void Draw(Shader shader)
+    {
+        this->Draw(shader.Program);
+    }
+
+    // 与 Mesh::Draw 相同的贴图绑定规则；相邻网格材质相同时不重复绑定
+    void Draw(GLuint program)
+    {
+        GLint minLoc = -1, scaleLoc = -1;
+        if(this->packed)
+        {
+            minLoc = glGetUniformLocation(program, "positionMin");
+            scaleLoc = glGetUniformLocation(program, "positionScale");
+        }
+
+        SlotLocations slotLocs = { -1, -1, -1, -1 };
+        if(this->useTextureArray)
+        {
+            // 整个模型只绑定一次
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, this->textureArray.id);
+            glUniform1i(glGetUniformLocation(program, "materialTextures"), 0);
+            glUniform1f(glGetUniformLocation(program, "material.shininess"), 16.0f);
+            slotLocs.diffuseLayer  = glGetUniformLocation(program, "diffuseLayer");
+            slotLocs.diffuseRect   = glGetUniformLocation(program, "diffuseRect");
+            slotLocs.specularLayer = glGetUniformLocation(program, "specularLayer");
+            slotLocs.specularRect  = glGetUniformLocation(program, "specularRect");
+        }
+
+        glBindVertexArray(this->VAO);
+        GLuint boundMaterial = ~0u;
+        GLuint boundCount = 0;
+        for(GLuint r = 0; r < this->ranges.size(); r++)
+        {
+            const MeshRange& range = this->ranges[r];
+            if(range.material != boundMaterial && this->useTextureArray)
+            {
+                boundMaterial = range.material;
+                this->setSlots(slotLocs, range.material);
+            }
+            else if(range.material != boundMaterial)
+            {
+                boundMaterial = range.material;
+                GLuint count = this->bindTextures(program, range.material);
+                // 上一个材质多出来的贴图单元要解绑
+                for(GLuint i = count; i < boundCount; i++)
+                {
+                    glActiveTexture(GL_TEXTURE0 + i);
+                    glBindTexture(GL_TEXTURE_2D, 0);
+                }
+                boundCount = count;
+            }
+            if(this->packed)
+            {
+                glUniform3fv(minLoc, 1, &this->bounds[r].min[0]);
+                glUniform3fv(scaleLoc, 1, &this->bounds[r].scale[0]);
+            }
+            glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+                                     (GLvoid*)(range.firstIndex * sizeof(GLuint)), range.baseVertex);
+        }
+        glBindVertexArray(0);
+
+        if(this->useTextureArray)
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        for(GLuint i = 0; i < boundCount; i++)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+    }
+
+    // 只画深度（深度预渲染，depth_prepass.h）：只有位置属性的 VAO，不绑定贴图
+    void DrawDepth(GLuint program)
+    {
+        GLint minLoc = -1, scaleLoc = -1;
+        if(this->packed)
+        {
+            minLoc = glGetUniformLocation(program, "positionMin");
+            scaleLoc = glGetUniformLocation(program, "positionScale");
+        }
+        glBindVertexArray(this->depthVAO);
+        for(GLuint r = 0; r < this->ranges.size(); r++)
+        {
+            const MeshRange& range = this->ranges[r];
+            if(this->packed)
+            {
+                glUniform3fv(minLoc, 1, &this->bounds[r].min[0]);
+                glUniform3fv(scaleLoc, 1, &this->bounds[r].scale[0]);
+            }
+            glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+                                     (GLvoid*)(range.firstIndex * sizeof(GLuint)), range.baseVertex);
+        }
+        glBindVertexArray(0);
+    }
+
+    // 绘制调用次数（每个范围一次；合批后等于材质数）
+    GLuint DrawCount() const
+    {
+        return GLuint(this->ranges.size());
+    }
+
+private:
+    struct SlotLocations
+    {
+        GLint diffuseLayer, diffuseRect, specularLayer, specularRect;
+    };
+
+    GLuint VAO, depthVAO, VBO, EBO;
+    bool packed;
+    bool useTextureArray;
+
+    // 材质贴图在数组中的层和 UV 矩形（层为 -1 表示没有该贴图）
+    void setSlots(const SlotLocations& locs, GLuint material)
+    {
+        glm::ivec2 slots = (material < this->materialSlots.size()) ? this->materialSlots[material] : glm::ivec2(-1, -1);
+        const glm::vec4 fullRect(0.0f, 0.0f, 1.0f, 1.0f);
+        const TextureSlot* diffuse = (slots.x >= 0) ? &this->textureArray.slots[slots.x] : nullptr;
+        const TextureSlot* specular = (slots.y >= 0) ? &this->textureArray.slots[slots.y] : nullptr;
+        glUniform1f(locs.diffuseLayer, diffuse ? GLfloat(diffuse->layer) : -1.0f);
+        glUniform4fv(locs.diffuseRect, 1, diffuse ? &diffuse->rect.x : &fullRect.x);
+        glUniform1f(locs.specularLayer, specular ? GLfloat(specular->layer) : -1.0f);
+        glUniform4fv(locs.specularRect, 1, specular ? &specular->rect.x : &fullRect.x);
+    }
+
+    GLuint bindTextures(GLuint program, GLuint material)
+    {
+        if(material >= this->materialTextures.size())
+            return 0;
+        const std::vector<Texture>& textures = this->materialTextures[material];
+        GLuint diffuseNr = 1;
+        GLuint specularNr = 1;
+        for(GLuint i = 0; i < textures.size(); i++)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            std::string name = textures[i].type;
+            std::string number = (name == "texture_diffuse") ? std::to_string(diffuseNr++) : std::to_string(specularNr++);
+            glUniform1i(glGetUniformLocation(program, (name + number).c_str()), i);
+            glBindTexture(GL_TEXTURE_2D, textures[i].id);
+        }
+        glUniform1f(glGetUniformLocation(program, "material.shininess"), 16.0f);
+        return GLuint(textures.size());
+    }
+
+    void setupBuffers(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+    {
+        glGenVertexArrays(1, &this->VAO);
+        glGenBuffers(1, &this->VBO);
+        glGenBuffers(1, &this->EBO);
+
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        if(this->packed)
+        {
+            // 每个网格按自己的包围盒量化
+            std::vector<PackedVertex> packedVertices;
+            packedVertices.reserve(vertices.size());
+            for(const MeshRange& range : this->ranges)
+                this->bounds.push_back(PackVertices(vertices.empty() ? nullptr : &vertices[range.baseVertex], range.vertexCount, packedVertices));
+            glBufferData(GL_ARRAY_BUFFER, packedVertices.size() * sizeof(PackedVertex), packedVertices.empty() ? nullptr : &packedVertices[0], GL_STATIC_DRAW);
+        }
+        else
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.empty() ? nullptr : &vertices[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.empty() ? nullptr : &indices[0], GL_STATIC_DRAW);
+
+        if(this->packed)
+            SetupPackedAttributes();
+        else
+        {
+            // Vertex Positions
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
+            // Vertex Normals
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, Normal));
+            // Vertex Texture Coords
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, TexCoords));
+        }
+
+        // 只有位置属性的 VAO，共用 VBO/EBO
+        glGenVertexArrays(1, &this->depthVAO);
+        glBindVertexArray(this->depthVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
+        if(this->packed)
+            SetupPackedPositionAttribute();
+        else
+        {
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
+        }
+
+        glBindVertexArray(0);
+    }
+};
+
+#endif
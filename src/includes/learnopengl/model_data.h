@@ -0,0 +1,106 @@
+#ifndef MODEL_DATA_H
+#define MODEL_DATA_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <learnopengl/shader.h>
+#include <learnopengl/model.h>
+#include <learnopengl/texture_loader.h>
+#include <learnopengl/mesh_data.h>
+
+// 材质引用的贴图文件（按路径去重，与 Model::loadMaterialTextures 相同）
+struct MaterialFiles
+{
+    std::vector<std::string> files;                 // 完整路径
+    std::vector<std::string> types;                 // texture_diffuse / texture_specular
+    std::vector<bool> linear;                       // 镜面贴图不是颜色，mip 链不做 sRGB 转换
+    std::vector<std::vector<GLuint> > references;   // 每个材质引用的 files 下标（先漫反射后镜面）
+};
+
+inline MaterialFiles CollectMaterialFiles(const std::vector<MaterialData>& materials, const std::string& directory)
+{
+    MaterialFiles result;
+    std::map<std::string, GLuint> pathIndex; // 路径 -> files 下标
+    result.references.resize(materials.size());
+    for(GLuint m = 0; m < materials.size(); m++)
+    {
+        for(GLuint t = 0; t < 2; t++)
+        {
+            const std::vector<std::string>& paths = (t == 0) ? materials[m].diffuseMaps : materials[m].specularMaps;
+            for(const std::string& path : paths)
+            {
+                auto found = pathIndex.find(path);
+                if(found == pathIndex.end())
+                {
+                    found = pathIndex.insert(std::make_pair(path, GLuint(result.files.size()))).first;
+                    result.files.push_back(directory + '/' + path);
+                    result.types.push_back((t == 0) ? "texture_diffuse" : "texture_specular");
+                    result.linear.push_back(t != 0);
+                }
+                result.references[m].push_back(found->second);
+            }
+        }
+    }
+    return result;
+}
+
+// 载入所有材质的贴图（必须在 OpenGL 上下文所在的线程中调用）
+// 贴图去重后在 threadCount 个线程中并行解码并生成 mip 链，再在本线程中依次上传。
+// 新贴图追加到 loaded，返回每个材质引用的贴图。
+inline std::vector<std::vector<Texture> > LoadMaterialTextures(const std::vector<MaterialData>& materials, const std::string& directory,
+                                                               GLuint threadCount, std::vector<Texture>& loaded,
+                                                               MipFilter mipFilter = MIP_KAISER)
+{
+    MaterialFiles files = CollectMaterialFiles(materials, directory);
+    std::vector<DecodedImage> images = DecodeImages(files.files, threadCount, mipFilter, files.linear);
+    GLuint first = GLuint(loaded.size());
+    for(GLuint i = 0; i < images.size(); i++)
+    {
+        Texture texture;
+        texture.id = UploadTexture(images[i]);
+        texture.type = files.types[i];
+        loaded.push_back(texture);
+        ReleaseImage(images[i]);
+    }
+
+    std::vector<std::vector<Texture> > materialTextures(materials.size());
+    for(GLuint m = 0; m < materials.size(); m++)
+        for(GLuint file : files.references[m])
+            materialTextures[m].push_back(loaded[first + file]);
+    return materialTextures;
+}
+
+// 由 ModelData 创建的可绘制模型，接口与 Model 相同
+class MeshModel
+{
+public:
+    std::vector<Mesh> meshes;
+    std::vector<Texture> textures_loaded;
+    std::string directory;
+
+    // 必须在 OpenGL 上下文所在的线程中调用
+    MeshModel(const ModelData& data, GLuint threadCount = 0)
+    {
+        this->directory = data.directory;
+        std::vector<std::vector<Texture> > materialTextures = LoadMaterialTextures(data.materials, this->directory, threadCount, this->textures_loaded);
+        for(const MeshData& mesh : data.meshes)
+        {
+            std::vector<Texture> textures;
+            if(mesh.material < materialTextures.size())
+                textures = materialTextures[mesh.material];
+            this->meshes.push_back(Mesh(mesh.vertices, mesh.indices, textures));
+        }
+    }
+
+    void Draw(Shader shader)
+    {
+        for(GLuint i = 0; i < this->meshes.size(); i++)
+            this->meshes[i].Draw(shader);
+    }
+};
+
+#endif
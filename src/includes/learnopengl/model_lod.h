@@ -0,0 +1,455 @@
+#ifndef MODEL_LOD_H
+#define MODEL_LOD_H
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_map>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/shader.h>
+#include <learnopengl/camera.h>
+#include <learnopengl/model.h>
+#include <learnopengl/model_data.h>
+
+// == ======================================
+// 网格简化：二次误差度量（QEM）+ 半边折叠
+// 顶点只会折叠到已有的邻接顶点上，不会生成新顶点，
+// 因此所有 LOD 级别共用同一份顶点缓冲，只是索引不同。
+// == ======================================
+namespace lod_detail
+{
+    // 对称 4x4 矩阵，只保存上三角；weight 为累计的面积权重
+    struct Quadric
+    {
+        GLdouble a00, a01, a02, a03, a11, a12, a13, a22, a23, a33, weight;
+
+        Quadric() : a00(0), a01(0), a02(0), a03(0), a11(0), a12(0), a13(0), a22(0), a23(0), a33(0), weight(0) { }
+
+        // 加入平面 n·p + d = 0，权重为三角形面积
+        void AddPlane(const glm::vec3& n, GLdouble d, GLdouble w)
+        {
+            a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z; a03 += w * n.x * d;
+            a11 += w * n.y * n.y; a12 += w * n.y * n.z; a13 += w * n.y * d;
+            a22 += w * n.z * n.z; a23 += w * n.z * d;
+            a33 += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& q)
+        {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+            a11 += q.a11; a12 += q.a12; a13 += q.a13;
+            a22 += q.a22; a23 += q.a23;
+            a33 += q.a33;
+            weight += q.weight;
+        }
+
+        // 点到平面集合的加权平均距离平方
+        GLdouble Error(const glm::vec3& p) const
+        {
+            if(weight <= 0)
+                return 0;
+            GLdouble x = p.x, y = p.y, z = p.z;
+            GLdouble e = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x
+                       + a11 * y * y + 2 * a12 * y * z + 2 * a13 * y
+                       + a22 * z * z + 2 * a23 * z
+                       + a33;
+            return e > 0 ? e / weight : 0;
+        }
+    };
+
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3& p) const
+        {
+            GLuint h[3];
+            std::memcpy(h, &p.x, sizeof(h));
+            return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+        }
+    };
+
+    struct Collapse
+    {
+        GLuint from, to;
+        GLdouble cost;
+        bool operator<(const Collapse& other) const { return cost < other.cost; }
+    };
+
+    inline unsigned long long EdgeKey(GLuint a, GLuint b)
+    {
+        if(a > b)
+            std::swap(a, b);
+        return ((unsigned long long)a << 32) | b;
+    }
+}
+
+// 把 indices 简化到 targetIndexCount 个索引左右，返回新的索引列表。
+// error 返回这次简化引入的最大几何误差（模型空间的距离）。
+// UV/法线接缝上的顶点（位置相同但属性不同）和开放边界上的顶点被锁定，不会被折叠。
+inline std::vector<GLuint> SimplifyMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices,
+                                        size_t targetIndexCount, GLfloat& error)
+{
+    using namespace lod_detail;
+
+    size_t vertexCount = vertices.size();
+    std::vector<GLuint> result(indices);
+    error = 0.0f;
+
+    // 1. 位置相同的顶点归为一组，组内多于一个顶点即为接缝
+    std::vector<GLuint> canonical(vertexCount);
+    std::vector<GLuint> groupSize(vertexCount, 0);
+    std::unordered_map<glm::vec3, GLuint, PositionHash> positions;
+    for(GLuint i = 0; i < vertexCount; i++)
+    {
+        auto inserted = positions.insert(std::make_pair(vertices[i].Position, i));
+        canonical[i] = inserted.first->second;
+        groupSize[canonical[i]]++;
+    }
+
+    std::vector<char> locked(vertexCount, 0);
+    for(GLuint i = 0; i < vertexCount; i++)
+        if(groupSize[canonical[i]] > 1)
+            locked[i] = 1;
+
+    // 2. 只被一个三角形使用的边是开放边界
+    std::unordered_map<unsigned long long, GLuint> edgeUse;
+    for(size_t t = 0; t + 2 < result.size(); t += 3)
+        for(GLuint e = 0; e < 3; e++)
+            edgeUse[EdgeKey(canonical[result[t + e]], canonical[result[t + (e + 1) % 3]])]++;
+    for(size_t t = 0; t + 2 < result.size(); t += 3)
+        for(GLuint e = 0; e < 3; e++)
+        {
+            GLuint a = result[t + e], b = result[t + (e + 1) % 3];
+            if(edgeUse[EdgeKey(canonical[a], canonical[b])] == 1)
+                locked[a] = locked[b] = 1;
+        }
+
+    // 3. 每个顶点的误差矩阵由周围三角形的平面累加，接缝组共享同一个
+    std::vector<Quadric> quadrics(vertexCount);
+    for(size_t t = 0; t + 2 < result.size(); t += 3)
+    {
+        glm::vec3 p0 = vertices[result[t]].Position;
+        glm::vec3 p1 = vertices[result[t + 1]].Position;
+        glm::vec3 p2 = vertices[result[t + 2]].Position;
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        GLfloat area = glm::length(n);
+        if(area <= 0.0f)
+            continue;
+        n /= area;
+        Quadric q;
+        q.AddPlane(n, -glm::dot(n, p0), area * 0.5);
+        for(GLuint k = 0; k < 3; k++)
+            quadrics[canonical[result[t + k]]].Add(q);
+    }
+    for(GLuint i = 0; i < vertexCount; i++)
+        quadrics[i] = quadrics[canonical[i]];
+
+    // 4. 分批折叠：每一批按代价排序，受影响的顶点本批内不再参与
+    GLdouble maxError = 0.0;
+    std::vector<GLuint> triOffsets, triList, collapseTo(vertexCount);
+    std::vector<char> touched(vertexCount);
+    while(result.size() > targetIndexCount)
+    {
+        // 顶点 -> 三角形邻接表
+        triOffsets.assign(vertexCount + 1, 0);
+        for(size_t i = 0; i < result.size(); i++)
+            triOffsets[result[i] + 1]++;
+        for(size_t i = 0; i < vertexCount; i++)
+            triOffsets[i + 1] += triOffsets[i];
+        triList.resize(result.size());
+        std::vector<GLuint> fill(triOffsets.begin(), triOffsets.end() - 1);
+        for(size_t i = 0; i < result.size(); i++)
+            triList[fill[result[i]]++] = GLuint(i / 3);
+
+        std::vector<Collapse> candidates;
+        for(size_t t = 0; t + 2 < result.size(); t += 3)
+            for(GLuint e = 0; e < 3; e++)
+            {
+                GLuint a = result[t + e], b = result[t + (e + 1) % 3];
+                Quadric q;
+                if(!locked[a])
+                {
+                    q = quadrics[a];
+                    q.Add(quadrics[b]);
+                    Collapse c = { a, b, q.Error(vertices[b].Position) };
+                    candidates.push_back(c);
+                }
+                if(!locked[b])
+                {
+                    q = quadrics[b];
+                    q.Add(quadrics[a]);
+                    Collapse c = { b, a, q.Error(vertices[a].Position) };
+                    candidates.push_back(c);
+                }
+            }
+        if(candidates.empty())
+            break;
+        std::sort(candidates.begin(), candidates.end());
+
+        for(GLuint i = 0; i < vertexCount; i++)
+            collapseTo[i] = i;
+        std::fill(touched.begin(), touched.end(), 0);
+
+        size_t trianglesToRemove = (result.size() - targetIndexCount) / 3 + 1;
+        size_t removed = 0;
+        for(size_t c = 0; c < candidates.size() && removed < trianglesToRemove; c++)
+        {
+            GLuint from = candidates[c].from, to = candidates[c].to;
+            if(touched[from] || touched[to])
+                continue;
+
+            // 折叠后三角形不能翻面
+            bool flipped = false;
+            size_t shared = 0;
+            for(GLuint k = triOffsets[from]; k < triOffsets[from + 1] && !flipped; k++)
+            {
+                const GLuint* tri = &result[triList[k] * 3];
+                if(tri[0] == to || tri[1] == to || tri[2] == to)
+                {
+                    shared++;
+                    continue;
+                }
+                glm::vec3 p[3], q[3];
+                for(GLuint v = 0; v < 3; v++)
+                {
+                    p[v] = vertices[tri[v]].Position;
+                    q[v] = (tri[v] == from) ? vertices[to].Position : p[v];
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 after  = glm::cross(q[1] - q[0], q[2] - q[0]);
+                if(glm::dot(before, after) <= 0.0f)
+                    flipped = true;
+            }
+            if(flipped)
+                continue;
+
+            collapseTo[from] = to;
+            quadrics[to].Add(quadrics[from]);
+            maxError = std::max(maxError, candidates[c].cost);
+            removed += shared;
+            for(GLuint k = triOffsets[from]; k < triOffsets[from + 1]; k++)
+            {
+                const GLuint* tri = &result[triList[k] * 3];
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+            }
+        }
+        if(removed == 0)
+            break;
+
+        // 重写索引，去掉退化三角形
+        size_t write = 0;
+        for(size_t t = 0; t + 2 < result.size(); t += 3)
+        {
+            GLuint a = collapseTo[result[t]], b = collapseTo[result[t + 1]], c = collapseTo[result[t + 2]];
+            if(a == b || b == c || a == c)
+                continue;
+            result[write++] = a;
+            result[write++] = b;
+            result[write++] = c;
+        }
+        result.resize(write);
+    }
+
+    error = GLfloat(std::sqrt(maxError));
+    return result;
+}
+
+// 一个 LOD 级别在合并索引缓冲中的范围
+struct LodLevel
+{
+    GLuint  indexOffset; // 第一个索引的位置
+    GLuint  indexCount;  // 索引数量
+    GLfloat error;       // 相对原始网格的几何误差（模型空间）
+};
+
+// 带 LOD 链的网格：顶点只上传一份，所有级别的索引依次存放在同一个 EBO 中，各级只是索引范围不同
+class LodMesh
+{
+public:
+    std::vector<LodLevel> levels;
+    std::vector<Texture> textures;
+    glm::vec3 center;     // 包围球
+    GLfloat   radius;
+    GLuint    currentLevel;
+
+    // 必须在 OpenGL 上下文所在的线程中调用；总是生成 levelCount 级
+    LodMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, const std::vector<Texture>& textures, GLuint levelCount)
+    {
+        this->textures = textures;
+        this->currentLevel = 0;
+        this->computeBounds(vertices);
+
+        // 每一级目标为上一级的一半。无法继续有效简化时，剩下的级别沿用上一级的索引范围（不重复存放索引），
+        // 级别数始终为 levelCount，选择级别的逻辑不需要处理级别不足的网格
+        std::vector<GLuint> allIndices(indices);
+        LodLevel base = { 0, GLuint(indices.size()), 0.0f };
+        this->levels.push_back(base);
+
+        std::vector<GLuint> current(indices);
+        GLfloat error = 0.0f;
+        bool stalled = false;
+        while(this->levels.size() < levelCount)
+        {
+            GLfloat levelError = 0.0f;
+            std::vector<GLuint> simplified;
+            if(!stalled)
+                simplified = SimplifyMesh(vertices, current, current.size() / 2 / 3 * 3, levelError);
+            if(stalled || simplified.empty() || simplified.size() > current.size() * 9 / 10)
+            {
+                stalled = true;
+                this->levels.push_back(this->levels.back());
+                continue;
+            }
+            error = std::max(error, levelError);
+            LodLevel level = { GLuint(allIndices.size()), GLuint(simplified.size()), error };
+            this->levels.push_back(level);
+            allIndices.insert(allIndices.end(), simplified.begin(), simplified.end());
+            current.swap(simplified);
+        }
+
+        this->setupMesh(vertices, allIndices);
+    }
+
+    // 与 Mesh::Draw 相同的贴图绑定规则，只绘制指定级别
+    void Draw(Shader shader, GLuint level)
+    {
+        const LodLevel& lod = this->levels[level];
+        if(lod.indexCount == 0)
+            return;
+        GLuint diffuseNr = 1;
+        GLuint specularNr = 1;
+        for(GLuint i = 0; i < this->textures.size(); i++)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            std::string name = this->textures[i].type;
+            std::string number = (name == "texture_diffuse") ? std::to_string(diffuseNr++) : std::to_string(specularNr++);
+            glUniform1i(glGetUniformLocation(shader.Program, (name + number).c_str()), i);
+            glBindTexture(GL_TEXTURE_2D, this->textures[i].id);
+        }
+        glUniform1f(glGetUniformLocation(shader.Program, "material.shininess"), 16.0f);
+
+        glBindVertexArray(this->VAO);
+        glDrawElements(GL_TRIANGLES, lod.indexCount, GL_UNSIGNED_INT, (GLvoid*)(lod.indexOffset * sizeof(GLuint)));
+        glBindVertexArray(0);
+
+        for(GLuint i = 0; i < this->textures.size(); i++)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+    }
+
+private:
+    GLuint VAO, VBO, EBO;
+
+    void computeBounds(const std::vector<Vertex>& vertices)
+    {
+        glm::vec3 minPos(0.0f), maxPos(0.0f);
+        if(!vertices.empty())
+            minPos = maxPos = vertices[0].Position;
+        for(const Vertex& v : vertices)
+        {
+            minPos = glm::min(minPos, v.Position);
+            maxPos = glm::max(maxPos, v.Position);
+        }
+        this->center = (minPos + maxPos) * 0.5f;
+        this->radius = glm::length(maxPos - minPos) * 0.5f;
+    }
+
+    void setupMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+    {
+        if(vertices.empty() || indices.empty())
+        {
+            this->VAO = this->VBO = this->EBO = 0;
+            return;
+        }
+        glGenVertexArrays(1, &this->VAO);
+        glGenBuffers(1, &this->VBO);
+        glGenBuffers(1, &this->EBO);
+
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+
+        // 顶点位置
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
+        // 顶点法线
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, Normal));
+        // 顶点纹理坐标
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, TexCoords));
+
+        glBindVertexArray(0);
+    }
+};
+
+// 由载入的 CPU 端模型数据为每个网格生成 LOD 链（3-5 级）并上传，取代 MeshModel（不再另外上传一份 Mesh），
+// 绘制时按摄像机下的屏幕空间误差为每个网格选择级别。
+class LodModel
+{
+public:
+    std::vector<LodMesh> meshes;
+    std::vector<Texture> textures_loaded;
+    GLfloat PixelError; // 允许的屏幕空间误差（像素）
+    GLfloat Hysteresis; // 变粗时额外要求的余量，避免在阈值附近来回跳变
+
+    // 必须在 OpenGL 上下文所在的线程中调用；贴图与 MeshModel 一样并行解码后上传
+    LodModel(const ModelData& data, GLuint levelCount = 4, GLuint threadCount = 0)
+        : PixelError(1.0f), Hysteresis(0.25f)
+    {
+        levelCount = std::min(std::max(levelCount, 3u), 5u);
+        std::vector<std::vector<Texture> > materialTextures = LoadMaterialTextures(data.materials, data.directory, threadCount, this->textures_loaded);
+        for(const MeshData& mesh : data.meshes)
+        {
+            std::vector<Texture> textures;
+            if(mesh.material < materialTextures.size())
+                textures = materialTextures[mesh.material];
+            this->meshes.push_back(LodMesh(mesh.vertices, mesh.indices, textures, levelCount));
+        }
+    }
+
+    // model 为模型矩阵；camera.Zoom 为垂直视角（角度）
+    void Draw(Shader shader, const Camera& camera, const glm::mat4& model, GLfloat screenHeight)
+    {
+        // 模型矩阵中的最大缩放，用于把误差和包围球换算到世界空间
+        GLfloat scale = std::max(glm::length(glm::vec3(model[0])),
+                        std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+        // 距离为 1 时每单位长度对应的像素数
+        GLfloat pixelsPerUnit = screenHeight / (2.0f * std::tan(glm::radians(camera.Zoom) * 0.5f));
+
+        for(LodMesh& mesh : this->meshes)
+        {
+            glm::vec3 worldCenter = glm::vec3(model * glm::vec4(mesh.center, 1.0f));
+            GLfloat distance = glm::length(worldCenter - camera.Position) - mesh.radius * scale;
+            distance = std::max(distance, 0.1f);
+            mesh.currentLevel = this->selectLevel(mesh, scale * pixelsPerUnit / distance);
+            mesh.Draw(shader, mesh.currentLevel);
+        }
+    }
+
+private:
+    GLuint selectLevel(const LodMesh& mesh, GLfloat pixelsPerError)
+    {
+        GLuint level = std::min<GLuint>(mesh.currentLevel, GLuint(mesh.levels.size() - 1));
+        // 当前级别误差过大：变精细
+        while(level > 0 && mesh.levels[level].error * pixelsPerError > this->PixelError)
+            level--;
+        // 更粗一级的误差明显低于阈值：变粗
+        while(level + 1 < mesh.levels.size() &&
+              mesh.levels[level + 1].error * pixelsPerError < this->PixelError * (1.0f - this->Hysteresis))
+            level++;
+        return level;
+    }
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef OBJ_ASSET_LOADER_H
+#define OBJ_ASSET_LOADER_H
+
+#include <string>
+
+#include <GL/glew.h>
+
+#include <learnopengl/asset_pack.h>
+#include <learnopengl/obj_loader.h>
+
+// 载入 OBJ 文件（及其 MTL），先在已挂载的资源包中查找，找不到再读散文件。
+// 与 LoadObj 相同，只是文件通过 AssetFile 打开；资源包需要 zstd，所以单独放在这个头文件中。
+inline bool LoadPackedObj(const std::string& path, ModelData& model, GLuint threadCount = 0)
+{
+    return LoadObjFile<AssetFile>(path, model, threadCount);
+}
+
+#endif
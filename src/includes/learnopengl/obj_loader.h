@@ -0,0 +1,598 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/mapped_file.h>
+#include <learnopengl/mesh_data.h>
+#include <learnopengl/parallel.h>
+#include <learnopengl/trace.h>
+
+// == ======================================
+// OBJ/MTL 快速载入
+// 1. 内存映射文件，按行边界切成若干块，每块在一个线程中解析；
+// 2. 各块的顶点数组拼接后，把面中的 v/vt/vn 下标换算成全局下标；
+// 3. 每个网格的角点在多个线程中通过无锁哈希表去重，生成与 Model 相同的 Vertex/索引数据。
+// 输出与 Assimp（aiProcess_Triangulate | aiProcess_FlipUVs）一致：多边形按扇形三角化，V 坐标翻转，
+// 按 o/g 和 usemtl 切分网格。多线程去重时网格内顶点的顺序不固定，但索引结果等价。
+// == ======================================
+namespace obj_detail
+{
+    inline bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* SkipSpace(const char* p, const char* end)
+    {
+        while(p < end && IsSpace(*p))
+            p++;
+        return p;
+    }
+
+    inline bool IsDigit(char c)
+    {
+        return unsigned(c - '0') < 10u;
+    }
+
+    // 手写的浮点解析：最多累积 19 位有效数字，再乘以精确的 10 的幂。
+    // 比 strtof 快得多，且不受区域设置影响。
+    inline const char* ParseFloat(const char* p, const char* end, GLfloat& out)
+    {
+        static const GLdouble pow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        p = SkipSpace(p, end);
+        bool negative = false;
+        if(p < end && (*p == '-' || *p == '+'))
+            negative = (*p++ == '-');
+
+        unsigned long long mantissa = 0;
+        GLint exponent = 0, digits = 0;
+        for(; p < end && IsDigit(*p); p++)
+        {
+            if(digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += (mantissa != 0);
+            }
+            else
+                exponent++;
+        }
+        if(p < end && *p == '.')
+        {
+            for(p++; p < end && IsDigit(*p); p++)
+            {
+                if(digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    digits += (mantissa != 0);
+                    exponent--;
+                }
+            }
+        }
+        if(p < end && (*p == 'e' || *p == 'E'))
+        {
+            p++;
+            bool negativeExp = false;
+            if(p < end && (*p == '-' || *p == '+'))
+                negativeExp = (*p++ == '-');
+            GLint e = 0;
+            for(; p < end && IsDigit(*p); p++)
+                e = std::min(e * 10 + (*p - '0'), 10000);
+            exponent += negativeExp ? -e : e;
+        }
+
+        GLdouble value = GLdouble(mantissa);
+        if(exponent < 0)
+            value = (exponent >= -22) ? value / pow10[-exponent] : value * std::pow(10.0, exponent);
+        else if(exponent > 0)
+            value = (exponent <= 22) ? value * pow10[exponent] : value * std::pow(10.0, exponent);
+        out = GLfloat(negative ? -value : value);
+        return p;
+    }
+
+    inline const char* ParseInt(const char* p, const char* end, GLint& out)
+    {
+        bool negative = false;
+        if(p < end && (*p == '-' || *p == '+'))
+            negative = (*p++ == '-');
+        GLint value = 0;
+        for(; p < end && IsDigit(*p); p++)
+            value = value * 10 + (*p - '0');
+        out = negative ? -value : value;
+        return p;
+    }
+
+    // 行首关键字之后的名字（去掉首尾空白）
+    inline std::string ReadName(const char* p, const char* end)
+    {
+        p = SkipSpace(p, end);
+        while(end > p && IsSpace(end[-1]))
+            end--;
+        return std::string(p, end);
+    }
+
+    inline bool StartsWith(const char* p, const char* end, const char* word)
+    {
+        size_t length = std::strlen(word);
+        return size_t(end - p) > length && std::memcmp(p, word, length) == 0 && IsSpace(p[length]);
+    }
+
+    // 块中的 o/g/usemtl，corner 为它出现之前已有的角点数
+    struct ObjEvent
+    {
+        size_t corner;
+        bool material; // true 为 usemtl，false 为 o/g
+        std::string name;
+    };
+
+    // 一个按行对齐的文件块的解析结果
+    struct ObjChunk
+    {
+        const char* begin;
+        const char* end;
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> texcoords;
+        // 每个角点 3 个整数 (v, vt, vn)：正数为文件中的 1 起始全局下标，0 表示没有，
+        // 负数为 OBJ 的相对下标，存成 L - RELATIVE_BASE，L = 本行之前块内的元素数 + 相对下标；
+        // L 可以是负数（指向之前的块），要等各块的偏移确定后才能换算成全局下标
+        std::vector<GLint> corners;
+        std::vector<ObjEvent> events;
+        std::vector<std::string> mtllibs;
+        // 之前各块的元素数量，用于换算成全局下标
+        size_t positionOffset, texcoordOffset, normalOffset;
+        // 换算后的去重键
+        std::vector<unsigned long long> keys;
+    };
+
+    // 相对下标的存放基数：元素数不超过 KEY_LIMIT，L 的范围远小于它
+    const GLint RELATIVE_BASE = 1 << 30;
+
+    // OBJ 相对下标（负数）记下它相对本块开头的位置
+    inline GLint StoreIndex(GLint raw, size_t localCount)
+    {
+        if(raw >= 0)
+            return raw;
+        return GLint(localCount) + std::max(raw, -RELATIVE_BASE + 1) - RELATIVE_BASE;
+    }
+
+    // 换算成 0 起始的全局下标，offset 为之前各块的元素数；越界（指向文件开头之前）时为 -1
+    inline GLint ResolveIndex(GLint stored, size_t offset)
+    {
+        if(stored > 0)
+            return stored - 1;
+        if(stored < 0)
+            return std::max(GLint(offset) + stored + RELATIVE_BASE, -1);
+        return -1;
+    }
+
+    inline void ParseChunk(ObjChunk& chunk)
+    {
+        std::vector<GLint> face;
+        const char* p = chunk.begin;
+        while(p < chunk.end)
+        {
+            const char* lineEnd = (const char*)std::memchr(p, '\n', chunk.end - p);
+            if(!lineEnd)
+                lineEnd = chunk.end;
+            p = SkipSpace(p, lineEnd);
+
+            if(p + 1 < lineEnd && p[0] == 'v' && IsSpace(p[1]))
+            {
+                glm::vec3 position;
+                const char* q = ParseFloat(p + 1, lineEnd, position.x);
+                q = ParseFloat(q, lineEnd, position.y);
+                ParseFloat(q, lineEnd, position.z);
+                chunk.positions.push_back(position);
+            }
+            else if(p + 2 < lineEnd && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2]))
+            {
+                glm::vec3 normal;
+                const char* q = ParseFloat(p + 2, lineEnd, normal.x);
+                q = ParseFloat(q, lineEnd, normal.y);
+                ParseFloat(q, lineEnd, normal.z);
+                chunk.normals.push_back(normal);
+            }
+            else if(p + 2 < lineEnd && p[0] == 'v' && p[1] == 't' && IsSpace(p[2]))
+            {
+                glm::vec2 texcoord;
+                const char* q = ParseFloat(p + 2, lineEnd, texcoord.x);
+                ParseFloat(q, lineEnd, texcoord.y);
+                texcoord.y = 1.0f - texcoord.y; // 与 aiProcess_FlipUVs 一致
+                chunk.texcoords.push_back(texcoord);
+            }
+            else if(p + 1 < lineEnd && p[0] == 'f' && IsSpace(p[1]))
+            {
+                face.clear();
+                const char* q = SkipSpace(p + 1, lineEnd);
+                while(q < lineEnd)
+                {
+                    GLint v = 0, vt = 0, vn = 0;
+                    q = ParseInt(q, lineEnd, v);
+                    if(q < lineEnd && *q == '/')
+                    {
+                        q++;
+                        if(q < lineEnd && *q != '/')
+                            q = ParseInt(q, lineEnd, vt);
+                        if(q < lineEnd && *q == '/')
+                            q = ParseInt(q + 1, lineEnd, vn);
+                    }
+                    face.push_back(StoreIndex(v, chunk.positions.size()));
+                    face.push_back(StoreIndex(vt, chunk.texcoords.size()));
+                    face.push_back(StoreIndex(vn, chunk.normals.size()));
+                    // 跳到下一个角点
+                    while(q < lineEnd && !IsSpace(*q))
+                        q++;
+                    q = SkipSpace(q, lineEnd);
+                }
+                // 扇形三角化
+                for(size_t i = 1; i + 1 < face.size() / 3; i++)
+                {
+                    chunk.corners.insert(chunk.corners.end(), &face[0], &face[0] + 3);
+                    chunk.corners.insert(chunk.corners.end(), &face[i * 3], &face[i * 3] + 6);
+                }
+            }
+            else if(p + 1 < lineEnd && (p[0] == 'o' || p[0] == 'g') && IsSpace(p[1]))
+            {
+                ObjEvent event = { chunk.corners.size() / 3, false, ReadName(p + 1, lineEnd) };
+                chunk.events.push_back(event);
+            }
+            else if(StartsWith(p, lineEnd, "usemtl"))
+            {
+                ObjEvent event = { chunk.corners.size() / 3, true, ReadName(p + 6, lineEnd) };
+                chunk.events.push_back(event);
+            }
+            else if(StartsWith(p, lineEnd, "mtllib"))
+                chunk.mtllibs.push_back(ReadName(p + 6, lineEnd));
+
+            p = lineEnd + 1;
+        }
+    }
+
+    // 去重键：v、vt、vn 各 21 位（加 1 后存放，0 表示没有），最高位总是 0
+    const GLuint KEY_BITS = 21;
+    const GLuint KEY_LIMIT = (1u << KEY_BITS) - 1;
+    // 哈希表的空位标记，PackKey 产生不了这个值（没有任何下标的角点的键是 0）
+    const unsigned long long EMPTY_KEY = ~0ull;
+
+    // 文件中越界的下标按没有处理，每个字段不会超出 KEY_BITS 位
+    inline unsigned long long KeyField(GLint index)
+    {
+        return (index >= 0 && GLuint(index) < KEY_LIMIT) ? (unsigned long long)(index + 1) : 0ull;
+    }
+
+    inline unsigned long long PackKey(GLint v, GLint vt, GLint vn)
+    {
+        return (KeyField(v) << (2 * KEY_BITS)) | (KeyField(vt) << KEY_BITS) | KeyField(vn);
+    }
+
+    // 开放寻址的无锁哈希表：键用 CAS 占位，抢到空位的线程分配顶点下标
+    class VertexDedupTable
+    {
+    public:
+        VertexDedupTable(size_t expected) : counter(0)
+        {
+            this->capacity = 16;
+            while(this->capacity < expected * 2)
+                this->capacity <<= 1;
+            this->keys.reset(new std::atomic<unsigned long long>[this->capacity]);
+            this->values.reset(new std::atomic<GLuint>[this->capacity]);
+            for(size_t i = 0; i < this->capacity; i++)
+            {
+                this->keys[i].store(EMPTY_KEY, std::memory_order_relaxed);
+                this->values[i].store(EMPTY, std::memory_order_relaxed);
+            }
+        }
+
+        // 返回键对应的顶点下标；inserted 表示是否由本次调用新建
+        GLuint Insert(unsigned long long key, bool& inserted)
+        {
+            unsigned long long hash = key * 0x9E3779B97F4A7C15ull;
+            size_t mask = this->capacity - 1;
+            size_t slot = size_t(hash >> 32) & mask;
+            for(;;)
+            {
+                unsigned long long current = this->keys[slot].load(std::memory_order_acquire);
+                if(current == EMPTY_KEY)
+                {
+                    unsigned long long expected = EMPTY_KEY;
+                    if(this->keys[slot].compare_exchange_strong(expected, key, std::memory_order_acq_rel))
+                    {
+                        GLuint index = this->counter.fetch_add(1, std::memory_order_relaxed);
+                        this->values[slot].store(index, std::memory_order_release);
+                        inserted = true;
+                        return index;
+                    }
+                    current = expected;
+                }
+                if(current == key)
+                {
+                    // 其他线程刚占到这个位置，等它写入下标
+                    GLuint index;
+                    while((index = this->values[slot].load(std::memory_order_acquire)) == EMPTY)
+                        std::this_thread::yield();
+                    inserted = false;
+                    return index;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        GLuint Count() const
+        {
+            return this->counter.load();
+        }
+
+    private:
+        static const GLuint EMPTY = ~0u;
+        size_t capacity;
+        std::unique_ptr<std::atomic<unsigned long long>[]> keys;
+        std::unique_ptr<std::atomic<GLuint>[]> values;
+        std::atomic<GLuint> counter;
+    };
+
+    // 解析 MTL 数据，只关心漫反射和镜面贴图（与 Model::loadMaterialTextures 相同）
+    inline void ParseMtl(const char* data, size_t size, std::vector<MaterialData>& materials)
+    {
+        const char* p = data;
+        const char* end = p + size;
+        while(p < end)
+        {
+            const char* lineEnd = (const char*)std::memchr(p, '\n', end - p);
+            if(!lineEnd)
+                lineEnd = end;
+            p = SkipSpace(p, lineEnd);
+            if(StartsWith(p, lineEnd, "newmtl"))
+            {
+                MaterialData material;
+                material.name = ReadName(p + 6, lineEnd);
+                materials.push_back(material);
+            }
+            else if(!materials.empty() && (StartsWith(p, lineEnd, "map_Kd") || StartsWith(p, lineEnd, "map_Ks")))
+            {
+                // 贴图选项（-bm 等）忽略，取最后一个字段作为文件名
+                std::string value = ReadName(p + 6, lineEnd);
+                size_t space = value.find_last_of(" \t");
+                if(space != std::string::npos)
+                    value = value.substr(space + 1);
+                if(p[5] == 'd')
+                    materials.back().diffuseMaps.push_back(value);
+                else
+                    materials.back().specularMaps.push_back(value);
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+    template<typename File>
+    inline void ParseMtlFile(const std::string& path, std::vector<MaterialData>& materials)
+    {
+        File file;
+        if(!file.Open(path))
+        {
+            std::cout << "ERROR::OBJ:: cannot open material library " << path << std::endl;
+            return;
+        }
+        ParseMtl(file.Data(), file.Size(), materials);
+    }
+}
+
+// 从内存中的 OBJ 数据 [data, data + size) 载入模型，path 为它的文件路径（用于确定目录和报错）。
+// mtllib 引用的材质库用 File 打开，File 需要提供 Open/Data/Size（如 MappedFile）。
+template<typename File>
+inline bool LoadObjData(const char* data, size_t size, const std::string& path, ModelData& model, GLuint threadCount = 0)
+{
+    using namespace obj_detail;
+    TRACE_SCOPE("LoadObj");
+
+    threadCount = WorkerCount(threadCount);
+
+    model.directory = path.substr(0, path.find_last_of('/'));
+    model.meshes.clear();
+    model.materials.clear();
+
+    // 1. 按行边界切块（每块至少 256KB，避免小文件开太多线程）
+    const char* dataEnd = data + size;
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threadCount, size / (256 * 1024)));
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* cursor = data;
+    for(size_t i = 0; i < chunkCount; i++)
+    {
+        const char* chunkEnd = (i + 1 == chunkCount) ? dataEnd : data + size * (i + 1) / chunkCount;
+        if(chunkEnd < cursor)
+            chunkEnd = cursor;
+        const char* newline = (const char*)std::memchr(chunkEnd, '\n', dataEnd - chunkEnd);
+        chunkEnd = (i + 1 == chunkCount || !newline) ? dataEnd : newline + 1;
+        chunks[i].begin = cursor;
+        chunks[i].end = chunkEnd;
+        cursor = chunkEnd;
+    }
+
+    // 2. 并行解析各块
+    ParallelRanges(chunkCount, threadCount, [&](size_t begin, size_t end, GLuint)
+    {
+        for(size_t i = begin; i < end; i++)
+            ParseChunk(chunks[i]);
+    });
+
+    // 3. 拼接顶点数组，记录各块的偏移
+    std::vector<glm::vec3> positions, normals;
+    std::vector<glm::vec2> texcoords;
+    for(ObjChunk& chunk : chunks)
+    {
+        chunk.positionOffset = positions.size();
+        chunk.texcoordOffset = texcoords.size();
+        chunk.normalOffset = normals.size();
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+    }
+    if(positions.size() >= KEY_LIMIT || texcoords.size() >= KEY_LIMIT || normals.size() >= KEY_LIMIT)
+    {
+        std::cout << "ERROR::OBJ:: " << path << " has too many vertices for the fast loader" << std::endl;
+        return false;
+    }
+
+    // 4. 并行把角点换算成全局下标的去重键
+    ParallelRanges(chunkCount, threadCount, [&](size_t begin, size_t end, GLuint)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            ObjChunk& chunk = chunks[i];
+            chunk.keys.resize(chunk.corners.size() / 3);
+            for(size_t c = 0; c < chunk.keys.size(); c++)
+            {
+                const GLint* corner = &chunk.corners[c * 3];
+                chunk.keys[c] = PackKey(ResolveIndex(corner[0], chunk.positionOffset),
+                                        ResolveIndex(corner[1], chunk.texcoordOffset),
+                                        ResolveIndex(corner[2], chunk.normalOffset));
+            }
+        }
+    });
+
+    // 5. 材质
+    std::map<std::string, GLuint> materialIndex;
+    for(const ObjChunk& chunk : chunks)
+        for(const std::string& library : chunk.mtllibs)
+            ParseMtlFile<File>(model.directory + '/' + library, model.materials);
+    for(GLuint i = 0; i < model.materials.size(); i++)
+        materialIndex[model.materials[i].name] = i;
+
+    // 6. 按 o/g/usemtl 切分网格：每个网格收集自己的去重键
+    std::vector<std::vector<unsigned long long> > meshKeys;
+    std::vector<GLuint> meshMaterials;
+    GLint currentMaterial = -1;
+    bool newMesh = true;
+    for(const ObjChunk& chunk : chunks)
+    {
+        size_t corner = 0;
+        for(size_t e = 0; e <= chunk.events.size(); e++)
+        {
+            size_t until = (e < chunk.events.size()) ? chunk.events[e].corner : chunk.keys.size();
+            if(until > corner)
+            {
+                if(newMesh)
+                {
+                    if(currentMaterial < 0)
+                    {
+                        // 没有 usemtl 的面使用一个空材质
+                        auto found = materialIndex.find("");
+                        if(found == materialIndex.end())
+                        {
+                            materialIndex[""] = GLuint(model.materials.size());
+                            model.materials.push_back(MaterialData());
+                        }
+                        currentMaterial = GLint(materialIndex[""]);
+                    }
+                    meshKeys.push_back(std::vector<unsigned long long>());
+                    meshMaterials.push_back(GLuint(currentMaterial));
+                    newMesh = false;
+                }
+                meshKeys.back().insert(meshKeys.back().end(), chunk.keys.begin() + corner, chunk.keys.begin() + until);
+                corner = until;
+            }
+            if(e == chunk.events.size())
+                break;
+
+            const ObjEvent& event = chunk.events[e];
+            if(event.material)
+            {
+                auto found = materialIndex.find(event.name);
+                if(found == materialIndex.end())
+                {
+                    MaterialData material;
+                    material.name = event.name;
+                    found = materialIndex.insert(std::make_pair(event.name, GLuint(model.materials.size()))).first;
+                    model.materials.push_back(material);
+                }
+                if(GLint(found->second) != currentMaterial)
+                    newMesh = true;
+                currentMaterial = GLint(found->second);
+            }
+            else
+                newMesh = true;
+        }
+    }
+
+    // 7. 每个网格并行去重，生成顶点和索引
+    model.meshes.resize(meshKeys.size());
+    for(size_t m = 0; m < meshKeys.size(); m++)
+    {
+        const std::vector<unsigned long long>& keys = meshKeys[m];
+        MeshData& mesh = model.meshes[m];
+        mesh.material = meshMaterials[m];
+        mesh.indices.resize(keys.size());
+
+        // 小网格单线程处理，避免线程开销
+        GLuint meshThreads = keys.size() < 65536 ? 1u : threadCount;
+        VertexDedupTable table(keys.size());
+        std::vector<std::vector<std::pair<GLuint, unsigned long long> > > created(meshThreads);
+        ParallelRanges(keys.size(), meshThreads, [&](size_t begin, size_t end, GLuint thread)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                bool inserted;
+                GLuint index = table.Insert(keys[i], inserted);
+                mesh.indices[i] = index;
+                if(inserted)
+                    created[thread].push_back(std::make_pair(index, keys[i]));
+            }
+        });
+
+        mesh.vertices.resize(table.Count());
+        ParallelRanges(created.size(), meshThreads, [&](size_t begin, size_t end, GLuint)
+        {
+            for(size_t t = begin; t < end; t++)
+                for(const std::pair<GLuint, unsigned long long>& entry : created[t])
+                {
+                    GLint v  = GLint((entry.second >> (2 * KEY_BITS)) & KEY_LIMIT) - 1;
+                    GLint vt = GLint((entry.second >> KEY_BITS) & KEY_LIMIT) - 1;
+                    GLint vn = GLint(entry.second & KEY_LIMIT) - 1;
+                    Vertex& vertex = mesh.vertices[entry.first];
+                    vertex.Position  = (v >= 0 && size_t(v) < positions.size()) ? positions[v] : glm::vec3(0.0f);
+                    vertex.Normal    = (vn >= 0 && size_t(vn) < normals.size()) ? normals[vn] : glm::vec3(0.0f);
+                    vertex.TexCoords = (vt >= 0 && size_t(vt) < texcoords.size()) ? texcoords[vt] : glm::vec2(0.0f, 0.0f);
+                }
+        });
+    }
+    return true;
+}
+
+// 用 File 打开 OBJ 文件后载入
+template<typename File>
+inline bool LoadObjFile(const std::string& path, ModelData& model, GLuint threadCount = 0)
+{
+    File file;
+    if(!file.Open(path))
+    {
+        std::cout << "ERROR::OBJ:: cannot open " << path << std::endl;
+        return false;
+    }
+    return LoadObjData<File>(file.Data(), file.Size(), path, model, threadCount);
+}
+
+// 载入 OBJ 文件（及其 MTL），threadCount 为 0 时使用全部硬件线程。
+// 只生成 CPU 数据，可以在任意线程调用；用 MeshModel 在 GL 线程中创建可绘制的模型。
+// 只读散文件；要从资源包中读取，使用 obj_asset_loader.h 的 LoadPackedObj。
+inline bool LoadObj(const std::string& path, ModelData& model, GLuint threadCount = 0)
+{
+    return LoadObjFile<MappedFile>(path, model, threadCount);
+}
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/trace.h>
+#include <learnopengl/simd.h>
+
+// == ======================================
+// 软件光栅化的 Hi-Z 遮挡剔除
+// 被其他物体挡住的箱子和模型原本照样提交、照样着色。这里在 CPU 上：
+// 1. 把离摄像机最近的若干遮挡体（实心的盒子）光栅化到一张低分辨率的深度缓冲，
+//    内层循环用 simd.h 的 Float4 每次对 4 个像素做边函数和深度运算，用掩码选择代替分支；
+// 2. 逐级取 2x2 中的最大深度，生成 Hi-Z 金字塔；
+// 3. 被测物体的包围盒投影到屏幕，选一个使矩形只覆盖 2x2 个纹素的级别，
+//    包围盒最近的深度比这些纹素的最大深度还远时判定为被遮挡。
+// Submit/Wait 在后台线程中执行整个过程，可以提前一帧提交下一帧的摄像机，渲染时只取结果。
+// 深度为 [0, 1]（NDC z 映射），清除为 1（远平面）。
+// == ======================================
+
+// 一个盒子：局部空间的包围盒和模型矩阵（可以有旋转，按 8 个角点投影，比世界空间 AABB 更紧）
+struct OcclusionBox
+{
+    glm::mat4 model;
+    glm::vec3 min, max;
+};
+
+class OcclusionCuller
+{
+public:
+    OcclusionCuller(GLint width = 256, GLint height = 128, GLuint maxOccluders = 64)
+        : width(width), height(height), maxOccluders(maxOccluders), pending(false), busy(false), quit(false)
+    {
+        // Hi-Z 各级的尺寸（向上取整，保证第 l 级的纹素 i 覆盖第 0 级的 [i << l, (i + 1) << l)）
+        GLint w = width, h = height;
+        this->levels.push_back(std::vector<GLfloat>(size_t(w) * h, 1.0f));
+        this->levelSizes.push_back(glm::ivec2(w, h));
+        while(w > 1 || h > 1)
+        {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+            this->levels.push_back(std::vector<GLfloat>(size_t(w) * h, 1.0f));
+            this->levelSizes.push_back(glm::ivec2(w, h));
+        }
+    }
+
+    ~OcclusionCuller()
+    {
+        if(this->worker.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->quit = true;
+            }
+            this->wake.notify_all();
+            this->worker.join();
+        }
+    }
+
+    // ---- 同步接口（后台任务进行中不能调用） ----
+
+    void Clear()
+    {
+        std::fill(this->levels[0].begin(), this->levels[0].end(), 1.0f);
+    }
+
+    // 光栅化一组三角形（mvp 为模型-观察-投影矩阵）
+    void RasterizeTriangles(const glm::mat4& mvp, const glm::vec3* positions, const GLuint* indices, size_t indexCount)
+    {
+        for(size_t i = 0; i + 2 < indexCount; i += 3)
+            this->rasterizeTriangle(mvp * glm::vec4(positions[indices[i]], 1.0f),
+                                    mvp * glm::vec4(positions[indices[i + 1]], 1.0f),
+                                    mvp * glm::vec4(positions[indices[i + 2]], 1.0f));
+    }
+
+    void RasterizeBox(const glm::mat4& viewProjection, const OcclusionBox& box)
+    {
+        static const GLuint boxIndices[36] = {
+            0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,  0, 4, 5, 0, 5, 1,
+            2, 3, 7, 2, 7, 6,  0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3
+        };
+        glm::vec3 corners[8];
+        BoxCorners(box, corners);
+        this->RasterizeTriangles(viewProjection * box.model, corners, boxIndices, 36);
+    }
+
+    // 由第 0 级逐级生成 Hi-Z（每个纹素取下一级 2x2 的最大深度）
+    void BuildHiZ()
+    {
+        for(size_t l = 1; l < this->levels.size(); l++)
+        {
+            const std::vector<GLfloat>& src = this->levels[l - 1];
+            std::vector<GLfloat>& dst = this->levels[l];
+            glm::ivec2 srcSize = this->levelSizes[l - 1], dstSize = this->levelSizes[l];
+            for(GLint y = 0; y < dstSize.y; y++)
+            {
+                const GLfloat* row0 = &src[size_t(std::min(2 * y, srcSize.y - 1)) * srcSize.x];
+                const GLfloat* row1 = &src[size_t(std::min(2 * y + 1, srcSize.y - 1)) * srcSize.x];
+                GLfloat* out = &dst[size_t(y) * dstSize.x];
+                for(GLint x = 0; x < dstSize.x; x++)
+                {
+                    GLint x0 = std::min(2 * x, srcSize.x - 1), x1 = std::min(2 * x + 1, srcSize.x - 1);
+                    out[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+                }
+            }
+        }
+    }
+
+    // 包围盒是否可能可见（在视锥外或被遮挡时返回 false）
+    bool IsVisible(const glm::mat4& viewProjection, const OcclusionBox& box) const
+    {
+        glm::vec3 corners[8];
+        BoxCorners(box, corners);
+        glm::mat4 mvp = viewProjection * box.model;
+        GLfloat minX = 1e30f, minY = 1e30f, minZ = 1e30f, maxX = -1e30f, maxY = -1e30f;
+        GLint behind = 0;
+        for(const glm::vec3& corner : corners)
+        {
+            glm::vec4 clip = mvp * glm::vec4(corner, 1.0f);
+            if(clip.w <= 1e-5f)
+            {
+                behind++;
+                continue;
+            }
+            GLfloat x = clip.x / clip.w, y = clip.y / clip.w, z = clip.z / clip.w;
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+            minZ = std::min(minZ, z);
+        }
+        if(behind == 8)
+            return false; // 整个在摄像机后面
+        if(behind > 0)
+            return true;  // 跨过摄像机平面，保守地认为可见
+        if(maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f)
+            return false; // 在视锥外
+        GLfloat nearest = minZ * 0.5f + 0.5f;
+        if(nearest <= 0.0f)
+            return true;
+
+        // 覆盖的像素矩形
+        GLint x0 = this->toPixel(minX, this->width), x1 = this->toPixel(maxX, this->width);
+        GLint y0 = this->toPixel(minY, this->height), y1 = this->toPixel(maxY, this->height);
+        size_t level = 0;
+        while(level + 1 < this->levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+            level++;
+        const std::vector<GLfloat>& depth = this->levels[level];
+        glm::ivec2 size = this->levelSizes[level];
+        GLfloat farthest = 0.0f;
+        for(GLint y = y0 >> level; y <= std::min(y1 >> GLint(level), size.y - 1); y++)
+            for(GLint x = x0 >> level; x <= std::min(x1 >> GLint(level), size.x - 1); x++)
+                farthest = std::max(farthest, depth[size_t(y) * size.x + x]);
+        return nearest <= farthest;
+    }
+
+    // ---- 后台接口 ----
+
+    // 设置遮挡体和被测物体（静态场景只需设置一次；后台任务进行中不能调用）
+    void SetScene(const std::vector<OcclusionBox>& occluders, const std::vector<OcclusionBox>& occludees)
+    {
+        this->occluders = occluders;
+        this->occludees = occludees;
+        this->visibility.assign(occludees.size(), 1);
+    }
+
+    // 提交一帧：在后台线程中选出离 eye 最近的遮挡体、光栅化、生成 Hi-Z 并测试所有被测物体
+    void Submit(const glm::mat4& viewProjection, const glm::vec3& eye)
+    {
+        if(!this->worker.joinable())
+            this->worker = std::thread(&OcclusionCuller::workerLoop, this);
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done.wait(lock, [this] { return !this->busy && !this->pending; });
+        this->jobViewProjection = viewProjection;
+        this->jobEye = eye;
+        this->pending = true;
+        lock.unlock();
+        this->wake.notify_one();
+    }
+
+    // 等待最近一次提交完成，返回每个被测物体是否可见（1 可见）；下一次 Submit 后会被改写，需要保留时先复制
+    const std::vector<unsigned char>& Wait()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done.wait(lock, [this] { return !this->busy && !this->pending; });
+        return this->visibility;
+    }
+
+private:
+    GLint width, height;
+    GLuint maxOccluders;
+    std::vector<std::vector<GLfloat> > levels; // 第 0 级为深度缓冲
+    std::vector<glm::ivec2> levelSizes;
+
+    std::vector<OcclusionBox> occluders, occludees;
+    std::vector<unsigned char> visibility;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    glm::mat4 jobViewProjection;
+    glm::vec3 jobEye;
+    bool pending, busy, quit;
+
+    OcclusionCuller(const OcclusionCuller&);
+    OcclusionCuller& operator=(const OcclusionCuller&);
+
+    static void BoxCorners(const OcclusionBox& box, glm::vec3* corners)
+    {
+        for(GLint i = 0; i < 8; i++)
+            corners[i] = glm::vec3((i & 4) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 1) ? box.max.z : box.min.z);
+    }
+
+    GLint toPixel(GLfloat ndc, GLint size) const
+    {
+        return std::min(std::max(GLint(std::floor((ndc * 0.5f + 0.5f) * size)), 0), size - 1);
+    }
+
+    void rasterizeTriangle(glm::vec4 c0, glm::vec4 c1, glm::vec4 c2)
+    {
+        // 只画完全在近平面之后的三角形；被近平面裁掉的遮挡体在画面上会露出后面的物体，直接跳过（保守）
+        if(c0.w <= 0.0f || c1.w <= 0.0f || c2.w <= 0.0f || c0.z < -c0.w || c1.z < -c1.w || c2.z < -c2.w)
+            return;
+        glm::vec3 v[3];
+        const glm::vec4* clip[3] = { &c0, &c1, &c2 };
+        for(GLint i = 0; i < 3; i++)
+            v[i] = glm::vec3((clip[i]->x / clip[i]->w * 0.5f + 0.5f) * this->width,
+                             (clip[i]->y / clip[i]->w * 0.5f + 0.5f) * this->height,
+                             std::min(clip[i]->z / clip[i]->w * 0.5f + 0.5f, 1.0f));
+        GLfloat area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+        if(std::fabs(area) < 1e-8f)
+            return;
+        if(area < 0.0f) // 不做背面剔除，统一成逆时针
+        {
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+
+        GLint minX = std::max(GLint(std::floor(std::min(std::min(v[0].x, v[1].x), v[2].x))), 0);
+        GLint maxX = std::min(GLint(std::ceil(std::max(std::max(v[0].x, v[1].x), v[2].x))), this->width - 1);
+        GLint minY = std::max(GLint(std::floor(std::min(std::min(v[0].y, v[1].y), v[2].y))), 0);
+        GLint maxY = std::min(GLint(std::ceil(std::max(std::max(v[0].y, v[1].y), v[2].y))), this->height - 1);
+        if(minX > maxX || minY > maxY)
+            return;
+
+        // 边函数 e_i(p) = A_i * px + B_i * py + C_i，内部三个都 >= 0；深度在屏幕空间线性插值
+        GLfloat A[3], B[3], C[3];
+        for(GLint i = 0; i < 3; i++)
+        {
+            const glm::vec3& a = v[i];
+            const glm::vec3& b = v[(i + 1) % 3];
+            A[i] = -(b.y - a.y);
+            B[i] = b.x - a.x;
+            C[i] = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+        }
+        // e_0 对应 v2 的权重，e_1 对应 v0，e_2 对应 v1
+        GLfloat invArea = 1.0f / area;
+        GLfloat zA = (A[1] * v[0].z + A[2] * v[1].z + A[0] * v[2].z) * invArea;
+        GLfloat zB = (B[1] * v[0].z + B[2] * v[1].z + B[0] * v[2].z) * invArea;
+        GLfloat zC = (C[1] * v[0].z + C[2] * v[1].z + C[0] * v[2].z) * invArea;
+
+        Float4 a0 = Float4Set(A[0]), a1 = Float4Set(A[1]), a2 = Float4Set(A[2]), za = Float4Set(zA), zero = Float4Set(0.0f);
+        for(GLint y = minY; y <= maxY; y++)
+        {
+            GLfloat py = y + 0.5f;
+            Float4 row0 = Float4Set(B[0] * py + C[0]), row1 = Float4Set(B[1] * py + C[1]), row2 = Float4Set(B[2] * py + C[2]);
+            Float4 rowZ = Float4Set(zB * py + zC);
+            GLfloat* depth = &this->levels[0][size_t(y) * this->width];
+            for(GLint x = minX; x <= maxX; x += 4)
+            {
+                size_t n = size_t(maxX - x + 1);
+                Float4 px = Float4Ramp(x + 0.5f);
+                Float4 e0 = a0 * px + row0, e1 = a1 * px + row1, e2 = a2 * px + row2;
+                Float4 z = za * px + rowZ;
+                Float4 old = Float4LoadN(depth + x, n);
+                Float4 inside = Float4And(Float4And(Float4GreaterEqual(e0, zero), Float4GreaterEqual(e1, zero)),
+                                          Float4And(Float4GreaterEqual(e2, zero), Float4Less(z, old)));
+                Float4StoreN(depth + x, Float4Select(inside, z, old), n);
+            }
+        }
+    }
+
+    void run(const glm::mat4& viewProjection, const glm::vec3& eye)
+    {
+        TRACE_SCOPE("OcclusionCull");
+        // 1. 离摄像机最近的遮挡体
+        std::vector<std::pair<GLfloat, GLuint> > order(this->occluders.size());
+        for(GLuint i = 0; i < this->occluders.size(); i++)
+        {
+            const OcclusionBox& box = this->occluders[i];
+            glm::vec3 center(box.model * glm::vec4((box.min + box.max) * 0.5f, 1.0f));
+            glm::vec3 offset = center - eye;
+            order[i] = std::make_pair(glm::dot(offset, offset), i);
+        }
+        size_t count = std::min<size_t>(this->maxOccluders, order.size());
+        std::partial_sort(order.begin(), order.begin() + count, order.end());
+
+        // 2. 光栅化并生成 Hi-Z
+        this->Clear();
+        for(size_t i = 0; i < count; i++)
+            this->RasterizeBox(viewProjection, this->occluders[order[i].second]);
+        this->BuildHiZ();
+
+        // 3. 测试
+        for(size_t i = 0; i < this->occludees.size(); i++)
+            this->visibility[i] = this->IsVisible(viewProjection, this->occludees[i]) ? 1 : 0;
+    }
+
+    void workerLoop()
+    {
+        TraceThreadName("occlusion");
+        std::unique_lock<std::mutex> lock(this->mutex);
+        for(;;)
+        {
+            this->wake.wait(lock, [this] { return this->pending || this->quit; });
+            if(this->quit)
+                return;
+            this->pending = false;
+            this->busy = true;
+            glm::mat4 viewProjection = this->jobViewProjection;
+            glm::vec3 eye = this->jobEye;
+            lock.unlock();
+            this->run(viewProjection, eye);
+            lock.lock();
+            this->busy = false;
+            this->done.notify_all();
+        }
+    }
+};
+
+#endif
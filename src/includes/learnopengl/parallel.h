@@ -0,0 +1,65 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include <GL/glew.h>
+
+// 线程数：0 表示使用全部硬件线程
+inline GLuint WorkerCount(GLuint threadCount)
+{
+    if(threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    return std::max(1u, threadCount);
+}
+
+// 把 [0, count) 平均分给若干线程执行 func(begin, end, threadIndex)
+// 适合每个元素耗时相近的循环。
+template<typename Func>
+void ParallelRanges(size_t count, GLuint threadCount, Func func)
+{
+    threadCount = GLuint(std::max<size_t>(1, std::min<size_t>(threadCount, count)));
+    if(threadCount <= 1)
+    {
+        func(size_t(0), count, 0u);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for(GLuint t = 0; t < threadCount; t++)
+    {
+        size_t begin = count * t / threadCount, end = count * (t + 1) / threadCount;
+        threads.push_back(std::thread(func, begin, end, t));
+    }
+    for(std::thread& thread : threads)
+        thread.join();
+}
+
+// 执行 count 个任务 func(index)，空闲线程从共享计数器领取下一个任务
+// 适合耗时差别很大的任务（例如大小不一的网格、贴图）。
+template<typename Func>
+void ParallelTasks(size_t count, GLuint threadCount, Func func)
+{
+    threadCount = GLuint(std::max<size_t>(1, std::min<size_t>(threadCount, count)));
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for(size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+            func(i);
+    };
+    if(threadCount <= 1)
+    {
+        worker();
+        return;
+    }
+    std::vector<std::thread> threads;
+    for(GLuint t = 1; t < threadCount; t++)
+        threads.push_back(std::thread(worker));
+    worker(); // 调用线程也参与
+    for(std::thread& thread : threads)
+        thread.join();
+}
+
+#endif
@@ -0,0 +1,707 @@
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <learnopengl/asset_pack.h>
+#include <learnopengl/light_assignment.h>
+
+// == ======================================
+// 场景文件
+// 场景内容（箱子位置、灯光、材质、模型变换）原本写在案例的数组常量里。场景文件有两种形式：
+// 1. 可手工编辑的 JSON（*.scene.json）：
+//    { "models":    [ { "name": "cube" }, { "name": "nanosuit", "path": "resources/objects/nanosuit/nanosuit.obj" } ],
+//      "materials": [ { "name": "container", "diffuse": "...", "specular": "...", "shininess": 32 } ],
+//      "objects":   [ { "model": "cube", "material": "container", "position": [0, 0, 0],
+//                       "rotation": { "axis": [1, 0.3, 0.5], "angle": 20 }, "scale": [1, 1, 1], "radius": 0.87 } ],
+//      "dirLight":  { "direction": [...], "ambient": [...], "diffuse": [...], "specular": [...] },
+//      "pointLights": [ { "position", "ambient", "diffuse", "specular", "constant", "linear", "quadratic" } ],
+//      "spotLights":  [ { ...同上, "direction", "cutOff", "outerCutOff"（角度） } ] }
+// 2. 烘焙后的二进制（*.scene.scn）：文件头 + 按 16 字节对齐的定长数组 + 字符串表。
+//    模型矩阵、点光源范围、聚光灯切角余弦都在烘焙时算好，载入时只映射一次文件，
+//    SceneFile 直接返回指向映射的数组，不做逐字段的解析和分配。
+// OpenScene 优先读二进制，JSON 的内容哈希与二进制中记录的不同时（JSON 被编辑过）重新烘焙。
+// 格式按小端序存储，和编译器的结构体布局一致（见 static_assert）。
+// == ======================================
+
+const char SCENE_FILE_MAGIC[4] = { 'L', 'S', 'C', 'N' };
+const GLuint SCENE_FILE_VERSION = 1;
+const GLuint SCENE_NO_INDEX = 0xFFFFFFFFu; // 没有材质、没有字符串
+
+struct SceneFileHeader
+{
+    char magic[4];
+    GLuint version;
+    GLuint64 sourceHash; // 烘焙时 JSON 内容的哈希
+    GLuint modelCount, materialCount, objectCount, pointLightCount, spotLightCount, hasDirLight;
+    GLuint modelOffset, materialOffset, objectOffset, pointLightOffset, spotLightOffset, dirLightOffset;
+    GLuint stringOffset, stringSize;
+};
+
+// 字符串字段都是字符串表中的偏移
+struct SceneModel
+{
+    GLuint name;
+    GLuint path; // 内置网格（如 "cube"）为 SCENE_NO_INDEX
+};
+
+struct SceneMaterial
+{
+    GLuint name;
+    GLuint diffuse, specular; // 贴图路径
+    GLfloat shininess;
+};
+
+struct SceneObject
+{
+    glm::mat4 transform;
+    glm::vec3 center; // 世界空间包围球（用于分配灯光、剔除）
+    GLfloat radius;
+    GLuint model;     // models[] 下标
+    GLuint material;  // materials[] 下标，SCENE_NO_INDEX 表示使用模型自带的材质
+    GLuint reserved[2];
+};
+
+struct SceneDirLight
+{
+    glm::vec3 direction;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+};
+
+static_assert(sizeof(SceneFileHeader) == 72, "SceneFileHeader layout");
+static_assert(sizeof(SceneObject) == 96, "SceneObject layout");
+static_assert(sizeof(PointLight) == 64 && sizeof(SpotLight) == 80, "light layout");
+
+// == ======================================
+// JSON（只用于可编辑的场景源文件，解析时分配没有关系）
+// == ======================================
+struct JsonValue
+{
+    enum Type { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT };
+
+    Type type;
+    GLdouble number;
+    std::string text;
+    std::vector<JsonValue> items;                            // 数组元素
+    std::vector<std::pair<std::string, JsonValue> > members; // 对象成员（保持顺序）
+
+    JsonValue() : type(JSON_NULL), number(0.0) { }
+
+    // 对象成员，不存在时返回 null
+    const JsonValue& operator[](const char* key) const
+    {
+        static const JsonValue none;
+        for(const std::pair<std::string, JsonValue>& member : this->members)
+            if(member.first == key)
+                return member.second;
+        return none;
+    }
+
+    GLfloat Number(GLfloat fallback) const
+    {
+        return this->type == JSON_NUMBER ? GLfloat(this->number) : fallback;
+    }
+
+    std::string String(const std::string& fallback = std::string()) const
+    {
+        return this->type == JSON_STRING ? this->text : fallback;
+    }
+
+    glm::vec3 Vec3(const glm::vec3& fallback) const
+    {
+        if(this->type != JSON_ARRAY || this->items.size() != 3)
+            return fallback;
+        return glm::vec3(this->items[0].Number(fallback.x), this->items[1].Number(fallback.y), this->items[2].Number(fallback.z));
+    }
+};
+
+class JsonParser
+{
+public:
+    JsonParser(const char* text, size_t size) : text(text), end(text + size), line(1) { }
+
+    bool Parse(JsonValue& value)
+    {
+        if(!this->value(value))
+            return false;
+        this->skipSpace();
+        return this->text == this->end || this->fail("trailing characters");
+    }
+
+    const std::string& Error() const { return this->error; }
+
+private:
+    const char* text;
+    const char* end;
+    GLuint line;
+    std::string error;
+
+    bool fail(const char* message)
+    {
+        this->error = std::string(message) + " at line " + std::to_string(this->line);
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while(this->text < this->end && (*this->text == ' ' || *this->text == '\t' || *this->text == '\r' || *this->text == '\n'))
+        {
+            if(*this->text == '\n')
+                this->line++;
+            this->text++;
+        }
+    }
+
+    bool literal(const char* word)
+    {
+        size_t length = std::strlen(word);
+        if(size_t(this->end - this->text) < length || std::strncmp(this->text, word, length) != 0)
+            return this->fail("unexpected token");
+        this->text += length;
+        return true;
+    }
+
+    bool string(std::string& out)
+    {
+        this->text++; // "
+        while(this->text < this->end && *this->text != '"')
+        {
+            char c = *this->text++;
+            if(c == '\n')
+                return this->fail("newline in string");
+            if(c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if(this->text == this->end)
+                break;
+            c = *this->text++;
+            switch(c)
+            {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+            {
+                // 只保留 ASCII，其余替换为 '?'（场景文件里的路径和名字不需要）
+                if(this->end - this->text < 4)
+                    return this->fail("bad escape");
+                GLuint code = GLuint(std::strtoul(std::string(this->text, 4).c_str(), NULL, 16));
+                out += code < 0x80 ? char(code) : '?';
+                this->text += 4;
+                break;
+            }
+            default: out += c; break; // \" \\ \/
+            }
+        }
+        if(this->text == this->end)
+            return this->fail("unterminated string");
+        this->text++;
+        return true;
+    }
+
+    bool value(JsonValue& out)
+    {
+        this->skipSpace();
+        if(this->text == this->end)
+            return this->fail("unexpected end");
+        char c = *this->text;
+        if(c == '{')
+        {
+            out.type = JsonValue::JSON_OBJECT;
+            this->text++;
+            this->skipSpace();
+            if(this->text < this->end && *this->text == '}')
+            {
+                this->text++;
+                return true;
+            }
+            while(true)
+            {
+                this->skipSpace();
+                if(this->text == this->end || *this->text != '"')
+                    return this->fail("expected key");
+                std::pair<std::string, JsonValue> member;
+                if(!this->string(member.first))
+                    return false;
+                this->skipSpace();
+                if(this->text == this->end || *this->text != ':')
+                    return this->fail("expected ':'");
+                this->text++;
+                if(!this->value(member.second))
+                    return false;
+                out.members.push_back(member);
+                this->skipSpace();
+                if(this->text < this->end && *this->text == ',')
+                {
+                    this->text++;
+                    continue;
+                }
+                if(this->text < this->end && *this->text == '}')
+                {
+                    this->text++;
+                    return true;
+                }
+                return this->fail("expected ',' or '}'");
+            }
+        }
+        if(c == '[')
+        {
+            out.type = JsonValue::JSON_ARRAY;
+            this->text++;
+            this->skipSpace();
+            if(this->text < this->end && *this->text == ']')
+            {
+                this->text++;
+                return true;
+            }
+            while(true)
+            {
+                out.items.push_back(JsonValue());
+                if(!this->value(out.items.back()))
+                    return false;
+                this->skipSpace();
+                if(this->text < this->end && *this->text == ',')
+                {
+                    this->text++;
+                    continue;
+                }
+                if(this->text < this->end && *this->text == ']')
+                {
+                    this->text++;
+                    return true;
+                }
+                return this->fail("expected ',' or ']'");
+            }
+        }
+        if(c == '"')
+        {
+            out.type = JsonValue::JSON_STRING;
+            return this->string(out.text);
+        }
+        if(c == 't' || c == 'f')
+        {
+            out.type = JsonValue::JSON_BOOL;
+            out.number = (c == 't') ? 1.0 : 0.0;
+            return this->literal(c == 't' ? "true" : "false");
+        }
+        if(c == 'n')
+        {
+            out.type = JsonValue::JSON_NULL;
+            return this->literal("null");
+        }
+        // 数字：strtod 需要以 '\0' 结尾，先复制出数字部分
+        const char* start = this->text;
+        while(this->text < this->end && std::strchr("+-0123456789.eE", *this->text))
+            this->text++;
+        if(this->text == start)
+            return this->fail("unexpected character");
+        std::string digits(start, this->text);
+        char* parsed = NULL;
+        out.type = JsonValue::JSON_NUMBER;
+        out.number = std::strtod(digits.c_str(), &parsed);
+        return *parsed == '\0' || this->fail("bad number");
+    }
+};
+
+// == ======================================
+// 可编辑的场景描述（JSON 解析结果，烘焙的输入）
+// == ======================================
+struct SceneDescription
+{
+    struct Model    { std::string name, path; };
+    struct Material { std::string name, diffuse, specular; GLfloat shininess; };
+    struct Object
+    {
+        std::string model, material;
+        glm::vec3 position, axis, scale;
+        GLfloat angle;  // 与 glm::rotate 的角度参数相同
+        GLfloat radius; // 模型空间包围球半径（乘以最大缩放得到世界空间半径）
+    };
+
+    std::vector<Model> models;
+    std::vector<Material> materials;
+    std::vector<Object> objects;
+    bool hasDirLight;
+    SceneDirLight dirLight;
+    std::vector<PointLight> pointLights;
+    std::vector<SpotLight> spotLights;
+
+    SceneDescription() : hasDirLight(false) { }
+};
+
+inline bool ParseSceneJson(const char* text, size_t size, SceneDescription& scene, const std::string& path)
+{
+    JsonValue root;
+    JsonParser parser(text, size);
+    if(!parser.Parse(root) || root.type != JsonValue::JSON_OBJECT)
+    {
+        std::cout << "ERROR::SCENE_FILE:: " << path << ": " << (parser.Error().empty() ? "root must be an object" : parser.Error()) << std::endl;
+        return false;
+    }
+    const glm::vec3 zero(0.0f), one(1.0f);
+
+    for(const JsonValue& item : root["models"].items)
+    {
+        SceneDescription::Model model = { item["name"].String(), item["path"].String() };
+        scene.models.push_back(model);
+    }
+    for(const JsonValue& item : root["materials"].items)
+    {
+        SceneDescription::Material material = { item["name"].String(), item["diffuse"].String(), item["specular"].String(),
+                                                item["shininess"].Number(32.0f) };
+        scene.materials.push_back(material);
+    }
+    for(const JsonValue& item : root["objects"].items)
+    {
+        const JsonValue& rotation = item["rotation"];
+        SceneDescription::Object object;
+        object.model    = item["model"].String();
+        object.material = item["material"].String();
+        object.position = item["position"].Vec3(zero);
+        object.axis     = rotation["axis"].Vec3(glm::vec3(0.0f, 1.0f, 0.0f));
+        object.angle    = rotation["angle"].Number(0.0f);
+        object.scale    = item["scale"].Vec3(one);
+        object.radius   = item["radius"].Number(0.87f);
+        scene.objects.push_back(object);
+    }
+
+    const JsonValue& dir = root["dirLight"];
+    scene.hasDirLight = dir.type == JsonValue::JSON_OBJECT;
+    if(scene.hasDirLight)
+    {
+        scene.dirLight.direction = dir["direction"].Vec3(glm::vec3(0.0f, -1.0f, 0.0f));
+        scene.dirLight.ambient   = dir["ambient"].Vec3(zero);
+        scene.dirLight.diffuse   = dir["diffuse"].Vec3(zero);
+        scene.dirLight.specular  = dir["specular"].Vec3(zero);
+    }
+    for(const JsonValue& item : root["pointLights"].items)
+    {
+        PointLight light;
+        light.position  = item["position"].Vec3(zero);
+        light.ambient   = item["ambient"].Vec3(zero);
+        light.diffuse   = item["diffuse"].Vec3(one);
+        light.specular  = item["specular"].Vec3(one);
+        light.constant  = item["constant"].Number(1.0f);
+        light.linear    = item["linear"].Number(0.09f);
+        light.quadratic = item["quadratic"].Number(0.032f);
+        light.range     = LightRange(light);
+        scene.pointLights.push_back(light);
+    }
+    for(const JsonValue& item : root["spotLights"].items)
+    {
+        SpotLight light;
+        light.position    = item["position"].Vec3(zero);
+        light.direction   = item["direction"].Vec3(glm::vec3(0.0f, 0.0f, -1.0f));
+        light.ambient     = item["ambient"].Vec3(zero);
+        light.diffuse     = item["diffuse"].Vec3(one);
+        light.specular    = item["specular"].Vec3(one);
+        light.cutOff      = std::cos(glm::radians(item["cutOff"].Number(12.5f)));
+        light.outerCutOff = std::cos(glm::radians(item["outerCutOff"].Number(15.0f)));
+        light.constant    = item["constant"].Number(1.0f);
+        light.linear      = item["linear"].Number(0.09f);
+        light.quadratic   = item["quadratic"].Number(0.032f);
+        scene.spotLights.push_back(light);
+    }
+    return true;
+}
+
+inline GLuint64 HashSceneSource(const char* data, size_t size)
+{
+    GLuint64 hash = 14695981039346656037ull;
+    for(size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// == ======================================
+// 烘焙
+// == ======================================
+namespace scene_file_detail
+{
+    inline GLuint Align(std::vector<char>& out)
+    {
+        out.resize((out.size() + 15) & ~size_t(15), 0);
+        return GLuint(out.size());
+    }
+
+    template<typename T>
+    inline GLuint Append(std::vector<char>& out, const std::vector<T>& items)
+    {
+        GLuint offset = Align(out);
+        if(!items.empty())
+            out.insert(out.end(), reinterpret_cast<const char*>(&items[0]), reinterpret_cast<const char*>(&items[0] + items.size()));
+        return offset;
+    }
+
+    // 相同的字符串只存一次
+    inline GLuint Intern(std::vector<char>& strings, std::vector<std::pair<std::string, GLuint> >& known, const std::string& text)
+    {
+        if(text.empty())
+            return SCENE_NO_INDEX;
+        for(const std::pair<std::string, GLuint>& entry : known)
+            if(entry.first == text)
+                return entry.second;
+        GLuint offset = GLuint(strings.size());
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        known.push_back(std::make_pair(text, offset));
+        return offset;
+    }
+
+    template<typename T>
+    inline GLuint FindByName(const std::vector<T>& items, const std::string& name)
+    {
+        for(GLuint i = 0; i < items.size(); i++)
+            if(items[i].name == name)
+                return i;
+        return SCENE_NO_INDEX;
+    }
+}
+
+// 把场景描述烘焙成二进制，找不到的模型/材质名字报错
+inline bool CookScene(const SceneDescription& scene, GLuint64 sourceHash, std::vector<char>& out)
+{
+    using namespace scene_file_detail;
+    std::vector<char> strings;
+    std::vector<std::pair<std::string, GLuint> > known;
+
+    std::vector<SceneModel> models;
+    for(const SceneDescription::Model& model : scene.models)
+    {
+        SceneModel cooked = { Intern(strings, known, model.name), Intern(strings, known, model.path) };
+        models.push_back(cooked);
+    }
+    std::vector<SceneMaterial> materials;
+    for(const SceneDescription::Material& material : scene.materials)
+    {
+        SceneMaterial cooked = { Intern(strings, known, material.name), Intern(strings, known, material.diffuse),
+                                 Intern(strings, known, material.specular), material.shininess };
+        materials.push_back(cooked);
+    }
+    std::vector<SceneObject> objects;
+    for(const SceneDescription::Object& object : scene.objects)
+    {
+        SceneObject cooked;
+        cooked.reserved[0] = cooked.reserved[1] = 0;
+        cooked.model = FindByName(scene.models, object.model);
+        cooked.material = object.material.empty() ? SCENE_NO_INDEX : FindByName(scene.materials, object.material);
+        if(cooked.model == SCENE_NO_INDEX || (!object.material.empty() && cooked.material == SCENE_NO_INDEX))
+        {
+            std::cout << "ERROR::SCENE_FILE:: unknown model or material '" << object.model << "' / '" << object.material << "'" << std::endl;
+            return false;
+        }
+        // 与案例中原来的写法相同：先平移，再旋转，再缩放
+        glm::mat4 transform;
+        transform = glm::translate(transform, object.position);
+        if(object.angle != 0.0f)
+            transform = glm::rotate(transform, object.angle, object.axis);
+        transform = glm::scale(transform, object.scale);
+        cooked.transform = transform;
+        cooked.center = object.position;
+        cooked.radius = object.radius * std::max(std::fabs(object.scale.x), std::max(std::fabs(object.scale.y), std::fabs(object.scale.z)));
+        objects.push_back(cooked);
+    }
+    strings.push_back('\0'); // 保证表以 '\0' 结尾
+
+    SceneFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_FILE_VERSION;
+    header.sourceHash = sourceHash;
+    header.modelCount = GLuint(models.size());
+    header.materialCount = GLuint(materials.size());
+    header.objectCount = GLuint(objects.size());
+    header.pointLightCount = GLuint(scene.pointLights.size());
+    header.spotLightCount = GLuint(scene.spotLights.size());
+    header.hasDirLight = scene.hasDirLight ? 1 : 0;
+
+    out.assign(sizeof(header), 0);
+    header.modelOffset = Append(out, models);
+    header.materialOffset = Append(out, materials);
+    header.objectOffset = Append(out, objects);
+    header.pointLightOffset = Append(out, scene.pointLights);
+    header.spotLightOffset = Append(out, scene.spotLights);
+    header.dirLightOffset = Append(out, std::vector<SceneDirLight>(scene.hasDirLight ? 1 : 0, scene.dirLight));
+    header.stringOffset = Append(out, strings);
+    header.stringSize = GLuint(strings.size());
+    std::memcpy(&out[0], &header, sizeof(header));
+    return true;
+}
+
+// == ======================================
+// 载入：只映射一次文件，数组直接指向映射
+// == ======================================
+class SceneFile
+{
+public:
+    SceneFile() : data(nullptr), header(nullptr) { }
+
+    // 打开烘焙后的二进制场景
+    bool Open(const std::string& path)
+    {
+        this->Close();
+        if(!this->file.Open(path))
+            return false;
+        return this->validate(this->file.Data(), this->file.Size(), path);
+    }
+
+    // 使用内存中的烘焙结果（无法写入二进制文件时）
+    bool Adopt(std::vector<char>& cooked, const std::string& path)
+    {
+        this->Close();
+        this->owned.swap(cooked);
+        return this->validate(this->owned.data(), this->owned.size(), path);
+    }
+
+    void Close()
+    {
+        this->header = nullptr;
+        this->file.Close();
+        std::vector<char>().swap(this->owned);
+    }
+
+    bool Valid() const { return this->header != nullptr; }
+    GLuint64 SourceHash() const { return this->header ? this->header->sourceHash : 0; }
+
+    GLuint ModelCount() const         { return this->header ? this->header->modelCount : 0; }
+    GLuint MaterialCount() const      { return this->header ? this->header->materialCount : 0; }
+    GLuint ObjectCount() const        { return this->header ? this->header->objectCount : 0; }
+    GLuint PointLightCount() const    { return this->header ? this->header->pointLightCount : 0; }
+    GLuint SpotLightCount() const     { return this->header ? this->header->spotLightCount : 0; }
+    bool   HasDirLight() const        { return this->header && this->header->hasDirLight; }
+
+    const SceneModel* Models() const       { return this->array<SceneModel>(this->header->modelOffset); }
+    const SceneMaterial* Materials() const { return this->array<SceneMaterial>(this->header->materialOffset); }
+    const SceneObject* Objects() const     { return this->array<SceneObject>(this->header->objectOffset); }
+    const PointLight* PointLights() const  { return this->array<PointLight>(this->header->pointLightOffset); }
+    const SpotLight* SpotLights() const    { return this->array<SpotLight>(this->header->spotLightOffset); }
+    const SceneDirLight& DirLight() const  { return *this->array<SceneDirLight>(this->header->dirLightOffset); }
+
+    // 字符串表中的字符串，SCENE_NO_INDEX 或越界时返回空串
+    const char* String(GLuint offset) const
+    {
+        if(!this->header || offset >= this->header->stringSize)
+            return "";
+        return this->data + this->header->stringOffset + offset;
+    }
+
+    // 按名字查找模型/材质，找不到返回 SCENE_NO_INDEX
+    GLuint FindModel(const char* name) const
+    {
+        for(GLuint i = 0; i < this->ModelCount(); i++)
+            if(std::strcmp(this->String(this->Models()[i].name), name) == 0)
+                return i;
+        return SCENE_NO_INDEX;
+    }
+
+    GLuint FindMaterial(const char* name) const
+    {
+        for(GLuint i = 0; i < this->MaterialCount(); i++)
+            if(std::strcmp(this->String(this->Materials()[i].name), name) == 0)
+                return i;
+        return SCENE_NO_INDEX;
+    }
+
+private:
+    SceneFile(const SceneFile&);
+    SceneFile& operator=(const SceneFile&);
+
+    AssetFile file;
+    std::vector<char> owned;
+    const char* data;
+    const SceneFileHeader* header;
+
+    template<typename T>
+    const T* array(GLuint offset) const
+    {
+        return reinterpret_cast<const T*>(this->data + offset);
+    }
+
+    static bool inside(size_t size, GLuint offset, GLuint count, size_t stride)
+    {
+        return offset % 4 == 0 && offset <= size && GLuint64(count) * stride <= size - offset;
+    }
+
+    bool validate(const char* bytes, size_t size, const std::string& path)
+    {
+        this->header = nullptr;
+        this->data = bytes;
+        const SceneFileHeader* h = reinterpret_cast<const SceneFileHeader*>(bytes);
+        bool ok = size >= sizeof(SceneFileHeader) && std::memcmp(h->magic, SCENE_FILE_MAGIC, 4) == 0 && h->version == SCENE_FILE_VERSION &&
+                  inside(size, h->modelOffset, h->modelCount, sizeof(SceneModel)) &&
+                  inside(size, h->materialOffset, h->materialCount, sizeof(SceneMaterial)) &&
+                  inside(size, h->objectOffset, h->objectCount, sizeof(SceneObject)) &&
+                  inside(size, h->pointLightOffset, h->pointLightCount, sizeof(PointLight)) &&
+                  inside(size, h->spotLightOffset, h->spotLightCount, sizeof(SpotLight)) &&
+                  inside(size, h->dirLightOffset, h->hasDirLight ? 1 : 0, sizeof(SceneDirLight)) &&
+                  inside(size, h->stringOffset, h->stringSize, 1) && h->stringSize > 0 && bytes[h->stringOffset + h->stringSize - 1] == '\0';
+        // 物体引用的模型和材质必须存在
+        const SceneObject* objects = ok ? reinterpret_cast<const SceneObject*>(bytes + h->objectOffset) : nullptr;
+        for(GLuint i = 0; ok && i < h->objectCount; i++)
+            ok = objects[i].model < h->modelCount && (objects[i].material == SCENE_NO_INDEX || objects[i].material < h->materialCount);
+        if(!ok)
+        {
+            std::cout << "ERROR::SCENE_FILE:: invalid cooked scene " << path << std::endl;
+            return false;
+        }
+        this->header = h;
+        return true;
+    }
+};
+
+// 烘焙后的文件名：a.scene.json -> a.scene.scn
+inline std::string CookedScenePath(const std::string& jsonPath)
+{
+    size_t dot = jsonPath.rfind(".json");
+    return (dot != std::string::npos && dot + 5 == jsonPath.size() ? jsonPath.substr(0, dot) : jsonPath) + ".scn";
+}
+
+// 打开场景：二进制存在且与 JSON 一致时直接映射；否则解析 JSON、烘焙并写出二进制（写不出时使用内存中的结果）。
+// 只有二进制（例如打进资源包、没有带 JSON）时也可以直接使用。
+inline bool OpenScene(const std::string& jsonPath, SceneFile& scene)
+{
+    std::string cookedPath = CookedScenePath(jsonPath);
+    AssetFile source;
+    bool hasSource = source.Open(jsonPath);
+    GLuint64 hash = hasSource ? HashSceneSource(source.Data(), source.Size()) : 0;
+
+    if(scene.Open(cookedPath) && (!hasSource || scene.SourceHash() == hash))
+        return true;
+    // 重新写文件前先解除旧的映射
+    scene.Close();
+    if(!hasSource)
+    {
+        std::cout << "ERROR::SCENE_FILE:: cannot open " << jsonPath << std::endl;
+        return false;
+    }
+
+    SceneDescription description;
+    std::vector<char> bytes;
+    if(!ParseSceneJson(source.Data(), source.Size(), description, jsonPath) || !CookScene(description, hash, bytes))
+        return false;
+    std::ofstream out(cookedPath.c_str(), std::ios::binary);
+    if(out && out.write(bytes.data(), bytes.size()) && (out.close(), true) && scene.Open(cookedPath) && scene.SourceHash() == hash)
+        return true;
+    return scene.Adopt(bytes, jsonPath);
+}
+
+#endif
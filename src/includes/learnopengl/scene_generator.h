@@ -0,0 +1,222 @@
+#ifndef SCENE_GENERATOR_H
+#define SCENE_GENERATOR_H
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <learnopengl/light_assignment.h>
+
+// 物体在空间中的分布方式
+enum SceneDistribution
+{
+    DIST_UNIFORM,   // 立方体内均匀分布
+    DIST_CLUSTERED, // 聚成若干团
+    DIST_GRID,      // 规则网格
+    DIST_SHELL      // 球壳（围绕原点）
+};
+
+// 压力测试场景的参数
+struct SceneConfig
+{
+    GLuint objectCount;     // 箱子数量 N
+    GLuint pointLightCount; // 点光源数量 M
+    GLuint spotLightCount;  // 聚光灯数量
+    GLuint modelCount;      // 模型实例数量 K
+    SceneDistribution distribution;
+    GLuint clusterCount;    // DIST_CLUSTERED 的团数
+    GLfloat extent;         // 场景半径
+    GLuint seed;            // 相同的种子生成相同的场景
+
+    SceneConfig()
+        : objectCount(10), pointLightCount(4), spotLightCount(0), modelCount(1),
+          distribution(DIST_UNIFORM), clusterCount(8), extent(20.0f), seed(1)
+    {
+    }
+};
+
+// 生成的场景
+struct GeneratedScene
+{
+    std::vector<glm::vec3> objectPositions; // 箱子位置（用于分配灯光）
+    std::vector<glm::vec4> objectRotations; // 箱子的旋转：xyz 为旋转轴，w 为角度（度，与 glm::rotate 一致）
+    std::vector<glm::mat4> objectModels;    // 箱子模型矩阵
+    std::vector<PointLight> pointLights;
+    std::vector<SpotLight> spotLights;
+    std::vector<glm::mat4> modelInstances;  // 模型实例的模型矩阵
+};
+
+// 场景随机数
+// 不使用 std::uniform_real_distribution（各标准库实现的结果不同），
+// 直接由 mt19937 的输出换算，保证不同平台上同一种子得到同一场景。
+class SceneRandom
+{
+public:
+    SceneRandom(GLuint seed) : engine(seed) { }
+
+    // [0, 1)
+    GLfloat Next()
+    {
+        return GLfloat(this->engine() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // [a, b)
+    GLfloat Range(GLfloat a, GLfloat b)
+    {
+        return a + (b - a) * this->Next();
+    }
+
+    // 近似正态分布（三个均匀分布之和），范围 [-1, 1]
+    GLfloat Bell()
+    {
+        return (this->Next() + this->Next() + this->Next()) * (2.0f / 3.0f) - 1.0f;
+    }
+
+    glm::vec3 InCube(GLfloat extent)
+    {
+        return glm::vec3(this->Range(-extent, extent), this->Range(-extent, extent), this->Range(-extent, extent));
+    }
+
+    glm::vec3 OnSphere()
+    {
+        GLfloat z = this->Range(-1.0f, 1.0f);
+        GLfloat phi = this->Range(0.0f, 6.2831853f);
+        GLfloat r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        return glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+private:
+    std::mt19937 engine;
+};
+
+// 按分布方式生成 count 个位置
+inline std::vector<glm::vec3> GeneratePositions(SceneRandom& random, GLuint count, SceneDistribution distribution,
+                                                GLfloat extent, GLuint clusterCount)
+{
+    std::vector<glm::vec3> positions;
+    positions.reserve(count);
+    switch(distribution)
+    {
+    case DIST_CLUSTERED:
+    {
+        std::vector<glm::vec3> centers(std::max(clusterCount, 1u));
+        for(glm::vec3& center : centers)
+            center = random.InCube(extent * 0.8f);
+        GLfloat spread = extent * 0.15f;
+        for(GLuint i = 0; i < count; i++)
+        {
+            const glm::vec3& center = centers[GLuint(random.Next() * centers.size()) % centers.size()];
+            positions.push_back(center + glm::vec3(random.Bell(), random.Bell(), random.Bell()) * spread);
+        }
+        break;
+    }
+    case DIST_GRID:
+    {
+        GLuint side = std::max(1u, GLuint(std::ceil(std::cbrt(GLfloat(count)))));
+        GLfloat spacing = 2.0f * extent / side;
+        for(GLuint i = 0; i < count; i++)
+        {
+            GLuint x = i % side, y = (i / side) % side, z = i / (side * side);
+            positions.push_back(glm::vec3(x + 0.5f, y + 0.5f, z + 0.5f) * spacing - glm::vec3(extent));
+        }
+        break;
+    }
+    case DIST_SHELL:
+        for(GLuint i = 0; i < count; i++)
+            positions.push_back(random.OnSphere() * random.Range(extent * 0.8f, extent));
+        break;
+    case DIST_UNIFORM:
+    default:
+        for(GLuint i = 0; i < count; i++)
+            positions.push_back(random.InCube(extent));
+        break;
+    }
+    return positions;
+}
+
+// 生成压力测试场景
+// 箱子与灯光使用相同的分布，这样灯光总是落在物体附近。
+inline GeneratedScene GenerateScene(const SceneConfig& config)
+{
+    // 常用的衰减系数（对应影响距离 7、13、20、32、50）
+    static const GLfloat attenuations[][2] = {
+        { 0.7f,  1.8f   },
+        { 0.35f, 0.44f  },
+        { 0.22f, 0.20f  },
+        { 0.14f, 0.07f  },
+        { 0.09f, 0.032f }
+    };
+
+    SceneRandom random(config.seed);
+    GeneratedScene scene;
+
+    // 箱子：位置 + 随机旋转
+    scene.objectPositions = GeneratePositions(random, config.objectCount, config.distribution, config.extent, config.clusterCount);
+    scene.objectRotations.reserve(config.objectCount);
+    scene.objectModels.reserve(config.objectCount);
+    for(const glm::vec3& position : scene.objectPositions)
+    {
+        GLfloat angle = random.Range(0.0f, 360.0f); // glm::rotate 的角度以度为单位
+        glm::vec3 axis = glm::normalize(random.OnSphere() + glm::vec3(0.0f, 0.0f, 1e-3f));
+        glm::mat4 model;
+        model = glm::translate(model, position);
+        model = glm::rotate(model, angle, axis);
+        scene.objectRotations.push_back(glm::vec4(axis, angle));
+        scene.objectModels.push_back(model);
+    }
+
+    // 点光源
+    std::vector<glm::vec3> lightPositions = GeneratePositions(random, config.pointLightCount, config.distribution, config.extent, config.clusterCount);
+    for(const glm::vec3& position : lightPositions)
+    {
+        PointLight light;
+        const GLfloat* attenuation = attenuations[GLuint(random.Next() * 5) % 5];
+        glm::vec3 color(random.Range(0.3f, 1.0f), random.Range(0.3f, 1.0f), random.Range(0.3f, 1.0f));
+        light.position  = position;
+        light.ambient   = color * 0.05f;
+        light.diffuse   = color * 0.8f;
+        light.specular  = color;
+        light.constant  = 1.0f;
+        light.linear    = attenuation[0];
+        light.quadratic = attenuation[1];
+        light.range     = LightRange(light);
+        scene.pointLights.push_back(light);
+    }
+
+    // 聚光灯：从外侧大致朝向场景中心
+    for(GLuint i = 0; i < config.spotLightCount; i++)
+    {
+        SpotLight light;
+        const GLfloat* attenuation = attenuations[2 + GLuint(random.Next() * 3) % 3];
+        light.position    = random.OnSphere() * config.extent;
+        light.direction   = glm::normalize(random.InCube(config.extent * 0.3f) - light.position);
+        light.ambient     = glm::vec3(0.0f);
+        light.diffuse     = glm::vec3(1.0f);
+        light.specular    = glm::vec3(1.0f);
+        light.cutOff      = std::cos(glm::radians(random.Range(10.0f, 20.0f)));
+        light.outerCutOff = light.cutOff - 0.03f;
+        light.constant    = 1.0f;
+        light.linear      = attenuation[0];
+        light.quadratic   = attenuation[1];
+        scene.spotLights.push_back(light);
+    }
+
+    // 模型实例：放在地面高度，随机朝向，缩放与 model_rendered 一致
+    std::vector<glm::vec3> modelPositions = GeneratePositions(random, config.modelCount, config.distribution, config.extent, config.clusterCount);
+    for(const glm::vec3& position : modelPositions)
+    {
+        glm::mat4 model;
+        model = glm::translate(model, glm::vec3(position.x, -1.75f, position.z));
+        model = glm::rotate(model, random.Range(0.0f, 360.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));
+        scene.modelInstances.push_back(model);
+    }
+    return scene;
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef SHADER_PERMUTATION_H
+#define SHADER_PERMUTATION_H
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <unordered_map>
+
+#include <GL/glew.h>
+
+#include <learnopengl/trace.h>
+
+// 着色器特性位（低 8 位）
+enum PermutationFeature
+{
+    PERM_DIR_LIGHT    = 1 << 0, // 平行光
+    PERM_SPOT_LIGHT   = 1 << 1, // 聚光灯
+    PERM_SPECULAR_MAP = 1 << 2, // 镜面贴图（关闭时使用 material.specularColor）
+    PERM_LIGHT_LIST   = 1 << 3, // 按物体上传的点光源列表，数量由 nrPointLights 给出
+    PERM_SHADOWS      = 1 << 4, // 平行光的级联阴影
+    PERM_PACKED_VERTICES = 1 << 5, // 压缩顶点格式（vertex_packing.h）
+    PERM_TEXTURE_ARRAY   = 1 << 6  // 材质贴图来自贴图数组（texture_array.h）
+};
+
+// 点光源数量保存在 8-11 位
+const GLuint PERM_POINT_LIGHT_SHIFT = 8;
+const GLuint PERM_MAX_POINT_LIGHTS  = 15;
+
+// 由特性位和点光源数量组合出变体的键值
+inline GLuint PermutationKey(GLuint features, GLuint pointLights)
+{
+    if(pointLights > PERM_MAX_POINT_LIGHTS)
+        pointLights = PERM_MAX_POINT_LIGHTS;
+    return (features & 0xFF) | (pointLights << PERM_POINT_LIGHT_SHIFT);
+}
+
+// 着色器变体系统
+// 同一份源码根据键值生成 #define 头并编译成专用程序，
+// 关闭的特性在预处理阶段被裁掉，而不是在运行时分支。
+// 变体在第一次 Get() 时才编译，之后按键值缓存。
+class ShaderPermutation
+{
+public:
+    ShaderPermutation(const GLchar* vertexPath, const GLchar* fragmentPath)
+    {
+        this->vertexCode   = this->readFile(vertexPath);
+        this->fragmentCode = this->readFile(fragmentPath);
+    }
+
+    ~ShaderPermutation()
+    {
+        for(auto& entry : this->programs)
+            glDeleteProgram(entry.second);
+    }
+
+    // 获取（必要时编译）指定键值的着色器程序
+    GLuint Get(GLuint key)
+    {
+        auto found = this->programs.find(key);
+        if(found != this->programs.end())
+            return found->second;
+
+        TRACE_SCOPE("CompileShaderPermutation");
+        std::string defines = this->buildDefines(key);
+        GLuint program = this->compile(this->inject(this->vertexCode, defines),
+                                       this->inject(this->fragmentCode, defines));
+        this->programs[key] = program;
+        return program;
+    }
+
+    // 激活指定变体并返回程序对象，方便获取 uniform 地址
+    GLuint Use(GLuint key)
+    {
+        GLuint program = this->Get(key);
+        glUseProgram(program);
+        return program;
+    }
+
+    // 已编译的变体数量
+    size_t Count() const
+    {
+        return this->programs.size();
+    }
+
+private:
+    ShaderPermutation(const ShaderPermutation&);
+    ShaderPermutation& operator=(const ShaderPermutation&);
+
+    std::string vertexCode;
+    std::string fragmentCode;
+    std::unordered_map<GLuint, GLuint> programs;
+
+    std::string readFile(const GLchar* path)
+    {
+        std::ifstream file;
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            file.open(path);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            file.close();
+            return stream.str();
+        }
+        catch(const std::ifstream::failure& e)
+        {
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << path << std::endl;
+        }
+        return std::string();
+    }
+
+    // 每个宏都显式给出 0/1，源码可以用 #if 判断，也可以单独载入（使用源码中的默认值）
+    std::string buildDefines(GLuint key)
+    {
+        std::stringstream defines;
+        defines << "#define NR_POINT_LIGHTS "  << (key >> PERM_POINT_LIGHT_SHIFT & PERM_MAX_POINT_LIGHTS) << "\n";
+        defines << "#define USE_DIR_LIGHT "    << ((key & PERM_DIR_LIGHT)    ? 1 : 0) << "\n";
+        defines << "#define USE_SPOT_LIGHT "   << ((key & PERM_SPOT_LIGHT)   ? 1 : 0) << "\n";
+        defines << "#define USE_SPECULAR_MAP " << ((key & PERM_SPECULAR_MAP) ? 1 : 0) << "\n";
+        defines << "#define USE_LIGHT_LIST "   << ((key & PERM_LIGHT_LIST)   ? 1 : 0) << "\n";
+        defines << "#define USE_SHADOWS "      << ((key & PERM_SHADOWS)      ? 1 : 0) << "\n";
+        defines << "#define PACKED_VERTICES "  << ((key & PERM_PACKED_VERTICES) ? 1 : 0) << "\n";
+        defines << "#define TEXTURE_ARRAY "    << ((key & PERM_TEXTURE_ARRAY)   ? 1 : 0) << "\n";
+        return defines.str();
+    }
+
+    // #version 必须位于首行，宏定义插在它后面；#line 2 让报错行号与源文件一致
+    std::string inject(const std::string& source, const std::string& defines)
+    {
+        size_t pos = 0;
+        if(source.compare(0, 8, "#version") == 0)
+        {
+            pos = source.find('\n');
+            pos = (pos == std::string::npos) ? source.size() : pos + 1;
+        }
+        return source.substr(0, pos) + defines + "#line 2\n" + source.substr(pos);
+    }
+
+    GLuint compile(const std::string& vertexSource, const std::string& fragmentSource)
+    {
+        const GLchar* vShaderCode = vertexSource.c_str();
+        const GLchar* fShaderCode = fragmentSource.c_str();
+
+        GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertex, 1, &vShaderCode, NULL);
+        glCompileShader(vertex);
+        this->checkCompileErrors(vertex, "VERTEX");
+
+        GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment, 1, &fShaderCode, NULL);
+        glCompileShader(fragment);
+        this->checkCompileErrors(fragment, "FRAGMENT");
+
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+        glLinkProgram(program);
+        this->checkCompileErrors(program, "PROGRAM");
+
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        return program;
+    }
+
+    void checkCompileErrors(GLuint shader, std::string type)
+    {
+        GLint success;
+        GLchar infoLog[1024];
+        if(type != "PROGRAM")
+        {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if(!success)
+            {
+                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "| ERROR::SHADER-COMPILATION-ERROR of type: " << type << "|\n" << infoLog << std::endl;
+            }
+        }
+        else
+        {
+            glGetProgramiv(shader, GL_LINK_STATUS, &success);
+            if(!success)
+            {
+                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "| ERROR::PROGRAM-LINKING-ERROR of type: " << type << "|\n" << infoLog << std::endl;
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include <GL/glew.h>
+
+// == ======================================
+// 4 路 float 向量
+// 动画、CPU mipmap 和遮挡剔除的内层循环都是对连续 float 数组做同样的运算。
+// 依赖编译器自动向量化不可靠（GCC 在 -O2 下不向量化，带条件选择的循环常常也不行），
+// 这里直接用指令集：
+// 1. x86 用 SSE2（x86-64 必有），ARM 用 NEON，其他平台退回逐分量的标量实现，结果一致；
+// 2. Load/Store 不要求对齐；LoadN/StoreN 处理数组末尾不足 4 个的部分；
+// 3. 比较得到逐分量的掩码（全 1 或全 0），配合 Select 代替分支。
+// == ======================================
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+struct Float4
+{
+#if defined(SIMD_SSE2)
+    __m128 v;
+#elif defined(SIMD_NEON)
+    float32x4_t v;
+#else
+    GLfloat v[4];
+#endif
+};
+
+inline Float4 Float4Load(const GLfloat* p)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_loadu_ps(p);
+#elif defined(SIMD_NEON)
+    r.v = vld1q_f32(p);
+#else
+    std::memcpy(r.v, p, sizeof(r.v));
+#endif
+    return r;
+}
+
+inline void Float4Store(GLfloat* p, Float4 a)
+{
+#if defined(SIMD_SSE2)
+    _mm_storeu_ps(p, a.v);
+#elif defined(SIMD_NEON)
+    vst1q_f32(p, a.v);
+#else
+    std::memcpy(p, a.v, sizeof(a.v));
+#endif
+}
+
+// 只读写前 count 个分量（不足 4 个时其余分量为 0），用于数组末尾
+inline Float4 Float4LoadN(const GLfloat* p, size_t count)
+{
+    if(count >= 4)
+        return Float4Load(p);
+    GLfloat buffer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    std::copy(p, p + count, buffer);
+    return Float4Load(buffer);
+}
+
+inline void Float4StoreN(GLfloat* p, Float4 a, size_t count)
+{
+    if(count >= 4)
+    {
+        Float4Store(p, a);
+        return;
+    }
+    GLfloat buffer[4];
+    Float4Store(buffer, a);
+    std::copy(buffer, buffer + count, p);
+}
+
+inline Float4 Float4Set(GLfloat s)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_set1_ps(s);
+#elif defined(SIMD_NEON)
+    r.v = vdupq_n_f32(s);
+#else
+    r.v[0] = r.v[1] = r.v[2] = r.v[3] = s;
+#endif
+    return r;
+}
+
+// (s, s + 1, s + 2, s + 3)
+inline Float4 Float4Ramp(GLfloat s)
+{
+    GLfloat values[4] = { s, s + 1.0f, s + 2.0f, s + 3.0f };
+    return Float4Load(values);
+}
+
+#if defined(SIMD_SSE2)
+#define FLOAT4_BINARY(name, sse, neon, expr) \
+    inline Float4 name(Float4 a, Float4 b) { Float4 r; r.v = sse(a.v, b.v); return r; }
+#elif defined(SIMD_NEON)
+#define FLOAT4_BINARY(name, sse, neon, expr) \
+    inline Float4 name(Float4 a, Float4 b) { Float4 r; r.v = neon(a.v, b.v); return r; }
+#else
+#define FLOAT4_BINARY(name, sse, neon, expr) \
+    inline Float4 name(Float4 a, Float4 b) { Float4 r; for(GLint i = 0; i < 4; i++) { GLfloat x = a.v[i], y = b.v[i]; r.v[i] = (expr); } return r; }
+#endif
+
+FLOAT4_BINARY(operator+, _mm_add_ps, vaddq_f32, x + y)
+FLOAT4_BINARY(operator-, _mm_sub_ps, vsubq_f32, x - y)
+FLOAT4_BINARY(operator*, _mm_mul_ps, vmulq_f32, x * y)
+FLOAT4_BINARY(Float4Min, _mm_min_ps, vminq_f32, (y < x) ? y : x)
+FLOAT4_BINARY(Float4Max, _mm_max_ps, vmaxq_f32, (y > x) ? y : x)
+
+#undef FLOAT4_BINARY
+
+inline Float4 operator/(Float4 a, Float4 b)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_div_ps(a.v, b.v);
+#elif defined(SIMD_NEON) && defined(__aarch64__)
+    r.v = vdivq_f32(a.v, b.v);
+#elif defined(SIMD_NEON)
+    // ARMv7 没有除法指令：倒数估计 + 两次牛顿迭代
+    float32x4_t inv = vrecpeq_f32(b.v);
+    inv = vmulq_f32(inv, vrecpsq_f32(b.v, inv));
+    inv = vmulq_f32(inv, vrecpsq_f32(b.v, inv));
+    r.v = vmulq_f32(a.v, inv);
+#else
+    for(GLint i = 0; i < 4; i++)
+        r.v[i] = a.v[i] / b.v[i];
+#endif
+    return r;
+}
+
+// 逐分量比较，结果为掩码
+inline Float4 Float4GreaterEqual(Float4 a, Float4 b)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_cmpge_ps(a.v, b.v);
+#elif defined(SIMD_NEON)
+    r.v = vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v));
+#else
+    for(GLint i = 0; i < 4; i++)
+    {
+        GLuint bits = (a.v[i] >= b.v[i]) ? ~0u : 0u;
+        std::memcpy(&r.v[i], &bits, sizeof(bits));
+    }
+#endif
+    return r;
+}
+
+inline Float4 Float4Less(Float4 a, Float4 b)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_cmplt_ps(a.v, b.v);
+#elif defined(SIMD_NEON)
+    r.v = vreinterpretq_f32_u32(vcltq_f32(a.v, b.v));
+#else
+    for(GLint i = 0; i < 4; i++)
+    {
+        GLuint bits = (a.v[i] < b.v[i]) ? ~0u : 0u;
+        std::memcpy(&r.v[i], &bits, sizeof(bits));
+    }
+#endif
+    return r;
+}
+
+// 掩码的与
+inline Float4 Float4And(Float4 a, Float4 b)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_and_ps(a.v, b.v);
+#elif defined(SIMD_NEON)
+    r.v = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)));
+#else
+    for(GLint i = 0; i < 4; i++)
+    {
+        GLuint x, y;
+        std::memcpy(&x, &a.v[i], sizeof(x));
+        std::memcpy(&y, &b.v[i], sizeof(y));
+        x &= y;
+        std::memcpy(&r.v[i], &x, sizeof(x));
+    }
+#endif
+    return r;
+}
+
+// mask 为 1 的分量取 a，否则取 b
+inline Float4 Float4Select(Float4 mask, Float4 a, Float4 b)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+#elif defined(SIMD_NEON)
+    r.v = vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v);
+#else
+    for(GLint i = 0; i < 4; i++)
+    {
+        GLuint bits;
+        std::memcpy(&bits, &mask.v[i], sizeof(bits));
+        r.v[i] = bits ? a.v[i] : b.v[i];
+    }
+#endif
+    return r;
+}
+
+inline Float4 Float4Abs(Float4 a)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);
+#elif defined(SIMD_NEON)
+    r.v = vabsq_f32(a.v);
+#else
+    for(GLint i = 0; i < 4; i++)
+        r.v[i] = std::fabs(a.v[i]);
+#endif
+    return r;
+}
+
+// 向零取整（|a| < 2^31）
+inline Float4 Float4Truncate(Float4 a)
+{
+    Float4 r;
+#if defined(SIMD_SSE2)
+    r.v = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+#elif defined(SIMD_NEON)
+    r.v = vcvtq_f32_s32(vcvtq_s32_f32(a.v));
+#else
+    for(GLint i = 0; i < 4; i++)
+        r.v[i] = GLfloat(GLint(a.v[i]));
+#endif
+    return r;
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef TEXTURE_ARRAY_H
+#define TEXTURE_ARRAY_H
+
+#include <vector>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/texture_loader.h>
+
+// == ======================================
+// 贴图数组 + 图集
+// 把一个模型的所有贴图放进一个 GL_TEXTURE_2D_ARRAY，整个模型只需绑定一次贴图：
+// 1. 层的尺寸取最大贴图的尺寸，与层同样大的贴图独占一层；
+// 2. 较小的贴图按行（shelf）排进图集层，四周留出复制边缘像素的填充，减少过滤时的串色；
+// 3. 每张贴图得到所在的层和层内的 UV 矩形，绘制时作为每次绘制的常量传给着色器，
+//    着色器用 rect.xy + fract(uv) * rect.zw 取样（保留 GL_REPEAT 的效果）。
+// 图集中的贴图在很低的 mip 级别仍会与相邻贴图混合，这是图集的固有限制。
+// == ======================================
+
+// 一张贴图在数组中的位置
+struct TextureSlot
+{
+    GLint layer;
+    glm::vec4 rect; // xy 为左下角，zw 为尺寸（层的 UV 空间）
+};
+
+class TextureArray
+{
+public:
+    GLuint id;
+    GLint width, height, layers;
+    std::vector<TextureSlot> slots; // 与输入图片一一对应
+
+    static const GLint PADDING = 4;
+
+    TextureArray() : id(0), width(0), height(0), layers(0) { }
+
+    // 排布并上传（必须在 OpenGL 上下文所在的线程中调用）；解码失败的图片得到一个 1x1 的白色区域。
+    // 拼好的每一层在工作线程中生成 mip 链（mipFilter 为 MIP_NONE 时由 glGenerateMipmap 生成）。
+    void Build(const std::vector<DecodedImage>& images, MipFilter mipFilter = MIP_KAISER, GLuint threadCount = 0)
+    {
+        TRACE_SCOPE("BuildTextureArray");
+        this->width = this->height = 1;
+        for(const DecodedImage& image : images)
+        {
+            this->width = std::max(this->width, image.width);
+            this->height = std::max(this->height, image.height);
+        }
+
+        // 1. 排布：颜色贴图在前、linear 贴图在后（两者不共用一层，各层的 mip 链才能分别按 sRGB 或线性滤波），
+        //    同类中按高度从大到小依次放进当前层的当前行
+        std::vector<GLuint> order(images.size());
+        for(GLuint i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](GLuint a, GLuint b)
+        {
+            if(images[a].linear != images[b].linear)
+                return images[b].linear;
+            return images[a].height > images[b].height;
+        });
+
+        this->slots.assign(images.size(), TextureSlot());
+        std::vector<glm::ivec4> placements(images.size()); // x, y, w, h（像素）
+        std::vector<GLint> paddings(images.size());
+        std::vector<bool> layerLinear;
+        GLint layer = -1, shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for(GLuint i : order)
+        {
+            GLint w = std::max(images[i].width, 1), h = std::max(images[i].height, 1);
+            bool fullLayer = (w == this->width && h == this->height);
+            GLint padding = fullLayer ? 0 : PADDING;
+            if(w + 2 * padding > this->width || h + 2 * padding > this->height)
+                padding = 0; // 放不下填充时只能紧贴边缘
+            GLint paddedW = w + 2 * padding, paddedH = h + 2 * padding;
+
+            if(layer < 0 || fullLayer || images[i].linear != layerLinear.back())
+            {
+                layer++;
+                layerLinear.push_back(images[i].linear);
+                shelfX = shelfY = shelfHeight = 0;
+            }
+            else if(shelfX + paddedW > this->width)
+            {
+                shelfY += shelfHeight;
+                shelfX = shelfHeight = 0;
+            }
+            if(shelfY + paddedH > this->height)
+            {
+                layer++;
+                layerLinear.push_back(images[i].linear);
+                shelfX = shelfY = shelfHeight = 0;
+            }
+
+            placements[i] = glm::ivec4(shelfX + padding, shelfY + padding, w, h);
+            paddings[i] = padding;
+            this->slots[i].layer = layer;
+            this->slots[i].rect = glm::vec4(GLfloat(shelfX + padding) / this->width, GLfloat(shelfY + padding) / this->height,
+                                            GLfloat(w) / this->width, GLfloat(h) / this->height);
+            shelfX += paddedW;
+            shelfHeight = std::max(shelfHeight, paddedH);
+            if(fullLayer)
+                shelfY = this->height; // 下一张贴图换层
+        }
+        this->layers = layer + 1;
+
+        // 2. 在工作线程中逐层拼好并生成 mip 链
+        std::vector<std::vector<unsigned char> > layerPixels(this->layers);
+        std::vector<std::vector<std::vector<unsigned char> > > layerMips(this->layers);
+        threadCount = WorkerCount(threadCount);
+        ParallelTasks(size_t(this->layers), threadCount, [&](size_t l)
+        {
+            std::vector<unsigned char>& pixels = layerPixels[l];
+            pixels.assign(size_t(this->width) * this->height * 3, 0);
+            for(GLuint i = 0; i < images.size(); i++)
+                if(this->slots[i].layer == GLint(l))
+                    this->blit(images[i], placements[i], paddings[i], pixels);
+            // 只有一层时把线程用在层内
+            layerMips[l] = GenerateMipChain(&pixels[0], this->width, this->height, 3, mipFilter, !layerLinear[l],
+                                           this->layers == 1 ? threadCount : 1);
+        });
+
+        // 3. 逐级逐层上传
+        glGenTextures(1, &this->id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        GLint levelCount = (mipFilter == MIP_NONE || this->layers == 0) ? 1 : GLint(layerMips[0].size()) + 1;
+        GLint w = this->width, h = this->height;
+        for(GLint level = 0; level < levelCount; level++)
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGB8, w, h, std::max(this->layers, 1), 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+            for(GLint l = 0; l < this->layers; l++)
+            {
+                const std::vector<unsigned char>& pixels = (level == 0) ? layerPixels[l] : layerMips[l][level - 1];
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, l, w, h, 1, GL_RGB, GL_UNSIGNED_BYTE, &pixels[0]);
+            }
+            w = std::max(w / 2, 1);
+            h = std::max(h / 2, 1);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        if(mipFilter == MIP_NONE)
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    void Release()
+    {
+        if(this->id)
+            glDeleteTextures(1, &this->id);
+        this->id = 0;
+    }
+
+private:
+    // 把图片复制到层中的 place 位置，并把边缘像素向外复制到填充区域
+    void blit(const DecodedImage& image, const glm::ivec4& place, GLint padding, std::vector<unsigned char>& pixels)
+    {
+        GLint x0 = place.x - padding, x1 = place.x + place.z + padding;
+        GLint y0 = place.y - padding, y1 = place.y + place.w + padding;
+        for(GLint y = y0; y < y1; y++)
+        {
+            GLint sy = std::min(std::max(y - place.y, 0), place.w - 1);
+            for(GLint x = x0; x < x1; x++)
+            {
+                GLint sx = std::min(std::max(x - place.x, 0), place.z - 1);
+                unsigned char* dst = &pixels[(size_t(y) * this->width + x) * 3];
+                if(image.width > 0)
+                {
+                    const unsigned char* src = &image.pixels[(size_t(sy) * image.width + sx) * 3];
+                    dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+                }
+                else
+                    dst[0] = dst[1] = dst[2] = 255;
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <SOIL.h>
+
+#include <learnopengl/parallel.h>
+#include <learnopengl/mipmap.h>
+#include <learnopengl/image_decoder.h>
+#include <learnopengl/trace.h>
+
+// 解码后的 RGB 图像（CPU 端，可以在任意线程中生成）
+struct DecodedImage
+{
+    std::string path;
+    GLint width, height;
+    std::vector<unsigned char> pixels;
+    std::vector<std::vector<unsigned char> > mipLevels; // CPU 生成的第 1 级及以后（为空时上传后由 GL 生成）
+    bool linear; // 不是颜色（镜面贴图等），mip 链不做 sRGB 转换
+
+    DecodedImage() : width(0), height(0), linear(false) { }
+};
+
+// 解码一张图片（与 TextureFromFile 一样按 RGB 读取）
+// PNG/JPEG 走 image_decoder.h 的快速路径，像素缓冲来自 ImagePool()，上传后用 ReleaseImage 还回去。
+inline bool DecodeImage(const std::string& path, DecodedImage& image)
+{
+    TRACE_SCOPE("DecodeImage");
+    image.path = path;
+    if(!DecodeImageFile(path, image.pixels, image.width, image.height))
+    {
+        std::cout << "ERROR::TEXTURE::LOAD_FAILED " << path << std::endl;
+        image.width = image.height = 0;
+        image.pixels.clear();
+        return false;
+    }
+    return true;
+}
+
+// 把像素缓冲还给 ImagePool()，供下一批解码复用
+inline void ReleaseImage(DecodedImage& image)
+{
+    ImagePool().Release(std::move(image.pixels));
+    image.mipLevels.clear();
+}
+
+inline void ReleaseImages(std::vector<DecodedImage>& images)
+{
+    for(DecodedImage& image : images)
+        ReleaseImage(image);
+}
+
+// 在多个线程中解码一组图片，结果与 paths 一一对应
+// 调用者负责去重；解码失败的图片 width 为 0。
+// mipFilter 不为 MIP_NONE 时，解码后在同一个任务中接着生成 mip 链。
+// linear 与 paths 一一对应（为空表示全部是颜色贴图），为 true 的图片 mip 链不做 sRGB 转换。
+inline std::vector<DecodedImage> DecodeImages(const std::vector<std::string>& paths, GLuint threadCount = 0, MipFilter mipFilter = MIP_NONE,
+                                              const std::vector<bool>& linear = std::vector<bool>())
+{
+    std::vector<DecodedImage> images(paths.size());
+    ParallelTasks(paths.size(), WorkerCount(threadCount), [&](size_t i)
+    {
+        images[i].linear = i < linear.size() && linear[i];
+        if(DecodeImage(paths[i], images[i]) && mipFilter != MIP_NONE)
+        {
+            TRACE_SCOPE("GenerateMipChain");
+            images[i].mipLevels = GenerateMipChain(&images[i].pixels[0], images[i].width, images[i].height, 3, mipFilter, !images[i].linear);
+        }
+    });
+    return images;
+}
+
+// 创建纹理并上传（必须在 OpenGL 上下文所在的线程中调用），参数与 TextureFromFile 相同
+// 有 CPU 生成的 mip 链时逐级上传，否则由 glGenerateMipmap 生成。
+inline GLuint UploadTexture(const DecodedImage& image)
+{
+    TRACE_SCOPE("UploadTexture");
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    if(image.width > 0)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB 的行长度不一定是 4 的倍数
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image.width, image.height, 0, GL_RGB, GL_UNSIGNED_BYTE, &image.pixels[0]);
+        if(image.mipLevels.empty())
+            glGenerateMipmap(GL_TEXTURE_2D);
+        GLint w = image.width, h = image.height;
+        for(GLuint level = 0; level < image.mipLevels.size(); level++)
+        {
+            w = std::max(w / 2, 1);
+            h = std::max(h / 2, 1);
+            glTexImage2D(GL_TEXTURE_2D, level + 1, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, &image.mipLevels[level][0]);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return textureID;
+}
+
+#endif
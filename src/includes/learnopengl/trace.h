@@ -0,0 +1,254 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <GL/glew.h>
+
+// == ======================================
+// 轻量的事件追踪
+// 启动阶段（glfwInit、glewInit、着色器编译、模型和贴图载入）和每帧的各段都可以用
+// TRACE_SCOPE("名字") 标记，结束后用 WriteChromeTrace 导出 Chrome trace_event JSON，
+// 在 chrome://tracing 或 Perfetto 中查看。
+// 1. 每个线程写自己的缓冲（按块增长，只有本线程写入），记录时不加锁；
+// 2. 缓冲挂在一个无锁链表上，线程结束后缓冲留给之后的新线程复用，
+//    ParallelTasks 每次新建的工作线程不会让缓冲和线程号无限增长；
+// 3. 没有调用 StartTracing 时 TRACE_SCOPE 只读一个原子变量。
+// 事件名必须是字符串字面量（只保存指针）。
+// == ======================================
+
+namespace trace_detail
+{
+    struct Event
+    {
+        const char* name;
+        GLuint64 timestamp; // 微秒，相对于进程内第一次取时间
+        char phase;         // 'B' 开始，'E' 结束
+    };
+
+    const GLuint CHUNK_EVENTS = 256;
+
+    struct Chunk
+    {
+        Event events[CHUNK_EVENTS];
+        std::atomic<Chunk*> next;
+
+        Chunk() : next(nullptr) { }
+    };
+
+    // 一个线程的缓冲：只有拥有它的线程写入，count 以 release 发布，导出时以 acquire 读取
+    struct ThreadBuffer
+    {
+        GLuint id;
+        std::atomic<const char*> name;
+        std::atomic<bool> owned;
+        std::atomic<size_t> count;
+        Chunk* first;
+        Chunk* last;
+        std::atomic<ThreadBuffer*> next;
+
+        ThreadBuffer(GLuint id) : id(id), name(nullptr), owned(true), count(0), first(new Chunk()), next(nullptr)
+        {
+            this->last = this->first;
+        }
+
+        void Push(const char* eventName, GLuint64 timestamp, char phase)
+        {
+            size_t index = this->count.load(std::memory_order_relaxed);
+            if(index > 0 && index % CHUNK_EVENTS == 0)
+            {
+                Chunk* chunk = new Chunk();
+                this->last->next.store(chunk, std::memory_order_release);
+                this->last = chunk;
+            }
+            Event& event = this->last->events[index % CHUNK_EVENTS];
+            event.name = eventName;
+            event.timestamp = timestamp;
+            event.phase = phase;
+            this->count.store(index + 1, std::memory_order_release);
+        }
+    };
+
+    struct State
+    {
+        std::atomic<bool> enabled;
+        std::atomic<ThreadBuffer*> buffers;
+        std::atomic<GLuint> nextId;
+
+        State() : enabled(false), buffers(nullptr), nextId(1) { }
+    };
+
+    inline State& GlobalState()
+    {
+        static State state;
+        return state;
+    }
+
+    inline GLuint64 Now()
+    {
+        static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        return GLuint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // 领取一个没有线程占用的缓冲，没有时新建并挂到链表头
+    inline ThreadBuffer* AcquireBuffer()
+    {
+        State& state = GlobalState();
+        for(ThreadBuffer* buffer = state.buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next.load(std::memory_order_acquire))
+        {
+            bool expected = false;
+            if(buffer->owned.compare_exchange_strong(expected, true))
+                return buffer;
+        }
+        ThreadBuffer* buffer = new ThreadBuffer(state.nextId.fetch_add(1));
+        ThreadBuffer* head = state.buffers.load(std::memory_order_relaxed);
+        do
+            buffer->next.store(head, std::memory_order_relaxed);
+        while(!state.buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+        return buffer;
+    }
+
+    // 线程结束时归还缓冲（事件保留，新线程接着往后写）
+    struct ThreadHandle
+    {
+        ThreadBuffer* buffer;
+
+        ThreadHandle() : buffer(nullptr) { }
+
+        ~ThreadHandle()
+        {
+            if(this->buffer)
+            {
+                this->buffer->name = nullptr;
+                this->buffer->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    inline ThreadBuffer* CurrentBuffer()
+    {
+        static thread_local ThreadHandle handle;
+        if(!handle.buffer)
+            handle.buffer = AcquireBuffer();
+        return handle.buffer;
+    }
+
+    inline void WriteEscaped(std::ostream& out, const char* text)
+    {
+        for(const char* c = text; *c; c++)
+        {
+            if(*c == '"' || *c == '\\')
+                out << '\\';
+            out << *c;
+        }
+    }
+}
+
+inline bool TracingEnabled()
+{
+    return trace_detail::GlobalState().enabled.load(std::memory_order_relaxed);
+}
+
+inline void StartTracing()
+{
+    trace_detail::Now(); // 固定时间起点
+    trace_detail::GlobalState().enabled.store(true);
+}
+
+inline void StopTracing()
+{
+    trace_detail::GlobalState().enabled.store(false);
+}
+
+inline void TraceBegin(const char* name)
+{
+    if(TracingEnabled())
+        trace_detail::CurrentBuffer()->Push(name, trace_detail::Now(), 'B');
+}
+
+inline void TraceEnd(const char* name)
+{
+    if(TracingEnabled())
+        trace_detail::CurrentBuffer()->Push(name, trace_detail::Now(), 'E');
+}
+
+// 给当前线程命名（显示在 Chrome 的线程列表中），name 必须是字符串字面量
+inline void TraceThreadName(const char* name)
+{
+    if(TracingEnabled())
+        trace_detail::CurrentBuffer()->name = name;
+}
+
+// 作用域：构造时开始，析构时结束。开始时没有启用追踪的作用域不会记录结束事件，保证配对
+class TraceScope
+{
+public:
+    TraceScope(const char* name) : name(TracingEnabled() ? name : nullptr)
+    {
+        if(this->name)
+            trace_detail::CurrentBuffer()->Push(this->name, trace_detail::Now(), 'B');
+    }
+
+    ~TraceScope()
+    {
+        if(this->name)
+            trace_detail::CurrentBuffer()->Push(this->name, trace_detail::Now(), 'E');
+    }
+
+private:
+    const char* name;
+
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+// 导出 Chrome trace_event JSON。可以在其他线程仍在记录时调用，只导出已经发布的事件
+inline bool WriteChromeTrace(const std::string& path)
+{
+    using namespace trace_detail;
+    std::ofstream out(path.c_str());
+    if(!out)
+    {
+        std::cout << "ERROR::TRACE:: cannot write " << path << std::endl;
+        return false;
+    }
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for(ThreadBuffer* buffer = GlobalState().buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next.load(std::memory_order_acquire))
+    {
+        const char* threadName = buffer->name.load();
+        if(threadName)
+        {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"args\":{\"name\":\"";
+            WriteEscaped(out, threadName);
+            out << "\"}}";
+            first = false;
+        }
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        const Chunk* chunk = buffer->first;
+        for(size_t i = 0; i < count; i++)
+        {
+            if(i > 0 && i % CHUNK_EVENTS == 0)
+                chunk = chunk->next.load(std::memory_order_acquire);
+            const Event& event = chunk->events[i % CHUNK_EVENTS];
+            out << (first ? "" : ",") << "\n{\"name\":\"";
+            WriteEscaped(out, event.name);
+            out << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp << ",\"pid\":1,\"tid\":" << buffer->id << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return bool(out);
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef VERTEX_PACKING_H
+#define VERTEX_PACKING_H
+
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/mesh.h>
+
+// == ======================================
+// 压缩顶点格式（16 字节，Vertex 为 32 字节）
+// 1. 位置：相对网格包围盒的 16 位定点数，着色器中用 positionMin + p * positionScale 还原；
+// 2. 法线：八面体编码，2 个 16 位有符号归一化数；
+// 3. 纹理坐标：半精度浮点。
+// 着色器侧的解码见 multiple_lights.vs / shader.vs 中的 PACKED_VERTICES 分支。
+// == ======================================
+struct PackedVertex
+{
+    GLushort Position[4];  // xyz + 填充（保持 4 字节对齐）
+    GLshort  Normal[2];
+    GLushort TexCoords[2];
+};
+
+// 位置的还原参数：position = min + quantized * scale，quantized ∈ [0, 1]
+struct PackedBounds
+{
+    glm::vec3 min;
+    glm::vec3 scale;
+};
+
+// 单精度转半精度（就近舍入到偶数，超出范围为无穷大）
+inline GLushort FloatToHalf(GLfloat value)
+{
+    GLuint bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    GLuint sign = (bits >> 16) & 0x8000;
+    GLuint rawExponent = (bits >> 23) & 0xFF;
+    GLuint mantissa = bits & 0x7FFFFF;
+    if(rawExponent == 0xFF)
+        return GLushort(sign | 0x7C00 | (mantissa ? 0x200 : 0)); // Inf / NaN
+    GLint exponent = GLint(rawExponent) - 127 + 15;
+    if(exponent >= 31)
+        return GLushort(sign | 0x7C00);
+    if(exponent <= 0)
+    {
+        // 非规格化数
+        if(exponent < -10)
+            return GLushort(sign);
+        mantissa |= 0x800000;
+        GLuint shift = GLuint(14 - exponent);
+        GLuint half = mantissa >> shift;
+        GLuint rest = mantissa & ((1u << shift) - 1), middle = 1u << (shift - 1);
+        if(rest > middle || (rest == middle && (half & 1)))
+            half++;
+        return GLushort(sign | half);
+    }
+    GLuint half = (GLuint(exponent) << 10) | (mantissa >> 13);
+    GLuint rest = mantissa & 0x1FFF;
+    if(rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+        half++; // 进位会正确地进入指数
+    return GLushort(sign | half);
+}
+
+inline GLshort PackSnorm16(GLfloat value)
+{
+    return GLshort(std::floor(std::min(std::max(value, -1.0f), 1.0f) * 32767.0f + 0.5f));
+}
+
+// 八面体编码：把单位球投影到八面体再展开到 [-1, 1]^2
+inline glm::vec2 OctEncode(const glm::vec3& normal)
+{
+    GLfloat sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if(sum <= 0.0f)
+        return glm::vec2(0.0f, 0.0f); // 零法线解码为 (0, 0, 1)
+    glm::vec2 p(normal.x / sum, normal.y / sum);
+    if(normal.z < 0.0f)
+    {
+        glm::vec2 folded((1.0f - std::fabs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                         (1.0f - std::fabs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+        p = folded;
+    }
+    return p;
+}
+
+inline PackedBounds ComputePackedBounds(const Vertex* vertices, size_t count)
+{
+    glm::vec3 minPos(0.0f), maxPos(0.0f);
+    if(count > 0)
+        minPos = maxPos = vertices[0].Position;
+    for(size_t i = 1; i < count; i++)
+    {
+        minPos = glm::min(minPos, vertices[i].Position);
+        maxPos = glm::max(maxPos, vertices[i].Position);
+    }
+    PackedBounds bounds;
+    bounds.min = minPos;
+    bounds.scale = maxPos - minPos;
+    return bounds;
+}
+
+inline PackedVertex PackVertex(const Vertex& vertex, const PackedBounds& bounds)
+{
+    PackedVertex packed;
+    for(GLuint i = 0; i < 3; i++)
+    {
+        GLfloat t = (bounds.scale[i] > 0.0f) ? (vertex.Position[i] - bounds.min[i]) / bounds.scale[i] : 0.0f;
+        packed.Position[i] = GLushort(std::floor(std::min(std::max(t, 0.0f), 1.0f) * 65535.0f + 0.5f));
+    }
+    packed.Position[3] = 0;
+    glm::vec2 octahedral = OctEncode(vertex.Normal);
+    packed.Normal[0] = PackSnorm16(octahedral.x);
+    packed.Normal[1] = PackSnorm16(octahedral.y);
+    packed.TexCoords[0] = FloatToHalf(vertex.TexCoords.x);
+    packed.TexCoords[1] = FloatToHalf(vertex.TexCoords.y);
+    return packed;
+}
+
+// 按 vertices 自身的包围盒压缩，追加到 out，返回还原参数
+inline PackedBounds PackVertices(const Vertex* vertices, size_t count, std::vector<PackedVertex>& out)
+{
+    PackedBounds bounds = ComputePackedBounds(vertices, count);
+    out.reserve(out.size() + count);
+    for(size_t i = 0; i < count; i++)
+        out.push_back(PackVertex(vertices[i], bounds));
+    return bounds;
+}
+
+// 把教程中常用的交错数组（位置 3 + 法线 3 + 纹理坐标 2）转换成 Vertex
+inline std::vector<Vertex> VerticesFromInterleaved(const GLfloat* data, size_t count)
+{
+    std::vector<Vertex> vertices(count);
+    for(size_t i = 0; i < count; i++, data += 8)
+    {
+        vertices[i].Position  = glm::vec3(data[0], data[1], data[2]);
+        vertices[i].Normal    = glm::vec3(data[3], data[4], data[5]);
+        vertices[i].TexCoords = glm::vec2(data[6], data[7]);
+    }
+    return vertices;
+}
+
+// 为当前绑定的 VBO 设置压缩格式的顶点属性（位置 0、1、2 与 Vertex 相同）
+inline void SetupPackedAttributes()
+{
+    // 位置：无符号归一化，着色器中得到 [0, 1]
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, Position));
+    // 法线：有符号归一化的八面体坐标
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, Normal));
+    // 纹理坐标：半精度浮点
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, TexCoords));
+}
+
+// 只有位置属性（深度预渲染、阴影等只需要位置的绘制，少取 3/4 的顶点数据）
+inline void SetupPackedPositionAttribute()
+{
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, Position));
+}
+
+// 上传位置的还原参数（着色器中的 positionMin / positionScale）
+inline void SetPackedBounds(GLuint program, const PackedBounds& bounds)
+{
+    glUniform3f(glGetUniformLocation(program, "positionMin"), bounds.min.x, bounds.min.y, bounds.min.z);
+    glUniform3f(glGetUniformLocation(program, "positionScale"), bounds.scale.x, bounds.scale.y, bounds.scale.z);
+}
+
+#endif
@@ -0,0 +1,677 @@
+#ifndef VIRTUAL_TEXTURE_H
+#define VIRTUAL_TEXTURE_H
+
+#include <list>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <zstd.h>
+
+#include <learnopengl/asset_pack.h>
+#include <learnopengl/texture_loader.h>
+
+// == ======================================
+// 虚拟纹理
+// 贴图原本整张、以最高分辨率载入，看不见或者离得很远的部分也占着显存。
+// 1. 烘焙：把贴图的每个 mip 级别切成 TileSize x TileSize 的瓦片（四周带 Border 像素的边，双线性过滤不串色），
+//    每块单独 zstd 压缩，写成 .vtex 文件；运行时只映射这个文件，不再解码整张图；
+// 2. 反馈：场景先用反馈着色器画到一个很小的离屏目标（输出尺寸 / FeedbackDivisor），
+//    每个像素写出需要的瓦片（x, y, 级别），异步读回（两个 PBO 轮流，隔一帧再映射，不等 GPU）；
+// 3. 调度：去重后先载入粗的级别；瓦片先查 CPU 瓦片缓存（按字节数的 LRU），没有再从文件解压，
+//    上传到物理缓存贴图（固定 slotsPerSide² 个槽位，最久没用的槽位被替换），每帧最多上传 MaxUploadsPerFrame 块；
+// 4. 页表：每个级别一张小图，每个瓦片一个像素（槽位 x、y、实际驻留的级别）。
+//    没有驻留的瓦片指向最近的驻留祖先，最粗的一块常驻，所以总能取到颜色，只是暂时模糊一些。
+// 显存只有物理缓存和页表，与原贴图的大小无关；CPU 端只有瓦片缓存。
+// 虚拟空间的第 L 级严格是第 0 级的 1/2^L（不按 GL 的向下取整），瓦片的祖先就是坐标右移一位。
+// 文件按小端序存储，和编译器的结构体布局一致（见 static_assert）。
+// == ======================================
+
+const char VIRTUAL_TEXTURE_MAGIC[4] = { 'L', 'V', 'T', 'X' };
+const GLuint VIRTUAL_TEXTURE_VERSION = 1;
+const GLuint VIRTUAL_TILE_NONE = 0xFFFFFFFFu; // 空槽位
+
+struct VirtualTextureHeader
+{
+    char magic[4];
+    GLuint version;
+    GLuint width, height;    // 第 0 级的尺寸（像素）
+    GLuint tileSize, border; // 瓦片内容尺寸、每边的边宽
+    GLuint levels;           // 最后一级只有一块
+    GLuint tileCount;
+    GLuint64 sourceHash;     // 烘焙时原图文件内容的哈希
+};
+
+// 瓦片目录，按级别、行、列排列
+struct VirtualTileEntry
+{
+    GLuint64 offset;
+    GLuint size;  // 压缩后的字节数
+    GLuint flags; // ASSET_ZSTD 表示压缩过
+};
+
+static_assert(sizeof(VirtualTextureHeader) == 40 && sizeof(VirtualTileEntry) == 16, "virtual texture layout");
+
+namespace vt_detail
+{
+    inline GLuint TilesAt(GLuint size, GLuint tileSize, GLuint level)
+    {
+        GLuint64 span = GLuint64(tileSize) << level;
+        return std::max(1u, GLuint((size + span - 1) / span));
+    }
+
+    inline GLuint64 HashBytes(const char* data, size_t size)
+    {
+        GLuint64 hash = 14695981039346656037ull;
+        for(size_t i = 0; i < size; i++)
+        {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // 级别内的瓦片编号：级别 8 位，行列各 12 位
+    inline GLuint TileKey(GLuint level, GLuint x, GLuint y)
+    {
+        return (level << 24) | (y << 12) | x;
+    }
+
+    inline GLuint KeyLevel(GLuint key) { return key >> 24; }
+    inline GLuint KeyY(GLuint key)     { return (key >> 12) & 0xFFF; }
+    inline GLuint KeyX(GLuint key)     { return key & 0xFFF; }
+}
+
+// 烘焙：解码原图、生成 mip 链、切瓦片、压缩写出
+inline bool CookVirtualTexture(const std::string& imagePath, const std::string& cookedPath, GLuint tileSize = 128, GLuint border = 4)
+{
+    using namespace vt_detail;
+    AssetFile source;
+    DecodedImage image;
+    if(!source.Open(imagePath) || !DecodeImage(imagePath, image))
+        return false;
+
+    std::vector<std::vector<unsigned char> > mips = GenerateMipChain(&image.pixels[0], image.width, image.height, 3, MIP_KAISER);
+    VirtualTextureHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, VIRTUAL_TEXTURE_MAGIC, 4);
+    header.version = VIRTUAL_TEXTURE_VERSION;
+    header.width = image.width;
+    header.height = image.height;
+    header.tileSize = tileSize;
+    header.border = border;
+    header.sourceHash = HashBytes(source.Data(), source.Size());
+    header.levels = 1;
+    while(TilesAt(header.width, tileSize, header.levels - 1) > 1 || TilesAt(header.height, tileSize, header.levels - 1) > 1)
+        header.levels++;
+    // 反馈目标用 RGBA8 记录瓦片坐标，每个方向最多 256 块
+    if(TilesAt(header.width, tileSize, 0) > 256 || TilesAt(header.height, tileSize, 0) > 256)
+    {
+        std::cout << "ERROR::VIRTUAL_TEXTURE:: image too large for tile size " << tileSize << std::endl;
+        return false;
+    }
+
+    std::vector<VirtualTileEntry> entries;
+    std::vector<char> data;
+    GLuint slotSize = tileSize + 2 * border;
+    std::vector<unsigned char> tile(size_t(slotSize) * slotSize * 3);
+    std::vector<char> packed(ZSTD_compressBound(tile.size()));
+    for(GLuint level = 0; level < header.levels; level++)
+    {
+        // 虚拟空间中本级的尺寸是 width / 2^level，按比例从 GL 的 mip 级别（向下取整的尺寸）中双线性取样
+        GLint mipLevel = std::min<GLint>(level, GLint(mips.size()));
+        GLint w = std::max(image.width >> mipLevel, 1), h = std::max(image.height >> mipLevel, 1);
+        const unsigned char* pixels = mipLevel == 0 ? &image.pixels[0] : &mips[mipLevel - 1][0];
+        GLfloat scaleX = GLfloat(w) * GLfloat(1u << level) / image.width, scaleY = GLfloat(h) * GLfloat(1u << level) / image.height;
+        GLuint tilesX = TilesAt(header.width, tileSize, level), tilesY = TilesAt(header.height, tileSize, level);
+        for(GLuint ty = 0; ty < tilesY; ty++)
+            for(GLuint tx = 0; tx < tilesX; tx++)
+            {
+                for(GLuint j = 0; j < slotSize; j++)
+                    for(GLuint i = 0; i < slotSize; i++)
+                    {
+                        GLfloat fx = (GLfloat(tx * tileSize + i) - border + 0.5f) * scaleX - 0.5f;
+                        GLfloat fy = (GLfloat(ty * tileSize + j) - border + 0.5f) * scaleY - 0.5f;
+                        fx = std::min(std::max(fx, 0.0f), GLfloat(w - 1));
+                        fy = std::min(std::max(fy, 0.0f), GLfloat(h - 1));
+                        GLint x0 = GLint(fx), y0 = GLint(fy);
+                        GLint x1 = std::min(x0 + 1, w - 1), y1 = std::min(y0 + 1, h - 1);
+                        GLfloat ax = fx - x0, ay = fy - y0;
+                        for(GLint c = 0; c < 3; c++)
+                        {
+                            GLfloat top = pixels[(size_t(y0) * w + x0) * 3 + c] * (1.0f - ax) + pixels[(size_t(y0) * w + x1) * 3 + c] * ax;
+                            GLfloat bottom = pixels[(size_t(y1) * w + x0) * 3 + c] * (1.0f - ax) + pixels[(size_t(y1) * w + x1) * 3 + c] * ax;
+                            tile[(size_t(j) * slotSize + i) * 3 + c] = (unsigned char)(top * (1.0f - ay) + bottom * ay + 0.5f);
+                        }
+                    }
+
+                VirtualTileEntry entry = { GLuint64(data.size()), 0, 0 };
+                size_t packedSize = ZSTD_compress(packed.data(), packed.size(), tile.data(), tile.size(), 3);
+                if(!ZSTD_isError(packedSize) && packedSize < tile.size())
+                {
+                    data.insert(data.end(), packed.begin(), packed.begin() + packedSize);
+                    entry.flags = ASSET_ZSTD;
+                }
+                else
+                    data.insert(data.end(), tile.begin(), tile.end());
+                entry.size = GLuint(data.size() - entry.offset);
+                entries.push_back(entry);
+            }
+    }
+    ReleaseImage(image);
+
+    header.tileCount = GLuint(entries.size());
+    GLuint64 base = sizeof(header) + entries.size() * sizeof(VirtualTileEntry);
+    for(VirtualTileEntry& entry : entries)
+        entry.offset += base;
+    std::ofstream out(cookedPath.c_str(), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(VirtualTileEntry));
+    out.write(data.data(), data.size());
+    if(!out)
+    {
+        std::cout << "ERROR::VIRTUAL_TEXTURE:: cannot write " << cookedPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 映射后的 .vtex 文件
+class VirtualTextureFile
+{
+public:
+    VirtualTextureFile() : header(nullptr), entries(nullptr) { }
+
+    bool Open(const std::string& path)
+    {
+        this->Close();
+        if(!this->file.Open(path))
+            return false;
+        const VirtualTextureHeader* h = reinterpret_cast<const VirtualTextureHeader*>(this->file.Data());
+        size_t size = this->file.Size();
+        if(size < sizeof(VirtualTextureHeader) || std::memcmp(h->magic, VIRTUAL_TEXTURE_MAGIC, 4) != 0 ||
+           h->version != VIRTUAL_TEXTURE_VERSION || h->tileSize == 0 ||
+           GLuint64(h->tileCount) * sizeof(VirtualTileEntry) > size - sizeof(VirtualTextureHeader))
+        {
+            std::cout << "ERROR::VIRTUAL_TEXTURE:: invalid file " << path << std::endl;
+            return false;
+        }
+        this->entries = reinterpret_cast<const VirtualTileEntry*>(this->file.Data() + sizeof(VirtualTextureHeader));
+        for(GLuint i = 0; i < h->tileCount; i++)
+            if(this->entries[i].offset > size || this->entries[i].size > size - this->entries[i].offset)
+            {
+                std::cout << "ERROR::VIRTUAL_TEXTURE:: truncated file " << path << std::endl;
+                return false;
+            }
+        this->header = h;
+        this->levelStart.assign(1, 0);
+        for(GLuint level = 0; level < h->levels; level++)
+            this->levelStart.push_back(this->levelStart.back() + this->TilesX(level) * this->TilesY(level));
+        if(this->levelStart.back() != h->tileCount)
+        {
+            this->header = nullptr;
+            std::cout << "ERROR::VIRTUAL_TEXTURE:: invalid file " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void Close()
+    {
+        this->header = nullptr;
+        this->entries = nullptr;
+        this->levelStart.clear();
+        this->file.Close();
+    }
+
+    bool Valid() const { return this->header != nullptr; }
+    const VirtualTextureHeader& Header() const { return *this->header; }
+    GLuint TilesX(GLuint level) const { return vt_detail::TilesAt(this->header->width, this->header->tileSize, level); }
+    GLuint TilesY(GLuint level) const { return vt_detail::TilesAt(this->header->height, this->header->tileSize, level); }
+    GLuint SlotSize() const { return this->header->tileSize + 2 * this->header->border; }
+
+    // 读出一块瓦片的 RGB 像素（SlotSize² x 3 字节）
+    bool ReadTile(GLuint level, GLuint x, GLuint y, std::vector<unsigned char>& pixels) const
+    {
+        const VirtualTileEntry& entry = this->entries[this->levelStart[level] + y * this->TilesX(level) + x];
+        const char* data = this->file.Data() + entry.offset;
+        pixels.resize(size_t(this->SlotSize()) * this->SlotSize() * 3);
+        if(!(entry.flags & ASSET_ZSTD))
+        {
+            if(entry.size != pixels.size())
+                return false;
+            std::memcpy(pixels.data(), data, pixels.size());
+            return true;
+        }
+        size_t result = ZSTD_decompress(pixels.data(), pixels.size(), data, entry.size);
+        return !ZSTD_isError(result) && result == pixels.size();
+    }
+
+private:
+    VirtualTextureFile(const VirtualTextureFile&);
+    VirtualTextureFile& operator=(const VirtualTextureFile&);
+
+    AssetFile file;
+    const VirtualTextureHeader* header;
+    const VirtualTileEntry* entries;
+    std::vector<GLuint> levelStart;
+};
+
+// 打开贴图对应的 .vtex：不存在、损坏或原图已改变时重新烘焙
+inline bool OpenVirtualTexture(const std::string& imagePath, const std::string& cookedPath, VirtualTextureFile& file,
+                               GLuint tileSize = 128, GLuint border = 4)
+{
+    AssetFile source;
+    GLuint64 hash = source.Open(imagePath) ? vt_detail::HashBytes(source.Data(), source.Size()) : 0;
+    source.Close();
+    if(file.Open(cookedPath) && (hash == 0 || file.Header().sourceHash == hash))
+        return true;
+    file.Close();
+    return CookVirtualTexture(imagePath, cookedPath, tileSize, border) && file.Open(cookedPath);
+}
+
+// CPU 瓦片缓存：按字节数限制大小，最久没用的先淘汰
+class VirtualTileCache
+{
+public:
+    VirtualTileCache(size_t capacityBytes) : capacity(capacityBytes), bytes(0), hits(0), misses(0) { }
+
+    // 找到时移到最近使用的位置
+    const std::vector<unsigned char>* Find(GLuint key)
+    {
+        std::unordered_map<GLuint, std::list<Item>::iterator>::iterator found = this->index.find(key);
+        if(found == this->index.end())
+        {
+            this->misses++;
+            return nullptr;
+        }
+        this->hits++;
+        this->items.splice(this->items.begin(), this->items, found->second);
+        return &found->second->pixels;
+    }
+
+    const std::vector<unsigned char>& Insert(GLuint key, std::vector<unsigned char>& pixels)
+    {
+        this->bytes += pixels.size();
+        this->items.push_front(Item());
+        this->items.front().key = key;
+        this->items.front().pixels.swap(pixels);
+        this->index[key] = this->items.begin();
+        while(this->bytes > this->capacity && this->items.size() > 1)
+        {
+            this->bytes -= this->items.back().pixels.size();
+            this->index.erase(this->items.back().key);
+            this->items.pop_back();
+        }
+        return this->items.front().pixels;
+    }
+
+    size_t Bytes() const { return this->bytes; }
+    GLuint64 Hits() const { return this->hits; }
+    GLuint64 Misses() const { return this->misses; }
+
+private:
+    struct Item
+    {
+        GLuint key;
+        std::vector<unsigned char> pixels;
+    };
+
+    size_t capacity, bytes;
+    GLuint64 hits, misses;
+    std::list<Item> items; // 前面是最近用过的
+    std::unordered_map<GLuint, std::list<Item>::iterator> index;
+};
+
+// 一张虚拟纹理的 GPU 部分：物理缓存、页表、反馈目标
+class VirtualTexture
+{
+public:
+    GLuint MaxUploadsPerFrame;
+    GLuint FeedbackDivisor;
+
+    // slotsPerSide² 个物理槽位；cpuCacheBytes 为 CPU 瓦片缓存的大小
+    VirtualTexture(const VirtualTextureFile& file, GLuint outputWidth, GLuint outputHeight,
+                   GLuint slotsPerSide = 8, size_t cpuCacheBytes = 32u << 20, GLuint feedbackDivisor = 8)
+        : MaxUploadsPerFrame(8), FeedbackDivisor(feedbackDivisor), file(file), cpuCache(cpuCacheBytes),
+          slotsPerSide(slotsPerSide), frame(0), readIndex(0), uploads(0), evictions(0), pageTableDirty(true)
+    {
+        const VirtualTextureHeader& header = file.Header();
+        this->levels = header.levels;
+        GLuint slotSize = file.SlotSize();
+
+        // 物理缓存：RGB8，不带 mip（级别由页表选择），双线性过滤
+        glGenTextures(1, &this->physicalTexture);
+        glBindTexture(GL_TEXTURE_2D, this->physicalTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, slotsPerSide * slotSize, slotsPerSide * slotSize, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        this->slotKeys.assign(slotsPerSide * slotsPerSide, VIRTUAL_TILE_NONE);
+        this->slotUsed.assign(slotsPerSide * slotsPerSide, 0);
+
+        // 页表：每个级别一层 mip，第 0 级取 2 的幂，保证第 L 级的尺寸不小于本级的瓦片数
+        GLuint tableW = 1, tableH = 1;
+        while(tableW < file.TilesX(0)) tableW *= 2;
+        while(tableH < file.TilesY(0)) tableH *= 2;
+        glGenTextures(1, &this->pageTable);
+        glBindTexture(GL_TEXTURE_2D, this->pageTable);
+        for(GLuint level = 0; level < this->levels; level++)
+        {
+            GLuint w = std::max(tableW >> level, 1u), h = std::max(tableH >> level, 1u);
+            this->tableSize.push_back(glm::ivec2(w, h));
+            this->table.push_back(std::vector<GLuint>(size_t(w) * h, 0));
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, this->levels - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // 反馈目标和读回用的 PBO
+        this->feedbackWidth = std::max(1u, outputWidth / feedbackDivisor);
+        this->feedbackHeight = std::max(1u, outputHeight / feedbackDivisor);
+        glGenTextures(1, &this->feedbackColor);
+        glBindTexture(GL_TEXTURE_2D, this->feedbackColor);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, this->feedbackWidth, this->feedbackHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &this->feedbackDepth);
+        glBindRenderbuffer(GL_RENDERBUFFER, this->feedbackDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, this->feedbackWidth, this->feedbackHeight);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &this->feedbackFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->feedbackFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->feedbackColor, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->feedbackDepth);
+        if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::VIRTUAL_TEXTURE::FRAMEBUFFER_INCOMPLETE" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glGenBuffers(PBO_COUNT, this->pbo);
+        for(GLuint i = 0; i < PBO_COUNT; i++)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, this->feedbackWidth * this->feedbackHeight * 4, NULL, GL_STREAM_READ);
+            this->pboPending[i] = false;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // 最粗的一块常驻（没有驻留的瓦片最终都回退到它）
+        this->load(vt_detail::TileKey(this->levels - 1, 0, 0));
+        this->updatePageTable();
+    }
+
+    ~VirtualTexture()
+    {
+        glDeleteBuffers(PBO_COUNT, this->pbo);
+        glDeleteFramebuffers(1, &this->feedbackFBO);
+        glDeleteRenderbuffers(1, &this->feedbackDepth);
+        glDeleteTextures(1, &this->feedbackColor);
+        glDeleteTextures(1, &this->pageTable);
+        glDeleteTextures(1, &this->physicalTexture);
+    }
+
+    // 反馈着色器的 uniform 与采样着色器相同，另加 feedbackBias（反馈目标更小，级别要减去 log2(FeedbackDivisor)）
+    void SetUniforms(GLuint program, GLint pageTableUnit, GLint physicalUnit) const
+    {
+        const VirtualTextureHeader& header = this->file.Header();
+        GLuint physicalSize = this->slotsPerSide * this->file.SlotSize();
+        glActiveTexture(GL_TEXTURE0 + pageTableUnit);
+        glBindTexture(GL_TEXTURE_2D, this->pageTable);
+        glActiveTexture(GL_TEXTURE0 + physicalUnit);
+        glBindTexture(GL_TEXTURE_2D, this->physicalTexture);
+        glUniform1i(glGetUniformLocation(program, "pageTable"), pageTableUnit);
+        glUniform1i(glGetUniformLocation(program, "physicalCache"), physicalUnit);
+        glUniform2f(glGetUniformLocation(program, "virtualSize"), GLfloat(header.width), GLfloat(header.height));
+        glUniform1f(glGetUniformLocation(program, "tileSize"), GLfloat(header.tileSize));
+        glUniform1f(glGetUniformLocation(program, "tileBorder"), GLfloat(header.border));
+        glUniform1f(glGetUniformLocation(program, "physicalSize"), GLfloat(physicalSize));
+        glUniform1f(glGetUniformLocation(program, "maxLevel"), GLfloat(this->levels - 1));
+        glUniform1f(glGetUniformLocation(program, "feedbackBias"), -std::log2(GLfloat(this->FeedbackDivisor)));
+    }
+
+    // 反馈：在 BeginFeedback/EndFeedback 之间用反馈着色器画一遍场景
+    void BeginFeedback()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, this->feedbackFBO);
+        glGetIntegerv(GL_VIEWPORT, this->savedViewport);
+        glViewport(0, 0, this->feedbackWidth, this->feedbackHeight);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // alpha 为 0 表示没有请求
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    void EndFeedback()
+    {
+        // 读回到 PBO，不等待；两个 PBO 都有数据后 Update 才映射较早的一个
+        GLuint index = (this->readIndex + this->pendingCount()) % PBO_COUNT;
+        if(!this->pboPending[index])
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pbo[index]);
+            glReadPixels(0, 0, this->feedbackWidth, this->feedbackHeight, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            this->pboPending[index] = true;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(this->savedViewport[0], this->savedViewport[1], this->savedViewport[2], this->savedViewport[3]);
+    }
+
+    // 处理最早的一份反馈：标记用到的瓦片，载入缺少的瓦片，更新页表
+    // 会改变当前绑定的纹理，在 SetUniforms 之前调用
+    void Update()
+    {
+        this->frame++;
+        if(this->pendingCount() == PBO_COUNT)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pbo[this->readIndex]);
+            const unsigned char* pixels = static_cast<const unsigned char*>(
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, this->feedbackWidth * this->feedbackHeight * 4, GL_MAP_READ_BIT));
+            if(pixels)
+                this->collectRequests(pixels, this->feedbackWidth * this->feedbackHeight);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            this->pboPending[this->readIndex] = false;
+            this->readIndex = (this->readIndex + 1) % PBO_COUNT;
+            this->streamRequests();
+        }
+        if(this->pageTableDirty)
+            this->updatePageTable();
+    }
+
+    GLuint ResidentTiles() const { return GLuint(this->resident.size()); }
+    GLuint PendingTiles() const { return GLuint(this->missing.size()); }
+    GLuint64 Uploads() const { return this->uploads; }
+    GLuint64 Evictions() const { return this->evictions; }
+    const VirtualTileCache& CpuCache() const { return this->cpuCache; }
+    // 显存占用：物理缓存 + 页表（与原贴图的尺寸无关）
+    size_t GpuBytes() const
+    {
+        size_t physical = this->slotsPerSide * this->file.SlotSize();
+        size_t bytes = physical * physical * 3;
+        for(const glm::ivec2& size : this->tableSize)
+            bytes += size_t(size.x) * size.y * 4;
+        return bytes;
+    }
+
+private:
+    static const GLuint PBO_COUNT = 2;
+
+    VirtualTexture(const VirtualTexture&);
+    VirtualTexture& operator=(const VirtualTexture&);
+
+    const VirtualTextureFile& file;
+    VirtualTileCache cpuCache;
+    GLuint levels, slotsPerSide;
+    GLuint physicalTexture, pageTable;
+    std::vector<glm::ivec2> tableSize;
+    std::vector<std::vector<GLuint> > table; // 每级的页表像素（RGBA8 打包）
+
+    std::vector<GLuint> slotKeys;   // 槽位中的瓦片
+    std::vector<GLuint64> slotUsed; // 槽位最近一次被请求的帧
+    std::unordered_map<GLuint, GLuint> resident; // 瓦片 -> 槽位
+    std::vector<GLuint> missing;    // 本次反馈中缺少的瓦片
+
+    GLuint feedbackWidth, feedbackHeight;
+    GLuint feedbackFBO, feedbackColor, feedbackDepth;
+    GLuint pbo[PBO_COUNT];
+    bool pboPending[PBO_COUNT];
+    GLint savedViewport[4];
+
+    GLuint64 frame;
+    GLuint readIndex;
+    GLuint64 uploads, evictions;
+    bool pageTableDirty;
+    std::vector<GLuint> requests;
+    std::vector<unsigned char> tilePixels;
+
+    GLuint pendingCount() const
+    {
+        GLuint count = 0;
+        for(GLuint i = 0; i < PBO_COUNT; i++)
+            count += this->pboPending[i] ? 1 : 0;
+        return count;
+    }
+
+    // 反馈像素 -> 去重的瓦片列表；已驻留的刷新使用时间，缺少的连同祖先一起排队
+    void collectRequests(const unsigned char* pixels, GLuint count)
+    {
+        this->requests.clear();
+        for(GLuint i = 0; i < count; i++)
+        {
+            const unsigned char* p = pixels + i * 4;
+            if(p[3] == 0 || p[2] >= this->levels)
+                continue;
+            GLuint x = p[0], y = p[1], level = p[2];
+            if(x >= this->file.TilesX(level) || y >= this->file.TilesY(level))
+                continue;
+            this->requests.push_back(vt_detail::TileKey(level, x, y));
+        }
+        std::sort(this->requests.begin(), this->requests.end());
+        this->requests.erase(std::unique(this->requests.begin(), this->requests.end()), this->requests.end());
+
+        this->missing.clear();
+        for(GLuint key : this->requests)
+        {
+            // 沿祖先向上，直到已经处理过的驻留瓦片
+            GLuint level = vt_detail::KeyLevel(key), x = vt_detail::KeyX(key), y = vt_detail::KeyY(key);
+            for(; level < this->levels; level++, x >>= 1, y >>= 1)
+            {
+                GLuint tile = vt_detail::TileKey(level, x, y);
+                std::unordered_map<GLuint, GLuint>::iterator found = this->resident.find(tile);
+                if(found == this->resident.end())
+                {
+                    this->missing.push_back(tile);
+                    continue;
+                }
+                if(this->slotUsed[found->second] == this->frame)
+                    break;
+                this->slotUsed[found->second] = this->frame;
+            }
+        }
+        // 粗的级别优先：先让大片区域有比较清晰的内容
+        std::sort(this->missing.begin(), this->missing.end(), std::greater<GLuint>());
+        this->missing.erase(std::unique(this->missing.begin(), this->missing.end()), this->missing.end());
+    }
+
+    void streamRequests()
+    {
+        GLuint uploaded = 0;
+        for(GLuint key : this->missing)
+        {
+            if(uploaded >= this->MaxUploadsPerFrame)
+                break;
+            if(!this->load(key))
+                break; // 没有可替换的槽位（本帧请求的瓦片比物理缓存还多）
+            uploaded++;
+        }
+    }
+
+    // 选槽位（空的或最久没用的，本帧用到的和常驻的不替换），取像素并上传
+    bool load(GLuint key)
+    {
+        GLuint topKey = vt_detail::TileKey(this->levels - 1, 0, 0);
+        GLint best = -1;
+        for(GLuint slot = 0; slot < this->slotKeys.size(); slot++)
+        {
+            if(this->slotKeys[slot] == topKey || (this->slotKeys[slot] != VIRTUAL_TILE_NONE && this->slotUsed[slot] == this->frame))
+                continue;
+            if(best < 0 || this->slotKeys[slot] == VIRTUAL_TILE_NONE || this->slotUsed[slot] < this->slotUsed[best])
+            {
+                best = GLint(slot);
+                if(this->slotKeys[slot] == VIRTUAL_TILE_NONE)
+                    break;
+            }
+        }
+        if(best < 0)
+            return false;
+
+        const std::vector<unsigned char>* pixels = this->cpuCache.Find(key);
+        if(!pixels)
+        {
+            if(!this->file.ReadTile(vt_detail::KeyLevel(key), vt_detail::KeyX(key), vt_detail::KeyY(key), this->tilePixels))
+            {
+                std::cout << "ERROR::VIRTUAL_TEXTURE:: cannot read tile " << vt_detail::KeyLevel(key) << " "
+                          << vt_detail::KeyX(key) << " " << vt_detail::KeyY(key) << std::endl;
+                return false;
+            }
+            pixels = &this->cpuCache.Insert(key, this->tilePixels);
+        }
+
+        if(this->slotKeys[best] != VIRTUAL_TILE_NONE)
+        {
+            this->resident.erase(this->slotKeys[best]);
+            this->evictions++;
+        }
+        this->slotKeys[best] = key;
+        this->slotUsed[best] = this->frame;
+        this->resident[key] = GLuint(best);
+
+        GLuint slotSize = this->file.SlotSize();
+        glBindTexture(GL_TEXTURE_2D, this->physicalTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (best % this->slotsPerSide) * slotSize, (best / this->slotsPerSide) * slotSize,
+                        slotSize, slotSize, GL_RGB, GL_UNSIGNED_BYTE, pixels->data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        this->uploads++;
+        this->pageTableDirty = true;
+        return true;
+    }
+
+    // 从最粗的级别向下重建：驻留的瓦片指向自己的槽位，否则继承父瓦片的条目
+    void updatePageTable()
+    {
+        glBindTexture(GL_TEXTURE_2D, this->pageTable);
+        for(GLint level = GLint(this->levels) - 1; level >= 0; level--)
+        {
+            std::vector<GLuint>& entries = this->table[level];
+            GLint width = this->tableSize[level].x;
+            GLuint tilesX = this->file.TilesX(level), tilesY = this->file.TilesY(level);
+            for(GLuint y = 0; y < tilesY; y++)
+                for(GLuint x = 0; x < tilesX; x++)
+                {
+                    GLuint entry = 0;
+                    std::unordered_map<GLuint, GLuint>::iterator found = this->resident.find(vt_detail::TileKey(level, x, y));
+                    if(found != this->resident.end())
+                        entry = (found->second % this->slotsPerSide) | ((found->second / this->slotsPerSide) << 8) | (GLuint(level) << 16) | 0xFF000000u;
+                    else if(level + 1 < GLint(this->levels))
+                        entry = this->table[level + 1][(y >> 1) * this->tableSize[level + 1].x + (x >> 1)];
+                    entries[y * width + x] = entry;
+                }
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, this->tableSize[level].x, this->tableSize[level].y, GL_RGBA, GL_UNSIGNED_BYTE, entries.data());
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        this->pageTableDirty = false;
+    }
+};
+
+#endif
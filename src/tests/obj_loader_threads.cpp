@@ -0,0 +1,98 @@
+// OBJ 载入的线程数无关性检查：同一个文件用 1 个线程和多个线程载入，三角形必须相同。
+// 文件中的相对下标（f -3 -2 -1）跨越块的边界，正是多线程切块时容易出错的地方。
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include <learnopengl/obj_loader.h>
+
+// 写一个约 800KB 的 OBJ：顶点在 390KB 处，引用它们的面在 410KB 处，
+// 用 2 个线程载入时块的边界（约 400KB）正好落在两者之间
+bool WriteRelativeIndexObj(const std::string& path)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if(!file)
+        return false;
+    std::string padding(99, '#');
+    padding += '\n';
+    for(int i = 0; i < 3900; i++)
+        std::fputs(padding.c_str(), file);
+    std::fputs("v 1 0 0\nv 2 1 0\nv 3 0 1\nvt 0 0\nvt 1 0\nvt 0 1\nvn 0 0 1\n", file);
+    for(int i = 0; i < 200; i++)
+        std::fputs(padding.c_str(), file);
+    std::fputs("f -3/-3/-1 -2/-2/-1 -1/-1/-1\n", file);
+    std::fputs("f 1/1/1 -1/-1/-1 -2/-2/-1\n", file); // 绝对下标与相对下标混用
+    for(int i = 0; i < 3900; i++)
+        std::fputs(padding.c_str(), file);
+    std::fclose(file);
+    return true;
+}
+
+// 按索引展开成三角形的顶点序列（多线程去重时顶点顺序不固定，只比较展开后的结果）
+std::vector<Vertex> Triangles(const ModelData& model)
+{
+    std::vector<Vertex> result;
+    for(const MeshData& mesh : model.meshes)
+        for(GLuint index : mesh.indices)
+            result.push_back(mesh.vertices[index]);
+    return result;
+}
+
+bool SameVertex(const Vertex& a, const Vertex& b)
+{
+    return a.Position == b.Position && a.Normal == b.Normal && a.TexCoords == b.TexCoords;
+}
+
+int main()
+{
+    const std::string path = "relative_index_test.obj";
+    if(!WriteRelativeIndexObj(path))
+    {
+        std::printf("FAILED: cannot write %s\n", path.c_str());
+        return 1;
+    }
+
+    ModelData single;
+    if(!LoadObj(path, single, 1))
+    {
+        std::printf("FAILED: LoadObj\n");
+        return 1;
+    }
+    // 1 个线程时各下标的含义与文件一致：两个三角形为 (1, 2, 3) 和 (1, 3, 2)
+    std::vector<Vertex> expected = Triangles(single);
+    const GLfloat order[] = { 1.0f, 2.0f, 3.0f, 1.0f, 3.0f, 2.0f };
+    bool correct = expected.size() == 6;
+    for(size_t i = 0; correct && i < expected.size(); i++)
+        correct = expected[i].Position.x == order[i] && expected[i].Normal.z == 1.0f;
+    if(!correct)
+    {
+        std::printf("FAILED: wrong triangles with 1 thread\n");
+        return 1;
+    }
+
+    for(GLuint threads = 2; threads <= 4; threads++)
+    {
+        ModelData multi;
+        if(!LoadObj(path, multi, threads))
+        {
+            std::printf("FAILED: LoadObj with %u threads\n", threads);
+            return 1;
+        }
+        std::vector<Vertex> actual = Triangles(multi);
+        bool same = actual.size() == expected.size();
+        for(size_t i = 0; same && i < expected.size(); i++)
+            same = SameVertex(expected[i], actual[i]);
+        if(!same)
+        {
+            std::printf("FAILED: %u threads give different triangles than 1 thread\n", threads);
+            return 1;
+        }
+    }
+    std::remove(path.c_str());
+
+    std::printf("OK: same triangles with 1 to 4 threads\n");
+    return 0;
+}
@@ -0,0 +1,45 @@
+// 关闭的聚光灯检查：按 multiple_lights.frag 的 CalcSpotLight 在 CPU 上计算，
+// OffSpotLight() 的强度必须是有限值，贡献必须为 0（旧的全 0 参数会得到 NaN）。
+#include <cmath>
+#include <cstdio>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include <learnopengl/light_assignment.h>
+
+// 与 CalcSpotLight 相同的计算，返回 (ambient + diffuse + specular) 的最大分量
+GLfloat SpotContribution(const SpotLight& light, const glm::vec3& normal, const glm::vec3& fragPos, const glm::vec3& viewDir)
+{
+    glm::vec3 lightDir = glm::normalize(light.position - fragPos);
+    GLfloat diff = std::max(glm::dot(normal, lightDir), 0.0f);
+    glm::vec3 reflectDir = lightDir - normal * (2.0f * glm::dot(normal, lightDir)); // reflect(-lightDir, normal)
+    reflectDir = -reflectDir;
+    GLfloat spec = std::pow(std::max(glm::dot(viewDir, reflectDir), 0.0f), 32.0f);
+    GLfloat distance = glm::length(light.position - fragPos);
+    GLfloat attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    GLfloat theta = glm::dot(lightDir, glm::normalize(-light.direction));
+    GLfloat epsilon = light.cutOff - light.outerCutOff;
+    GLfloat intensity = std::min(std::max((theta - light.outerCutOff) / epsilon, 0.0f), 1.0f);
+    glm::vec3 color = light.ambient * attenuation + (light.diffuse * diff + light.specular * spec) * (attenuation * intensity);
+    return std::max(color.x, std::max(color.y, color.z));
+}
+
+int main()
+{
+    SpotLight light = OffSpotLight();
+    const glm::vec3 normals[] = { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f) };
+    const glm::vec3 positions[] = { glm::vec3(0.0f, -2.0f, 0.0f), glm::vec3(3.0f, 1.0f, -4.0f), glm::vec3(0.5f, 0.0f, 0.0f) };
+    for(const glm::vec3& normal : normals)
+        for(const glm::vec3& fragPos : positions)
+        {
+            GLfloat value = SpotContribution(light, normal, fragPos, glm::normalize(glm::vec3(0.3f, 0.5f, 1.0f)));
+            if(!std::isfinite(value) || value != 0.0f)
+            {
+                std::printf("FAILED: off spot light gives %f\n", value);
+                return 1;
+            }
+        }
+    std::printf("OK: off spot light is finite and black\n");
+    return 0;
+}
@@ -0,0 +1,99 @@
+// 资源打包工具：把根目录下的文件/目录写成一个资源包（格式见 asset_pack.h）
+// 用法：asset_packer [--store] <输出.pak> <根目录> <相对路径>...
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// GLEW
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// Other includes
+#include <learnopengl/asset_pack.h>
+
+// 收集 relative（文件或目录）下的所有文件，路径相对于 root
+void CollectFiles(const std::string& root, const std::string& relative, std::vector<std::string>& files)
+{
+	std::string path = root + "/" + relative;
+#ifdef _WIN32
+	DWORD attributes = GetFileAttributesA(path.c_str());
+	if (attributes == INVALID_FILE_ATTRIBUTES)
+		return;
+	if (!(attributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		files.push_back(relative);
+		return;
+	}
+	WIN32_FIND_DATAA data;
+	HANDLE find = FindFirstFileA((path + "/*").c_str(), &data);
+	if (find == INVALID_HANDLE_VALUE)
+		return;
+	do
+	{
+		std::string name = data.cFileName;
+		if (name != "." && name != "..")
+			CollectFiles(root, relative + "/" + name, files);
+	} while (FindNextFileA(find, &data));
+	FindClose(find);
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+		return;
+	if (!S_ISDIR(info.st_mode))
+	{
+		files.push_back(relative);
+		return;
+	}
+	DIR* dir = opendir(path.c_str());
+	if (!dir)
+		return;
+	while (dirent* entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if (name != "." && name != "..")
+			CollectFiles(root, relative + "/" + name, files);
+	}
+	closedir(dir);
+#endif
+}
+
+int main(int argc, char** argv)
+{
+	// 1.0命令行参数
+	std::vector<std::string> args(argv + 1, argv + argc);
+	bool compress = true;
+	if (!args.empty() && args[0] == "--store")
+	{
+		compress = false;
+		args.erase(args.begin());
+	}
+	if (args.size() < 3)
+	{
+		std::cout << "usage: asset_packer [--store] <output.pak> <root> <path>..." << std::endl;
+		return 1;
+	}
+
+	// 2.0收集文件
+	std::vector<std::string> files;
+	for (size_t i = 2; i < args.size(); i++)
+		CollectFiles(args[1], NormalizeAssetPath(args[i]), files);
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+
+	// 3.0写入资源包
+	if (!WriteAssetPack(args[0], args[1], files, compress))
+		return 1;
+	std::cout << "packed " << files.size() << " files into " << args[0] << std::endl;
+	return 0;
+}
@@ -0,0 +1,87 @@
+// GL 命令回放工具：反复提交录制的帧（格式见 gl_capture.h），测量驱动和 GPU 的开销
+// 用法：gl_replay [--no-swap] <录制文件> [轮数]
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+// GLEW
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+// Other includes
+#include <learnopengl/gl_capture.h>
+
+int main(int argc, char** argv)
+{
+	// 1.0命令行参数
+	std::vector<std::string> args(argv + 1, argv + argc);
+	bool swap = true;
+	if (!args.empty() && args[0] == "--no-swap")
+	{
+		swap = false;
+		args.erase(args.begin());
+	}
+	if (args.empty())
+	{
+		std::cout << "usage: gl_replay [--no-swap] <capture.glcap> [loops]" << std::endl;
+		return 1;
+	}
+	GLuint loops = (args.size() > 1) ? GLuint(std::atoi(args[1].c_str())) : 100u;
+
+	GLCaptureReplay replay;
+	if (!replay.Load(args[0]))
+		return 1;
+
+	// 2.0创建和录制时同样大小的窗口
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+	GLFWwindow* window = glfwCreateWindow(replay.Width(), replay.Height(), "gl_replay", nullptr, nullptr);
+	glfwMakeContextCurrent(window);
+	// 关闭垂直同步，否则帧率被显示器刷新率限制
+	glfwSwapInterval(0);
+	glewExperimental = GL_TRUE;
+	glewInit();
+
+	// 3.0重建资源
+	if (!replay.ReplaySetup())
+		return 1;
+	glFinish();
+
+	// 4.0紧凑循环：submit 为提交命令的 CPU 时间，total 包括等待 GPU 完成
+	GLuint frames = 0;
+	GLdouble submitTime = 0.0;
+	GLdouble frameStart = 0.0;
+	GLdouble startTime = glfwGetTime();
+	for (GLuint loop = 0; loop < loops && !glfwWindowShouldClose(window); loop++)
+	{
+		frameStart = glfwGetTime();
+		bool ok = replay.ReplayFrames([&]()
+		{
+			submitTime += glfwGetTime() - frameStart;
+			if (swap)
+				glfwSwapBuffers(window);
+			else
+				glFlush();
+			frames++;
+			frameStart = glfwGetTime();
+		});
+		if (!ok)
+			return 1;
+		glfwPollEvents();
+	}
+	glFinish();
+	GLdouble seconds = glfwGetTime() - startTime;
+
+	std::cout << frames << " frames, total " << seconds * 1000.0 / std::max(frames, 1u) << " ms/frame, submit "
+		<< submitTime * 1000.0 / std::max(frames, 1u) << " ms/frame" << std::endl;
+	glfwTerminate();
+	return 0;
+}
@@ -0,0 +1,49 @@
+// 场景烘焙工具：把 *.scene.json 烘焙成二进制场景（格式见 scene_file.h），可以和资源一起打包发布
+// 用法：scene_cooker <场景.json> [输出.scn]
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+// GLEW
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+// Other includes
+#include <learnopengl/scene_file.h>
+
+int main(int argc, char** argv)
+{
+	// 1.0命令行参数
+	if (argc < 2)
+	{
+		std::cout << "usage: scene_cooker <scene.json> [scene.scn]" << std::endl;
+		return 1;
+	}
+	std::string jsonPath = argv[1];
+	std::string cookedPath = (argc > 2) ? argv[2] : CookedScenePath(jsonPath);
+
+	// 2.0解析并烘焙
+	AssetFile source;
+	if (!source.Open(jsonPath))
+	{
+		std::cout << "ERROR::SCENE_COOKER:: cannot open " << jsonPath << std::endl;
+		return 1;
+	}
+	SceneDescription description;
+	std::vector<char> bytes;
+	if (!ParseSceneJson(source.Data(), source.Size(), description, jsonPath) ||
+		!CookScene(description, HashSceneSource(source.Data(), source.Size()), bytes))
+		return 1;
+
+	// 3.0写出
+	std::ofstream out(cookedPath.c_str(), std::ios::binary);
+	if (!out.write(bytes.data(), bytes.size()))
+	{
+		std::cout << "ERROR::SCENE_COOKER:: cannot write " << cookedPath << std::endl;
+		return 1;
+	}
+	std::cout << cookedPath << ": " << description.objects.size() << " objects, " << description.pointLights.size() << " point lights, "
+		<< description.spotLights.size() << " spot lights, " << bytes.size() << " bytes" << std::endl;
+	return 0;
+}